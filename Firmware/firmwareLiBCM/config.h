@@ -46,6 +46,8 @@
         #define LCD_4X20_CONNECTED  //display included with all LiBCM Kits
         //#define LIDISPLAY_CONNECTED //optional color touch screen display //JTS2doLater: mudder has not yet tested this code. Use at your own risk.
 
+    //#define LCD_4X20_I2C_FAST_MODE //uncomment to run 4x20 LCD I2C bus at 400 kHz (default: 100 kHz) //not all LCD I2C backpacks support 400 kHz
+
 
     //////////////////////////////////////////////////////////////////
 
@@ -58,6 +60,7 @@
     //'choose' exactly one option from each group below.
     //the default values below should work in all cars.
     //modify these parameters if you want more power during heavy assist and/or regen.
+    //these are defaults: the active values are stored in EEPROM and can be changed with '$SET' (see params.cpp)
 
     //48S ONLY: choose ONE of the following
     //60S MUST use 'VOLTAGE_SPOOFING_DISABLE':
@@ -87,6 +90,7 @@
 
     //the default values below will work in any car.
     //you only need to modify these parameters if you don't like the default behavior.
+    //most of these are defaults: the active values are stored in EEPROM and can be changed with '$SET' (see params.cpp)
 
     #define STACK_SoC_MAX 85 //maximum state of charge before regen  is disabled
     #define STACK_SoC_MIN 10 //minimum state of charge before assist is disabled
@@ -97,8 +101,8 @@
     #define CELL_VMIN_GRIDCHARGER               30000 //grid charger will not charge severely empty cells
     #define CELL_VMIN_KEYOFF                    CELL_VREST_10_PERCENT_SoC //when car is off, LiBCM turns off below this voltage
     #define CELL_BALANCE_MIN_SoC                65    //when car is off, cell balancing is disabled when battery is less than this percent charged
-    #define CELL_BALANCE_TO_WITHIN_COUNTS_LOOSE 32    //'32' = 3.2 mV //CANNOT exceed 255 counts (25.5 mV)
-    #define CELL_BALANCE_TO_WITHIN_COUNTS_TIGHT 22    //'22' = 2.2 mV //LTC6804 measurement uncertainty is 2.2 mV //MUST be less than CELL_BALANCE_TO_WITHIN_COUNTS_LOOSE
+    #define CELL_BALANCE_TO_WITHIN_PERMILLE_LOOSE 10  //'10' = 1.0% of pack capacity //balancing starts when any cell has this much more charge than the emptiest cell
+    #define CELL_BALANCE_TO_WITHIN_PERMILLE_TIGHT  5  //'5' = 0.5% //MUST be less than CELL_BALANCE_TO_WITHIN_PERMILLE_LOOSE
     #define CELL_BALANCE_MAX_TEMP_C             40
     //#define ONLY_BALANCE_CELLS_WHEN_GRID_CHARGER_PLUGGED_IN //uncomment to disable keyOFF cell balancing (unless the grid charger is plugged in)
 
@@ -116,6 +120,9 @@
     #define KEYOFF_DELAY_LIBCM_TURNOFF_MINUTES 10 //When SoC is between 0 & 10%, LiBCM will remain on for this many minutes after keyOFF.
         //to turn LiBCM back on: turn ignition 'ON', or turn IMA switch off and on, or plug in USB cable
 
+    //while keyON, LiBCM corrects coulomb counted SoC using the loaded cell voltage (see SoC_EKF.cpp)
+    //#define SoC_EKF_USE_AVERAGE_CELL_VOLTAGE //uncomment to compare the model against the average cell voltage (default: lowest cell voltage)
+
     //Choose which sign (±) the LCD displays when the battery is discharging
     #define DISPLAY_POSITIVE_SIGN_DURING_ASSIST //current is positive when battery is discharging
     //#define DISPLAY_NEGATIVE_SIGN_DURING_ASSIST //current is negative when battery is discharging
@@ -141,14 +148,17 @@
 
     //#define DISABLE_ASSIST //uncomment to (always) disable assist
     //#define DISABLE_REGEN  //uncomment to (always) disable regen
+    //#define DISABLE_SoC_EKF //uncomment to only use coulomb counting while keyON
     //#define REDUCE_BACKGROUND_REGEN_UNLESS_BRAKING //EXPERIMENTAL! //JTS2doLater: Make this work (for Balto)
 
     //choose which functions control the LEDs
         #define LED_NORMAL //enable "LED()" functions (see debug.c)
         //#define LED_DEBUG //enable "debugLED()" functions (FYI: blinkLED functions won't work)
 
+    #define FLIGHT_RECORDER_TRIGGERS 0x0F //bitmask: 0x01 cell voltage limit, 0x02 METSCI lost, 0x04 loop overrun burst, 0x08 watchdog near miss (see flightRecorder.h)
+
     //#define LIDISPLAY_DEBUG_ENABLED //uncomment to enable updates to text box ID # T12 on LiDisplay driving page -- this shows raw comm data from LiDisplay to LiBCM
-    #define LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS 64 //64 = 6.4mV window between cell colours on the grid charging page.  Don't go below CELL_BALANCE_TO_WITHIN_COUNTS_LOOSE
+    #define LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS 64 //64 = 6.4mV window between cell colours on the grid charging page.  Don't go below LTC6804 measurement uncertainty (2.2 mV)
 	#define LIDISPLAY_SPLASH_PAGE_MS 2000 //How long the splash page shows on LiDisplay.  Default 2000 (2 seconds)
 	#define LIDISPLAY_GRID_CHARGE_PAGE_COOLDOWN_MS 3000 // Keep displaying the grid charging page this long before showing splash page when GC unplugged
 
@@ -157,10 +167,9 @@
         #define SERIAL_H_LINE_CONNECTED NO //H-Line wire connected to OEM BCM connector pin B01
         #define KEYOFF_TURNOFF_LIBCM_AFTER_HOURS 48 //LiBCM turns off this many hours after keyOFF.
 
-        Change these #define statements so that all they do is reconfigure EEPROM values.
-        Also, change this file so that all #define statements are commented out by default.
-        With these two changes, a user only needs to edit config.h if they want to change a previously sent parameter.
+        Change this file so that all #define statements are commented out by default.
         If user doesn't uncomment anything, then the previously uploaded value remains in EEPROM
+        (tunable parameters are already stored in EEPROM, but uploading firmware with a different PARAMS_VERSION restores these defaults)
     */
 
     //JTS2doLater: Implement this feature
@@ -6,9 +6,12 @@
 
 void setup() //~t=2 milliseconds, BUT NOTE this doesn't include CPU_CLOCK warmup or bootloader delay
 {
+    resetLog_begin(); //MUST run first
     gpio_begin();
+    adc_begin(); //MUST run after gpio_begin()
     wdt_disable();
     Serial.begin(115200); //USB
+    busStats_begin(); //MUST run before any serial bus begins
     METSCI_begin();
     BATTSCI_begin();
     heater_begin();
@@ -16,6 +19,9 @@ void setup() //~t=2 milliseconds, BUT NOTE this doesn't include CPU_CLOCK warmup
     LiControl_begin();
     LTC68042configure_initialize();
     eeprom_begin();
+    params_begin(); //MUST run after eeprom_begin()
+    resetLog_save(); //MUST run after eeprom_begin()
+    SoC_begin();
 
     #ifdef RUN_BRINGUP_TESTER_GRIDCHARGER
         bringupTester_gridcharger(); 
@@ -26,42 +32,47 @@ void setup() //~t=2 milliseconds, BUT NOTE this doesn't include CPU_CLOCK warmup
     if (gpio_keyStateNow() == GPIO_KEY_ON){ LED(3,ON); } //turn LED3 on if LiBCM (re)boots while driving
 
     Serial.print(F("\n\nLiBCM v" FW_VERSION ", " BUILD_DATE "\n'$HELP' for info\n"));
+    resetLog_printLatest();
     debugUSB_printHardwareRevision();
+    gpio_verifyFastPins();
     debugUSB_printConfigParameters();
 
-    wdt_enable(WDTO_2S); //set watchdog reset vector to 2 seconds
+    resetLog_enableWatchdog(); //LiBCM resets if loop stalls for 2 seconds
 }
 
 void loop()
 {
-    key_stateChangeHandler();
-    time_handler();
-    temperature_handler();
-    SoC_handler();
-    fan_handler();
-    heater_handler();
-    gridCharger_handler();
-    buzzer_handler();
-    lcdState_handler();
-    LiDisplay_handler();
-    batteryHistory_handler();
-    cellBalance_handler();
+    resetLog_task(TASK_KEY_STATE);       key_stateChangeHandler();
+    resetLog_task(TASK_TIME);            time_handler();
+    resetLog_task(TASK_TEMPERATURE);     temperature_handler();
+    resetLog_task(TASK_SoC);             SoC_handler();
+    resetLog_task(TASK_FAN);             fan_handler();
+    resetLog_task(TASK_HEATER);          heater_handler();
+    resetLog_task(TASK_GRIDCHARGER);     gridCharger_handler();
+    resetLog_task(TASK_BUZZER);          buzzer_handler();
+    resetLog_task(TASK_LCD);             lcdState_handler();
+    resetLog_task(TASK_LIDISPLAY);       LiDisplay_handler();
+    resetLog_task(TASK_BATTERY_HISTORY); batteryHistory_handler();
+    resetLog_task(TASK_CELL_BALANCE);    cellBalance_handler();
 
     if (key_getSampledState() == KEYSTATE_ON)
     {
+        resetLog_task(TASK_BATTSCI);
         if (eeprom_expirationStatus_get() != FIRMWARE_EXPIRED) { BATTSCI_sendFrames(); } //P1648 when firmware expired
 
-        LTC68042cell_nextVoltages(); //round-robin handler measures QTY3 cell voltages per call
-        METSCI_processLatestFrame();
-        adc_updateBatteryCurrent();
-        vPackSpoof_setVoltage();
-        debugUSB_printLatestData();
-        LiControl_handler();
+        resetLog_task(TASK_LTC6804);
+        if (LTC68042cell_nextVoltages() == CELL_DATA_PROCESSED) { SoC_verifyUsingLoadedCellVoltage(); SoC_EKF_update(); } //round-robin handler measures QTY3 cell voltages per call
+        resetLog_task(TASK_METSCI);          METSCI_processLatestFrame();
+        resetLog_task(TASK_ADC);             adc_updateBatteryCurrent();
+        resetLog_task(TASK_VSPOOF);          vPackSpoof_setVoltage();
+        resetLog_task(TASK_DEBUG_USB);       debugUSB_printLatestData();
+        resetLog_task(TASK_LICONTROL);       LiControl_handler();
     }
     else if (key_getSampledState() == KEYSTATE_OFF)
     {
         if (time_isItTimeToPerformKeyOffTasks() == YES)
         {
+            resetLog_task(TASK_KEYOFF_TASKS);
             LTC68042cell_acquireAllCellVoltages();
             SoC_updateUsingLatestOpenCircuitVoltage();
             SoC_turnOffLiBCM_ifPackEmpty();
@@ -69,8 +80,11 @@ void loop()
         }
     }
 
-    USB_userInterface_handler();
-    wdt_reset(); //Feed watchdog
+    resetLog_task(TASK_FLIGHT_RECORDER); flightRecorder_handler(); //MUST run after keyON tasks (samples latest values)
+    resetLog_task(TASK_USB_INPUT);       USB_userInterface_handler();
+    resetLog_task(TASK_EVENT_LOG);       eventLog_handler(); //low priority
+    resetLog_task(TASK_RAM_MONITOR);     ramMonitor_handler();
+    resetLog_feedWatchdog();
     blinkLED2(); //Heartbeat
-    time_waitForLoopPeriod(); //wait here until next iteration
+    resetLog_task(TASK_LOOP_WAIT);       time_waitForLoopPeriod(); //wait here until next iteration
 }
@@ -189,7 +189,7 @@ void testDischargeFETs(void)
     {
 
         Serial.print(F("\n\nbitmapPattern: "));
-        Serial.print(String(cellDischargeBitmaps[bitmapPattern],BIN));
+        Serial.print(cellDischargeBitmaps[bitmapPattern],BIN);
         //Test each LTC6804 IC separately
         for (uint8_t ii=0; ii<TOTAL_IC; ii++)
         {
@@ -249,7 +249,7 @@ void bringupTester_motherboard(void)
                 for (int ii=0; ii<100; ii++) { LTC68042cell_nextVoltages(); delay(5); } //generate a bunch of isoSPI traffic to check for errors
 
                 Serial.print(F("\nLTC6804 - isoSPI error count is "));
-                Serial.print(String(LTC68042result_errorCount_get()));
+                Serial.print(LTC68042result_errorCount_get());
                 Serial.print(F(": "));
 
                 if ( LTC68042result_errorCount_get() == 0 ) { Serial.print(F("pass")); }
@@ -259,9 +259,9 @@ void bringupTester_motherboard(void)
                 for (uint8_t ii=0; ii<TOTAL_IC; ii++) { debugUSB_printOneICsCellVoltages( ii, 3); }
 
                 Serial.print(F("\nmax cell: "));
-                Serial.print(String(LTC68042result_hiCellVoltage_get()));
+                Serial.print(LTC68042result_hiCellVoltage_get());
                 Serial.print(F("\nmin cell: "));
-                Serial.print(String(LTC68042result_loCellVoltage_get()));
+                Serial.print(LTC68042result_loCellVoltage_get());
 
                 Serial.print(F("\n\nLTC6804 - verify no shorts: "));
                 serialUSB_waitForEmptyBuffer();
@@ -341,7 +341,7 @@ void bringupTester_motherboard(void)
                 {
                     uint8_t numberToLoopback = 0b10101110;
                     
-                    Serial1.begin(38400,SERIAL_8E1);
+                    LiDisplay_beginLoopbackTest();
 
                     LiDisplay_writeByte(numberToLoopback);
                     delay(10);
@@ -401,7 +401,7 @@ void bringupTester_motherboard(void)
                             Serial.print(loopedBack);
                             didLoopbackPass = false;
                         }
-                        else {Serial.print(String(charToLoopback)); }
+                        else {Serial.print(charToLoopback); }
                     }
 
                     if (didLoopbackPass == true) { Serial.print(F(": pass")); }
@@ -424,10 +424,10 @@ void bringupTester_motherboard(void)
                     uint16_t tempWHT = adc_getTemperature(PIN_TEMP_WHT);
                     uint16_t tempBLU = adc_getTemperature(PIN_TEMP_BLU);
                     Serial.print(F("\nUnpowered YEL/GRN/WHT/BLU temp sensors are "));
-                    Serial.print( String(tempYEL) + '/');
-                    Serial.print( String(tempGRN) + '/');
-                    Serial.print( String(tempWHT) + '/');
-                    Serial.print( String(tempBLU) + ": ");
+                    Serial.print(tempYEL); Serial.print('/');
+                    Serial.print(tempGRN); Serial.print('/');
+                    Serial.print(tempWHT); Serial.print('/');
+                    Serial.print(tempBLU); Serial.print(F(": "));
 
                     if ((tempYEL > 950) && (tempGRN > 950) && (tempWHT > 950) && (tempBLU > 950)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -439,9 +439,9 @@ void bringupTester_motherboard(void)
                     uint16_t tempBAY2 = adc_getTemperature(PIN_TEMP_BAY2);
                     uint16_t tempBAY3 = adc_getTemperature(PIN_TEMP_BAY3);
                     Serial.print(F("\nUnpowered BAY1/BAY2/BAY3 temp sensors are "));
-                    Serial.print( String(tempBAY1) + '/');
-                    Serial.print( String(tempBAY2) + '/');
-                    Serial.print( String(tempBAY3) + ": ");
+                    Serial.print(tempBAY1); Serial.print('/');
+                    Serial.print(tempBAY2); Serial.print('/');
+                    Serial.print(tempBAY3); Serial.print(F(": "));
 
                     if ((tempBAY1 > 950) && (tempBAY2 > 950) && (tempBAY3 > 950)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -463,10 +463,10 @@ void bringupTester_motherboard(void)
                     uint16_t tempWHT = adc_getTemperature(PIN_TEMP_WHT);
                     uint16_t tempBLU = adc_getTemperature(PIN_TEMP_BLU);
                     Serial.print(F("\n  Powered YEL/GRN/WHT/BLU temp sensors are "));
-                    Serial.print( String(tempYEL) + '/');
-                    Serial.print( String(tempGRN) + '/');
-                    Serial.print( String(tempWHT) + '/');
-                    Serial.print( String(tempBLU) + ": ");
+                    Serial.print(tempYEL); Serial.print('/');
+                    Serial.print(tempGRN); Serial.print('/');
+                    Serial.print(tempWHT); Serial.print('/');
+                    Serial.print(tempBLU); Serial.print(F(": "));
 
                     if ((tempYEL > 462) && (tempYEL < 562) &&
                         (tempGRN > 462) && (tempGRN < 562) &&
@@ -481,9 +481,9 @@ void bringupTester_motherboard(void)
                     uint16_t tempBAY2 = adc_getTemperature(PIN_TEMP_BAY2);
                     uint16_t tempBAY3 = adc_getTemperature(PIN_TEMP_BAY3);
                     Serial.print(F("\n  Powered BAY1/BAY2/BAY3 temp sensors are "));
-                    Serial.print( String(tempBAY1) + '/');
-                    Serial.print( String(tempBAY2) + '/');
-                    Serial.print( String(tempBAY3) + ": ");
+                    Serial.print(tempBAY1); Serial.print('/');
+                    Serial.print(tempBAY2); Serial.print('/');
+                    Serial.print(tempBAY3); Serial.print(F(": "));
 
                     if ((tempBAY1 > 459) && (tempBAY1 < 565) &&
                         (tempBAY2 > 459) && (tempBAY2 < 565) &&
@@ -506,8 +506,8 @@ void bringupTester_motherboard(void)
                     gpio_setFanSpeed_PCB(FAN_OFF);     //turn all FETs off (0A thru sensor)
                     delay(10);
 
-                    uint16_t resultADC = analogRead(PIN_BATTCURRENT); // 0A is 330 counts
-                    Serial.print(String(resultADC));
+                    uint16_t resultADC = adc_getLatest_counts(PIN_BATTCURRENT); // 0A is 330 counts
+                    Serial.print(resultADC);
                     Serial.print(F(" counts: "));
                     if ((resultADC > 322) && (resultADC < 338)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -520,8 +520,8 @@ void bringupTester_motherboard(void)
                     gpio_setFanSpeed_PCB(FAN_OFF);
                     delay(500);
 
-                    uint16_t resultADC = analogRead(PIN_BATTCURRENT); // 3A * 19 turns = '57 A' = 595 counts
-                    Serial.print(String(resultADC));
+                    uint16_t resultADC = adc_getLatest_counts(PIN_BATTCURRENT); // 3A * 19 turns = '57 A' = 595 counts
+                    Serial.print(resultADC);
                     Serial.print(F(" counts: "));
                     if ((resultADC > 585) && (resultADC < 605)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -534,8 +534,8 @@ void bringupTester_motherboard(void)
                     gpio_setFanSpeed_PCB(FAN_OFF);
                     delay(500);
 
-                    uint16_t resultADC = analogRead(PIN_BATTCURRENT); // 3A * 19 turns = '57 A' = 595 counts
-                    Serial.print(String(resultADC));
+                    uint16_t resultADC = adc_getLatest_counts(PIN_BATTCURRENT); // 3A * 19 turns = '57 A' = 595 counts
+                    Serial.print(resultADC);
                     Serial.print(F(" counts: "));
                     if ((resultADC > 585) && (resultADC < 605)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -548,8 +548,8 @@ void bringupTester_motherboard(void)
                     gpio_setFanSpeed_PCB(FAN_HIGH);
                     delay(500);
 
-                    uint16_t resultADC = analogRead(PIN_BATTCURRENT); // 3A * 19 turns = '57 A' = 595 counts
-                    Serial.print(String(resultADC));
+                    uint16_t resultADC = adc_getLatest_counts(PIN_BATTCURRENT); // 3A * 19 turns = '57 A' = 595 counts
+                    Serial.print(resultADC);
                     Serial.print(F(" counts: "));
                     if ((resultADC > 585) && (resultADC < 605)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -565,8 +565,8 @@ void bringupTester_motherboard(void)
                     gpio_setFanSpeed_PCB(FAN_HIGH); //should already be here
                     delay(250);
 
-                    uint16_t resultADC = analogRead(PIN_BATTCURRENT); // 0A is 330 counts
-                    Serial.print(String(resultADC));
+                    uint16_t resultADC = adc_getLatest_counts(PIN_BATTCURRENT); // 0A is 330 counts
+                    Serial.print(resultADC);
                     Serial.print(F(" counts: "));
                     if ((resultADC > 322) && (resultADC < 338)) { Serial.print(F("pass")); }
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !! !! !!")); didTestFail=true; }
@@ -584,24 +584,24 @@ void bringupTester_motherboard(void)
                 {
                     analogWrite(PIN_VPIN_OUT_PWM,0); // 0 counts = 0.0 volts
                     delay(200); //LPF
-                    uint16_t result = analogRead(PIN_VPIN_IN);
-                    Serial.print(String(result));
+                    uint16_t result = adc_getLatest_counts(PIN_VPIN_IN);
+                    Serial.print(result);
                     if (result < 40) { Serial.print(F(" pass")); } //40 counts is 0.2 volts
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !")); didTestFail = true; }
 
                     analogWrite(PIN_VPIN_OUT_PWM,127); // 127 counts = 2.5 volts
                     delay(200); //LPF
-                    result = analogRead(PIN_VPIN_IN);
+                    result = adc_getLatest_counts(PIN_VPIN_IN);
                     Serial.print(F("\nVPIN Loopback @ 2.5V: "));
-                    Serial.print(String(result));
+                    Serial.print(result);
                     if ((result < 532) && (result > 492)) { Serial.print(F(" pass")); } //492 counts is 2.4 volts //532 counts is 2.6 volts
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !")); didTestFail = true; }
 
                     analogWrite(PIN_VPIN_OUT_PWM,255); // 255 counts = 5.0 volts
                     delay(200); //LPF
-                    result = analogRead(PIN_VPIN_IN);
+                    result = adc_getLatest_counts(PIN_VPIN_IN);
                     Serial.print(F("\nVPIN Loopback @ 5.0V: "));
-                    Serial.print(String(result));
+                    Serial.print(result);
                     if (result > 984) { Serial.print(F(" pass")); } //984 counts is 4.8 volts
                     else { Serial.print(F("FAIL!! !! !! !! !! !! !! !")); didTestFail = true; }
 
@@ -99,11 +99,14 @@ void validateAndStoreNextCVR(uint8_t chipAddress, char cellVoltageRegister)
 
         if (attemptCounter > 1) { LTC68042result_errorCount_increment(); } //log each PEC error
 
+        if (received_pec != calculated_pec) { eventLog_log(EVENT_LTC6804_PEC_ERROR, ((uint16_t)chipAddress << 8) | (uint8_t)cellVoltageRegister); }
+
     } while ((received_pec != calculated_pec) && (attemptCounter < MAX_READ_ATTEMPTS)); //retry if isoSPI error
 
     if (attemptCounter >= MAX_READ_ATTEMPTS)
     {
         //too many errors occurred
+        eventLog_log(EVENT_LTC6804_READ_FAILED, ((uint16_t)chipAddress << 8) | (uint8_t)cellVoltageRegister);
         cellX_Voltage_counts = 0;
         cellY_Voltage_counts = 0;
         cellZ_Voltage_counts = 0;
@@ -198,6 +201,7 @@ void processAllCellVoltages(void)
     }
 
     LTC68042result_packVoltage_set( (uint8_t)(packVoltage_RAW * 0.0001) );
+    LTC68042result_avgCellVoltage_set( (uint16_t)(packVoltage_RAW / (TOTAL_IC * CELLS_PER_IC)) );
     
     LTC68042result_loCellVoltage_set(loCellVoltage);
     LTC68042result_hiCellVoltage_set(hiCellVoltage);
@@ -168,9 +168,9 @@ bool LTC68042configure_wakeupCore(void)
     if ((uint32_t)(millis() - lastTimeDataSent_millis) > T_SLEEP_WATCHDOG_MILLIS)
     { 
         //LTC6804 core (probably) asleep
-        digitalWrite(PIN_SPI_CS,LOW); //wake up core
+        gpio_fastWrite(PIN_SPI_CS, LOW); //wake up core
         delayMicroseconds(300); // Guarantees the LTC6804 is in standby (tWake = 300 us max)  
-        digitalWrite(PIN_SPI_CS,HIGH);
+        gpio_fastWrite(PIN_SPI_CS, HIGH);
         lastTimeDataSent_millis = millis();
         wasCoreAlreadyAwake = LTC6804_CORE_JUST_WOKE_UP;
     }
@@ -188,9 +188,9 @@ void LTC68042configure_wakeupIsoSPI(void)
     if ((uint32_t)(millis() - lastTimeDataSent_millis) > T_IDLE_isoSPI_MILLIS)
     { 
         //LTC6804 isoSPI might be asleep (tIDLE elapsed)
-        digitalWrite(PIN_SPI_CS,LOW);
+        gpio_fastWrite(PIN_SPI_CS, LOW);
         delayMicroseconds(10); //Guarantees isoSPI is in ready mode (tWAKE = 10 us max)
-        digitalWrite(PIN_SPI_CS,HIGH);
+        gpio_fastWrite(PIN_SPI_CS, HIGH);
         lastTimeDataSent_millis = millis();
     }
 }
@@ -217,7 +217,7 @@ uint16_t LTC68042configure_calcPEC15(uint8_t len, //data array length
     for (uint8_t i = 0; i<len; i++) // loops for each byte in data array
     {
         addr = ( (remainder>>7)^data[i] ) & 0xff;//calculate PEC table address
-        remainder = (remainder<<8) ^ crc15Table[addr];
+        remainder = (remainder<<8) ^ pgm_read_word(&crc15Table[addr]);
     }
   
     return(remainder<<1);//The CRC15 LSB is 0, so multiply by 2
@@ -230,9 +230,9 @@ void LTC68042configure_spiWrite(uint8_t len, // bytes to be written on the SPI p
 {
     LTC68042configure_wakeup();
 
-    digitalWrite(PIN_SPI_CS,LOW);
+    gpio_fastWrite(PIN_SPI_CS, LOW);
     for (uint8_t i = 0; i < len; i++) { spi_write((char)data[i]); } //all SPI writes occur here
-    digitalWrite(PIN_SPI_CS,HIGH);
+    gpio_fastWrite(PIN_SPI_CS, HIGH);
 
     lastTimeDataSent_millis = millis();
 }
@@ -246,10 +246,10 @@ void LTC68042configure_spiWriteRead(uint8_t tx_Data[],//array of data to be writ
 {
     LTC68042configure_wakeup();
 
-    digitalWrite(PIN_SPI_CS,LOW);
+    gpio_fastWrite(PIN_SPI_CS, LOW);
     for (uint8_t i = 0; i < tx_len; i++) { spi_write(tx_Data[i]); }
     for (uint8_t i = 0; i < rx_len; i++) { rx_data[i] = (uint8_t)spi_read(0xFF); }
-    digitalWrite(PIN_SPI_CS,HIGH);
+    gpio_fastWrite(PIN_SPI_CS, HIGH);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -94,7 +94,7 @@
         #define IS_DISCHARGE_ALLOWED_DURING_CONVERSION DCP_DISABLED
     #endif
 
-    static const unsigned int crc15Table[256] = {
+    static const uint16_t crc15Table[256] PROGMEM = { //stored in flash //MUST read with pgm_read_word()
         0x0,    0xc599, 0xceab, 0xb32,  0xd8cf, 0x1d56, 0x1664, 0xd3fd,
         0xf407, 0x319e, 0x3aac, 0xff35, 0x2cc8, 0xe951, 0xe263, 0x27fa,
         0xad97, 0x680e, 0x633c, 0xa6a5, 0x7558, 0xb0c1, 0xbbf3, 0x7e6a,
@@ -143,9 +143,9 @@ bool LTC6804gpio_areAllVoltageReferencesPassing(void)
       uint16_t countsVREF = aux_codes[ii][5];
 
       Serial.print(F("\nIC"));
-      Serial.print(String(ii));
+      Serial.print(ii);
       Serial.print(F(" VREF2 is "));
-      Serial.print(String(countsVREF));
+      Serial.print(countsVREF);
       Serial.print(F(", "));
 
       if ((countsVREF < 30150) && (countsVREF > 29850)) { Serial.print(F("ok"));                        }
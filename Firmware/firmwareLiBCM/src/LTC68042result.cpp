@@ -30,6 +30,10 @@ uint16_t hiCellVoltage_counts = 34567;
 void     LTC68042result_hiCellVoltage_set(uint16_t newHi_counts) { hiCellVoltage_counts = newHi_counts; }
 uint16_t LTC68042result_hiCellVoltage_get(void                 ) { return hiCellVoltage_counts;         }
 
+uint16_t avgCellVoltage_counts = 34567;
+void     LTC68042result_avgCellVoltage_set(uint16_t newAvg_counts) { avgCellVoltage_counts = newAvg_counts; }
+uint16_t LTC68042result_avgCellVoltage_get(void                  ) { return avgCellVoltage_counts;          }
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //All cell voltages in this array are guaranteed to be acquired at the same time
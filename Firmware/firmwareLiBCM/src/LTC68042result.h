@@ -23,6 +23,9 @@
     void     LTC68042result_hiCellVoltage_set(uint16_t newHi_counts);
     uint16_t LTC68042result_hiCellVoltage_get(void                 );
 
+    void     LTC68042result_avgCellVoltage_set(uint16_t newAvg_counts);
+    uint16_t LTC68042result_avgCellVoltage_get(void                  );
+
     void     LTC68042result_specificCellVoltage_set(uint8_t icNumber, uint8_t cellNumber, uint16_t cellVoltage);
     uint16_t LTC68042result_specificCellVoltage_get (uint8_t icNumber, uint8_t cellNumber);
 
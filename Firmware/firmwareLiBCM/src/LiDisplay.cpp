@@ -16,6 +16,39 @@
 
 #define LIDISPLAY_UPDATE_RATE_MILLIS 40     // One element is updated each time
 
+#define LIDISPLAY_ATTR_TXT 0    // text value
+#define LIDISPLAY_ATTR_VAL 1    // numerical value
+#define LIDISPLAY_ATTR_PIC 2    // picture id
+#define LIDISPLAY_ATTR_BCO 3    // background colour
+#define LIDISPLAY_ATTR_PCO 4    // primary colour
+
+// Each cached element remembers a CRC of the last command sent to it, so an unchanged value isn't retransmitted.
+// Elements on different pages can share a slot, because the page number is part of the command.
+#define LIDISPLAY_CACHE_NONE         0xFF   // always sent
+#define LIDISPLAY_CACHE_POWER           0
+#define LIDISPLAY_CACHE_CHRGASST_PIC    1
+#define LIDISPLAY_CACHE_HI_CELL         2
+#define LIDISPLAY_CACHE_LO_CELL         3
+#define LIDISPLAY_CACHE_KEY_TIME        4
+#define LIDISPLAY_CACHE_CELL_DELTA      5
+#define LIDISPLAY_CACHE_FAN_SPEED       6
+#define LIDISPLAY_CACHE_SOC_BARS        7
+#define LIDISPLAY_CACHE_SOC             8
+#define LIDISPLAY_CACHE_PACK_VOLTAGE    9
+#define LIDISPLAY_CACHE_TEMPERATURE    10
+#define LIDISPLAY_CACHE_FW_VERSION     11
+#define LIDISPLAY_CACHE_FW_HOURS_LEFT  12
+#define LIDISPLAY_CACHE_GC_STATE       13
+#define LIDISPLAY_CACHE_AVG_CELL       14
+#define LIDISPLAY_CACHE_GC_TIME        15
+#define LIDISPLAY_CACHE_GC_BEGIN_SOC   16
+#define LIDISPLAY_CACHE_FW_EXPIRED     17
+#define LIDISPLAY_NUM_CACHE_SLOTS      18   // 32 max (LiDisplay_isCacheSlotValid is a bitmask)
+
+#define LIDISPLAY_COMMAND_MAX_BYTES 112 // longest command is the settings page description text (~104 bytes)
+
+#define LIDISPLAY_CELL_COLOUR_UNKNOWN 0xFF
+
 #ifdef STACK_IS_48S
     #define MAX_CELL_INDEX 47
 #elif defined STACK_IS_60S
@@ -27,7 +60,6 @@ uint8_t LiDisplayCurrentPageNum = 0;
 uint8_t LiDisplaySetPageNum = LIDISPLAY_DRIVING_PAGE_ID;
 uint8_t LiDisplaySoCBarCount = 0;
 uint8_t LiDisplayChrgAsstPicId = 22;
-uint8_t LiDisplayWaitingForCommand = 0;
 
 // Initializing to 100 (absurd number for all 4 variables) so that on first run they will be updated on screen
 static uint8_t  LiDisplayPackVoltageActual_onScreen = 100;
@@ -55,35 +87,232 @@ static uint16_t gc_connected_seconds = 0;
 static uint8_t gc_connected_minutes = 0;
 static uint8_t gc_connected_hours = 0;
 
-static String gc_begin_soc_str = "0%";
-static String gc_time = "00:00:00";
-static String key_time = "00:00:00";
-String gc_currently_selected_cell_id_str = "99";    // An absurd initialization value.
+static uint8_t gc_begin_soc_percent = 0;
+uint8_t gc_currently_selected_cell_id = 99;    // An absurd initialization value.
 
 static uint32_t key_time_begin_ms = 0;
+static uint8_t key_time_seconds = 0;
+static uint8_t key_time_minutes = 0;
+static uint8_t key_time_hours = 0;
 
 static uint8_t currentFanSpeed = 0;
 
 bool gc_sixty_s_fomoco_e_block_enabled = false;
 
-const String attrMap[5] = {
-    "txt",  // text value
-    "val",  // numerical value
-    "pic",  // picture id
-    "bco",  // background colour
-    "pco"   // primary colour
+static char LiDisplay_command[LIDISPLAY_COMMAND_MAX_BYTES];
+static uint8_t LiDisplay_commandLength = 0;
+static bool LiDisplay_isCommandTooLong = false;
+
+static uint16_t LiDisplay_lastSentCRC[LIDISPLAY_NUM_CACHE_SLOTS];
+static uint32_t LiDisplay_isCacheSlotValid = 0;
+static uint8_t  LiDisplay_cellColour_onScreen[MAX_CELL_INDEX + 1];
+
+// All strings below are stored in flash (PROGMEM), so they don't use any RAM
+const char attrName_txt[] PROGMEM = "txt";
+const char attrName_val[] PROGMEM = "val";
+const char attrName_pic[] PROGMEM = "pic";
+const char attrName_bco[] PROGMEM = "bco";
+const char attrName_pco[] PROGMEM = "pco";
+const char * const attrMap[5] PROGMEM = { attrName_txt, attrName_val, attrName_pic, attrName_bco, attrName_pco };
+
+const char fanSpeedText_off[]  PROGMEM = "FAN OFF";
+const char fanSpeedText_low[]  PROGMEM = "FAN LOW";
+const char fanSpeedText_med[]  PROGMEM = "FAN MED";
+const char fanSpeedText_high[] PROGMEM = "FAN HIGH";
+const char * const fanSpeedDisplay[4] PROGMEM = { fanSpeedText_off, fanSpeedText_low, fanSpeedText_med, fanSpeedText_high };
+
+const char editableParamName_0[] PROGMEM = "CELL_VMAX_GRIDCHARGER";
+const char editableParamName_1[] PROGMEM = "LiDisp Cell Bal Res Window";
+const char * const editableParamMap[2] PROGMEM = { editableParamName_0, editableParamName_1 };
+
+#if defined BATTERY_TYPE_5AhG3 //max is CELL_VREST_85_PERCENT_SoC - 1 (see params.cpp)
+    const char editableParamDescription_0[] PROGMEM = "Charge cells up to this voltage\r\nMin: 37000\r\nMax: 39999\r\nDefault: 39600";
+#elif defined BATTERY_TYPE_47AhFoMoCo
+    const char editableParamDescription_0[] PROGMEM = "Charge cells up to this voltage\r\nMin: 37000\r\nMax: 39699\r\nDefault: 39600";
+#endif
+const char editableParamDescription_1[] PROGMEM = "Higher numbers mean cell colours\r\nchange less frequently.\r\nMin: 32  Max: 255\r\nDefault: 64";
+const char * const editableParamDescriptions[2] PROGMEM = { editableParamDescription_0, editableParamDescription_1 };
+
+// Grid charging page cell colours (RGB565), from most above to most below the average cell voltage
+const uint16_t cellColourMap[7] PROGMEM = {
+    63488,  // Red
+    64480,  // Orange
+    65504,  // Yellow
+     2016,  // Green
+     2047,  // Cyan
+       31,  // Blue
+    22556   // Purple
 };
 
-const String fanSpeedDisplay[4] = { "FAN OFF", "FAN LOW", "FAN MED", "FAN HIGH" };
-const String editableParamMap[2] = { "CELL_VMAX_GRIDCHARGER", "LiDisp Cell Bal Res Window" };
-const String editableParamDescriptions[2] = {
-    "Charge cells up to this voltage\r\nMin: 37000\r\nMax: 41000\r\nDefault: 39600",
-    "Higher numbers mean cell colours\r\nchange less frequently.\r\nMin: 32  Max: 255\r\nDefault: 64"
-};
-const uint16_t editableParamMinMax[2][2] = {
-    {37000,41000},
-    {   32,  255}
-};
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Nextion commands are built in LiDisplay_command[], then copied to the USART1 transmit buffer.
+// Usage: LiDisplay_command_begin(), then append the command, then LiDisplay_command_send()
+
+void LiDisplay_command_begin(void)
+{
+    LiDisplay_commandLength = 0;
+    LiDisplay_isCommandTooLong = false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_command_appendChar(char character)
+{
+    if (LiDisplay_commandLength < (LIDISPLAY_COMMAND_MAX_BYTES - 3)) { LiDisplay_command[LiDisplay_commandLength++] = character; } // leave room for terminator
+    else                                                             { LiDisplay_isCommandTooLong = true;                         }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_command_appendText(const char * text)
+{
+    while (*text != 0) { LiDisplay_command_appendChar(*text++); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_command_appendText_P(PGM_P text)
+{
+    char character = pgm_read_byte(text++);
+
+    while (character != 0)
+    {
+        LiDisplay_command_appendChar(character);
+        character = pgm_read_byte(text++);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_command_appendFormatted(const char buffer[], uint8_t index)
+{
+    while (index < PRINTFORMAT_BUFFER_BYTES) { LiDisplay_command_appendChar(buffer[index++]); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// leading zeros are added until the number is minDigits long
+void LiDisplay_command_appendInt(int32_t value, uint8_t minDigits)
+{
+    char buffer[PRINTFORMAT_BUFFER_BYTES];
+    LiDisplay_command_appendFormatted(buffer, printFormat_paddedInt_toBuffer(buffer, value, minDigits, '0'));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// e.g. LiDisplay_command_appendFixedPoint(37123, 4, 3) appends "3.712"
+void LiDisplay_command_appendFixedPoint(int32_t value, uint8_t scaleDigits, uint8_t decimalPlaces)
+{
+    char buffer[PRINTFORMAT_BUFFER_BYTES];
+    LiDisplay_command_appendFormatted(buffer, printFormat_fixedPoint_toBuffer(buffer, value, scaleDigits, decimalPlaces));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// appends "HH:MM:SS"
+void LiDisplay_command_appendTime(uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    LiDisplay_command_appendInt(hours, 2);
+    LiDisplay_command_appendChar(':');
+    LiDisplay_command_appendInt(minutes, 2);
+    LiDisplay_command_appendChar(':');
+    LiDisplay_command_appendInt(seconds, 2);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// appends "page<page>.<elementName>.<attr>="
+void LiDisplay_command_appendElement(uint8_t page, PGM_P elementName, uint8_t elementAttrIndex)
+{
+    LiDisplay_command_appendText_P(PSTR("page"));
+    LiDisplay_command_appendInt(page, 1);
+    LiDisplay_command_appendChar('.');
+    LiDisplay_command_appendText_P(elementName);
+    LiDisplay_command_appendChar('.');
+    LiDisplay_command_appendText_P((PGM_P)pgm_read_ptr(&attrMap[elementAttrIndex]));
+    LiDisplay_command_appendChar('=');
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// all cached elements are resent after this is called (e.g. after the page changes)
+void LiDisplay_command_invalidateCache(void)
+{
+    LiDisplay_isCacheSlotValid = 0;
+    memset(LiDisplay_cellColour_onScreen, LIDISPLAY_CELL_COLOUR_UNKNOWN, sizeof(LiDisplay_cellColour_onScreen));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// returns true if this exact command was the last one sent to cacheSlot
+bool LiDisplay_command_isAlreadyOnScreen(uint8_t cacheSlot)
+{
+    if (cacheSlot >= LIDISPLAY_NUM_CACHE_SLOTS) { return false; }
+
+    uint16_t commandCRC = 0xFFFF;
+    for (uint8_t ii = 0; ii < LiDisplay_commandLength; ii++) { commandCRC = _crc_ccitt_update(commandCRC, LiDisplay_command[ii]); }
+
+    uint32_t slotMask = ((uint32_t)1 << cacheSlot);
+    if ((LiDisplay_isCacheSlotValid & slotMask) && (LiDisplay_lastSentCRC[cacheSlot] == commandCRC)) { return true; }
+
+    LiDisplay_lastSentCRC[cacheSlot] = commandCRC;
+    LiDisplay_isCacheSlotValid |= slotMask;
+    return false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_command_send(uint8_t cacheSlot)
+{
+    #ifdef LIDISPLAY_CONNECTED
+        if (LiDisplay_isCommandTooLong == true) { return; } // a truncated command would confuse the Nextion
+        if (LiDisplay_command_isAlreadyOnScreen(cacheSlot) == true) { return; }
+
+        LiDisplay_command[LiDisplay_commandLength++] = 0xFF; // Nextion command terminator
+        LiDisplay_command[LiDisplay_commandLength++] = 0xFF;
+        LiDisplay_command[LiDisplay_commandLength++] = 0xFF;
+
+        for (uint8_t ii = 0; ii < LiDisplay_commandLength; ii++) { LiDisplay_writeByte(LiDisplay_command[ii]); }
+    #endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// string values are enclosed in quotes
+void LiDisplay_command_beginStringVal(uint8_t page, PGM_P elementName, uint8_t elementAttrIndex)
+{
+    LiDisplay_command_begin();
+    LiDisplay_command_appendElement(page, elementName, elementAttrIndex);
+    LiDisplay_command_appendChar('"');
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_command_sendStringVal(uint8_t cacheSlot)
+{
+    LiDisplay_command_appendChar('"');
+    LiDisplay_command_send(cacheSlot);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_updateNumericVal(uint8_t page, PGM_P elementName, uint8_t elementAttrIndex, int32_t value, uint8_t cacheSlot)
+{
+    LiDisplay_command_begin();
+    LiDisplay_command_appendElement(page, elementName, elementAttrIndex);
+    LiDisplay_command_appendInt(value, 1);
+    LiDisplay_command_send(cacheSlot);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_updateStringVal_P(uint8_t page, PGM_P elementName, uint8_t elementAttrIndex, PGM_P value, uint8_t cacheSlot)
+{
+    LiDisplay_command_beginStringVal(page, elementName, elementAttrIndex);
+    LiDisplay_command_appendText_P(value);
+    LiDisplay_command_sendStringVal(cacheSlot);
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -98,6 +327,7 @@ void LiDisplay_begin(void)
         #endif
 
         LiDisplayElementToUpdate = 0;
+        LiDisplay_command_invalidateCache();
 
         LiDisplaySplashPending = false;
         LiDisplayPowerOffPending = false;
@@ -107,39 +337,19 @@ void LiDisplay_begin(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void LiDisplay_updateNumericVal(uint8_t page, String elementName, uint8_t elementAttrIndex, String value) {
-    #ifdef LIDISPLAY_CONNECTED
-        static String LiDisplay_Number_Str;
-
-        LiDisplay_Number_Str = "page" + String(page) + "." + String(elementName) + "." + attrMap[elementAttrIndex] + "=" + value;
-
-        Serial1.print(LiDisplay_Number_Str);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
-    #endif
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////
-
-void LiDisplay_updateStringVal(uint8_t page, String elementName, uint8_t elementAttrIndex, String value) {
-    #ifdef LIDISPLAY_CONNECTED
-        static String LiDisplay_String_Str;
-
-        LiDisplay_String_Str = "page" + String(page) + "." + String(elementName) + "." + attrMap[elementAttrIndex] + "=" + String('"') + value + String('"');
-
-        Serial1.print(LiDisplay_String_Str);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
+void LiDisplay_updateDebugTextBox(const char * raw_data_string) {
+    #ifdef LIDISPLAY_DEBUG_ENABLED
+        LiDisplay_command_beginStringVal(0, PSTR("t12"), LIDISPLAY_ATTR_TXT);    // T12 is a text box on the bottom of the driving page screen.
+        LiDisplay_command_appendText(raw_data_string);
+        LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_NONE);
     #endif
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void LiDisplay_updateDebugTextBox(String raw_data_string) {
+void LiDisplay_updateDebugTextBox_P(PGM_P raw_data_string) {
     #ifdef LIDISPLAY_DEBUG_ENABLED
-        LiDisplay_updateStringVal(0, "t12", 0, raw_data_string);    // T12 is a text box on the bottom of the driving page screen.
+        LiDisplay_updateStringVal_P(0, PSTR("t12"), LIDISPLAY_ATTR_TXT, raw_data_string, LIDISPLAY_CACHE_NONE);
     #endif
 }
 
@@ -218,7 +428,7 @@ void LiDisplay_handleKeyOrGCStateChange()
 				break;
 			case 2: // Grid Charger is plugged in
 				switch(new_power_state) {
-					case 0: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_OFF); LiDisplay_gridChargerUnplugged(); total_splash_page_delay_ms = (250 + LIDISPLAY_GRID_CHARGE_PAGE_COOLDOWN_MS); break;
+					case 0: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_OFF); LiDisplay_gridChargerUnplugged(); total_splash_page_delay_ms = (250 + params_get(PARAM_LIDISPLAY_GRID_COOLDOWN_ms)); break;
 					case 1: LiDisplay_gridChargerUnplugged(); LiDisplay_keyOn(); break; // Driver unplugged GC on same frame as Key ON (unlikely to happen)
 					case 2: break;	// Should never end up here
 					case 3: LiDisplay_keyOn(); break; // GC is already plugged in, Driver turned Key ON, LiDisplay needs to display warning, LiBCM will beep
@@ -226,7 +436,7 @@ void LiDisplay_handleKeyOrGCStateChange()
 				break;
 			case 3: // Key On and GC plugged in -- LiBCM should be beeping at driver, driver likely to take action
 				switch(new_power_state) {
-					case 0: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_OFF); LiDisplay_keyOff(); LiDisplay_gridChargerUnplugged(); total_splash_page_delay_ms = (250 + LIDISPLAY_GRID_CHARGE_PAGE_COOLDOWN_MS); break; // Driver unplugged GC at exact instant contactor relay opened (might happen -- edge case)
+					case 0: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_OFF); LiDisplay_keyOff(); LiDisplay_gridChargerUnplugged(); total_splash_page_delay_ms = (250 + params_get(PARAM_LIDISPLAY_GRID_COOLDOWN_ms)); break; // Driver unplugged GC at exact instant contactor relay opened (might happen -- edge case)
 					case 1: LiDisplay_gridChargerUnplugged(); break; // Driver unplugged GC
 					case 2: LiDisplay_keyOff(); LiDisplay_resetGridChargerPageVariables(); break; // Driver keyed OFF, contactor finally opened
 					case 3: break;	// Should never end up here
@@ -237,63 +447,38 @@ void LiDisplay_handleKeyOrGCStateChange()
 		//Serial.print(F("\nLiDisplay_handleKeyOrGCStateChange - power state changed - new_power_state_millis has been updated"));
 		LiDisplayNeedToVerifyPowerState = true;
 		//Serial.print(F("\nLiDisplayNeedToVerifyPowerState = true"));
-		LiDisplay_updateDebugTextBox("Power state eval pending...");
+		LiDisplay_updateDebugTextBox_P(PSTR("Power state eval pending..."));
 	}
 	LiDisplay_powerState = new_power_state;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void LiDisplay_updateGlobalObjectVal(String elementName, uint8_t elementAttrIndex, String value) {
-    #ifdef LIDISPLAY_CONNECTED
-        static String LiDisplay_ObjectUpdate_Str;
-
-        LiDisplay_ObjectUpdate_Str = String(elementName) + "." + attrMap[elementAttrIndex] + "=" + value;
-
-        Serial1.print(LiDisplay_ObjectUpdate_Str);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
-    #endif
+void LiDisplay_updateGlobalObjectVal(PGM_P elementName, uint8_t elementAttrIndex, int32_t value) {
+    LiDisplay_command_begin();
+    LiDisplay_command_appendText_P(elementName);
+    LiDisplay_command_appendChar('.');
+    LiDisplay_command_appendText_P((PGM_P)pgm_read_ptr(&attrMap[elementAttrIndex]));
+    LiDisplay_command_appendChar('=');
+    LiDisplay_command_appendInt(value, 1);
+    LiDisplay_command_send(LIDISPLAY_CACHE_NONE);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-String LiDisplay_getCellVoltage(String cell_id_str) {
-    uint8_t cell_id = cell_id_str.toInt();
-    uint8_t ic_index = 0;
-    uint8_t ic_cell_num = 0;
-    String formatted_cell_voltage = "0.0000";
-    String returned_voltage = "";
-
-
-    if (cell_id > MAX_CELL_INDEX) return "ERROR";
-
-    if (cell_id <= 11) { ic_index = 0; ic_cell_num = (cell_id); }
-    else if (cell_id <= 23) { ic_index = 1; ic_cell_num = (cell_id - 12); }
-    else if (cell_id <= 35) { ic_index = 2; ic_cell_num = (cell_id - 24); }
-    else if (cell_id <= 47) { ic_index = 3; ic_cell_num = (cell_id - 36); }
-    else if (cell_id <= 59) { ic_index = 4; ic_cell_num = (cell_id - 48); }
-
-    returned_voltage = String(LTC68042result_specificCellVoltage_get(ic_index, ic_cell_num));
-    formatted_cell_voltage[0] = returned_voltage[0];
-    formatted_cell_voltage[2] = returned_voltage[1];
-    formatted_cell_voltage[3] = returned_voltage[2];
-    formatted_cell_voltage[4] = returned_voltage[3];
-    formatted_cell_voltage[5] = returned_voltage[4];
-
-    return formatted_cell_voltage;
+// Cell IDs 0:11 are on LTC6804 IC 0, 12:23 on IC 1, etc.
+uint16_t LiDisplay_getCellVoltage_counts(uint8_t cell_id) {
+    return LTC68042result_specificCellVoltage_get(cell_id / 12, cell_id % 12);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-LiDisplay_updateNextCellValue() {
-    static String LiDisplay_Color_Str;
+void LiDisplay_updateNextCellValue() {
     static uint8_t cellToUpdate = 0;
     static uint8_t ic_index = 0;
     static uint8_t ic_cell_num = 0;
     static uint16_t cell_avg_voltage = 0;
-    static String cell_color_number = "2016";
+    static uint8_t cell_colour_index = 3;
     static int cell_voltage_diff_from_avg = 0;
     static int temp_cell_voltage = 0;
 
@@ -320,25 +505,34 @@ LiDisplay_updateNextCellValue() {
 
     // 17 Oct 2023 -- Feedback from users and JTS indicates we should have the window larger than 3.2mV
     // So now we will use LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS and are defaulting it to 6.4mV
-    if (cell_voltage_diff_from_avg >= (LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS * 2.5)) { cell_color_number = "63488"; }        // 63488 = Red
-    else if (cell_voltage_diff_from_avg >= (LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS * 1.5)) { cell_color_number = "64480"; }   // 64480 = Orange
-    else if (cell_voltage_diff_from_avg >= (LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS * 0.5)) { cell_color_number = "65504"; }   // 65504 = Yellow
-    else if (cell_voltage_diff_from_avg >= (LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS * -0.5)) { cell_color_number = "2016"; }   // 2016 = Green
-    else if (cell_voltage_diff_from_avg >= (LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS * -1.5)) { cell_color_number = "2047"; }   // 2047 = Cyan
-    else if (cell_voltage_diff_from_avg >= (LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS * -2.5)) { cell_color_number = "31"; }     // 31 = Blue
-    else { cell_color_number = "22556"; }   // 22556 = Purple
-
-    LiDisplay_Color_Str = "page" + String(LIDISPLAY_GRIDCHARGE_PAGE_ID) + ".j" + String(cellToUpdate) + ".pco" + "=" + cell_color_number;
-
-    Serial1.print(LiDisplay_Color_Str);
-    Serial1.write(0xFF);
-    Serial1.write(0xFF);
-    Serial1.write(0xFF);
-
-    if (gc_currently_selected_cell_id_str.toInt() == cellToUpdate)
+    uint16_t colourBinSize = params_get(PARAM_LIDISPLAY_CELL_COLOR_BIN);
+    if (cell_voltage_diff_from_avg >= (colourBinSize * 2.5)) { cell_colour_index = 0; }        // Red
+    else if (cell_voltage_diff_from_avg >= (colourBinSize * 1.5)) { cell_colour_index = 1; }   // Orange
+    else if (cell_voltage_diff_from_avg >= (colourBinSize * 0.5)) { cell_colour_index = 2; }   // Yellow
+    else if (cell_voltage_diff_from_avg >= (colourBinSize * -0.5)) { cell_colour_index = 3; }  // Green
+    else if (cell_voltage_diff_from_avg >= (colourBinSize * -1.5)) { cell_colour_index = 4; }  // Cyan
+    else if (cell_voltage_diff_from_avg >= (colourBinSize * -2.5)) { cell_colour_index = 5; }  // Blue
+    else { cell_colour_index = 6; }   // Purple
+
+    // Only send the colour if it changed (60 cells would otherwise be resent every few seconds)
+    if (LiDisplay_cellColour_onScreen[cellToUpdate] != cell_colour_index)
+    {
+        LiDisplay_command_begin();
+        LiDisplay_command_appendText_P(PSTR("page"));
+        LiDisplay_command_appendInt(LIDISPLAY_GRIDCHARGE_PAGE_ID, 1);
+        LiDisplay_command_appendText_P(PSTR(".j"));
+        LiDisplay_command_appendInt(cellToUpdate, 1);
+        LiDisplay_command_appendText_P(PSTR(".pco="));
+        LiDisplay_command_appendInt(pgm_read_word(&cellColourMap[cell_colour_index]), 1);
+        LiDisplay_command_send(LIDISPLAY_CACHE_NONE);
+
+        LiDisplay_cellColour_onScreen[cellToUpdate] = cell_colour_index;
+    }
+
+    if (gc_currently_selected_cell_id == cellToUpdate)
 	{
-        LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t17", 4, "44373");
-        gc_currently_selected_cell_id_str = "99";
+        LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t17"), LIDISPLAY_ATTR_PCO, 44373, LIDISPLAY_CACHE_NONE);
+        gc_currently_selected_cell_id = 99;
     }
 
     cellToUpdate += 1;
@@ -346,13 +540,13 @@ LiDisplay_updateNextCellValue() {
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void LiDisplay_calculateKeyTimeStr(bool reset) {
-    // TODO_NATALYA:  When this is finalized we need to replace code in LiDisplay_calculateGCTimeStr with code more like this
+void LiDisplay_calculateKeyTime(bool reset) {
+    // TODO_NATALYA:  When this is finalized we need to replace code in LiDisplay_calculateGCTime with code more like this
     static uint32_t current_key_on_ms = 0;
     static uint16_t current_key_time_seconds = 0;
-    static uint8_t kt_s = 0;
-    static uint8_t kt_m = 0;
-    static uint8_t kt_h = 0;
+    uint8_t kt_s = key_time_seconds;
+    uint8_t kt_m = key_time_minutes;
+    uint8_t kt_h = key_time_hours;
 
     if (reset)
 	{
@@ -383,22 +577,14 @@ void LiDisplay_calculateKeyTimeStr(bool reset) {
     }
     if (kt_h >= 99) { kt_h = 0; }  // Will someone leave the car key-on for +99 hours?
 
-    key_time = "";
-    (kt_h > 9) ? key_time = key_time + kt_h : key_time = key_time + "0" + kt_h;
-    key_time = key_time + ":";
-    (kt_m > 9) ? key_time = key_time + kt_m : key_time = key_time + "0" + kt_m;
-    key_time = key_time + ":";
-    (kt_s > 9) ? key_time = key_time + kt_s : key_time = key_time + "0" + kt_s;
-
+    key_time_seconds = kt_s;
+    key_time_minutes = kt_m;
+    key_time_hours = kt_h;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void LiDisplay_calculateGCTimeStr() {
-    static String gc_sec_prefix = "0";
-    static String gc_min_prefix = "0";
-    static String gc_hour_prefix = "0";
-    static uint16_t temp_gc_millis = 0;
+void LiDisplay_calculateGCTime() {
     static bool gc_was_paused = false;
 
     // Increment time only while charging
@@ -412,21 +598,12 @@ void LiDisplay_calculateGCTimeStr() {
 
         gc_connected_millis_most_recent_diff = (millis() - gc_connected_millis);
 
-        // 05 Oct 2023 -- TODO_NATALYA:  Get rid of modulo and division -- if LiDisplay_calculateKeyTimeStr() works out we can adopt its method
-        // 09 Feb 2023 -- Note to JTS: LiDisplay_calculateGCTimeStr() is only run while the grid charger is plugged in AND key is off.
+        // 05 Oct 2023 -- TODO_NATALYA:  Get rid of modulo and division -- if LiDisplay_calculateKeyTime() works out we can adopt its method
+        // 09 Feb 2023 -- Note to JTS: LiDisplay_calculateGCTime() is only run while the grid charger is plugged in AND key is off.
         // I'd like to address this issue later if possible because it doesn't affect key-on cycle or driving cycle of LiBCM.
         gc_connected_hours = (gc_connected_millis_most_recent_diff / 3600000);
         gc_connected_minutes = (gc_connected_millis_most_recent_diff / 60000) % 60;
         gc_connected_seconds = (gc_connected_millis_most_recent_diff / 1000) % 60;
-
-        if (gc_connected_seconds > 9) { gc_sec_prefix = ""; }
-        else gc_sec_prefix = String(0);
-        if (gc_connected_minutes > 9) { gc_min_prefix = ""; }
-        else gc_min_prefix = String(0);
-        if (gc_connected_hours > 9) { gc_hour_prefix = ""; }
-        else gc_hour_prefix = String(0);
-
-        gc_time = String(gc_hour_prefix) + String(gc_connected_hours) + String(":") + String(gc_min_prefix) + String(gc_connected_minutes) + String(":") + String(gc_sec_prefix) + String(gc_connected_seconds);
     } else { gc_was_paused = true; } // Still plugged in but not charging
 }
 
@@ -522,10 +699,14 @@ void LiDisplay_calculateFanSpeedStr() {
 
 void LiDisplay_initializeSettingsPage() {
     // Start off at CELL_VMAX_GRIDCHARGER
-    LiDisplay_updateStringVal(LIDISPLAY_SETTINGS_PAGE_ID, "t3", 0, editableParamMap[0]);
-    LiDisplay_updateStringVal(LIDISPLAY_SETTINGS_PAGE_ID, "t4", 0, String(CELL_VMAX_GRIDCHARGER));
-    LiDisplay_updateStringVal(LIDISPLAY_SETTINGS_PAGE_ID, "t5", 0, editableParamDescriptions[0]);
-    LiDisplay_updateGlobalObjectVal("n0", 1, String(CELL_VMAX_GRIDCHARGER));
+    LiDisplay_updateStringVal_P(LIDISPLAY_SETTINGS_PAGE_ID, PSTR("t3"), LIDISPLAY_ATTR_TXT, (PGM_P)pgm_read_ptr(&editableParamMap[0]), LIDISPLAY_CACHE_NONE);
+
+    LiDisplay_command_beginStringVal(LIDISPLAY_SETTINGS_PAGE_ID, PSTR("t4"), LIDISPLAY_ATTR_TXT);
+    LiDisplay_command_appendInt(params_get(PARAM_CELL_VMAX_GRIDCHARGER), 1);
+    LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_NONE);
+
+    LiDisplay_updateStringVal_P(LIDISPLAY_SETTINGS_PAGE_ID, PSTR("t5"), LIDISPLAY_ATTR_TXT, (PGM_P)pgm_read_ptr(&editableParamDescriptions[0]), LIDISPLAY_CACHE_NONE);
+    LiDisplay_updateGlobalObjectVal(PSTR("n0"), LIDISPLAY_ATTR_VAL, params_get(PARAM_CELL_VMAX_GRIDCHARGER));
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -555,7 +736,7 @@ void LiDisplay_checkFirmwareExpiration() {
 		#ifdef LIDISPLAY_DEBUG_ENABLED
 			#undef LIDISPLAY_DEBUG_ENABLED
 	    #endif
-		LiDisplay_updateStringVal(0, "t12", 0, "FIRMWARE EXPIRED");
+		LiDisplay_updateStringVal_P(0, PSTR("t12"), LIDISPLAY_ATTR_TXT, PSTR("FIRMWARE EXPIRED"), LIDISPLAY_CACHE_FW_EXPIRED);
 	}
 }
 
@@ -563,20 +744,17 @@ void LiDisplay_checkFirmwareExpiration() {
 
 void LiDisplay_updatePage() {
     #ifdef LIDISPLAY_CONNECTED
-        static String LiDisplay_Page_Str;
-        LiDisplay_Page_Str = "page " + String(LiDisplaySetPageNum);
-
         Serial.print(F("\n"));
-        Serial.print("LiDisplay_updatePage ");
-        Serial.print(LiDisplay_Page_Str);
+        Serial.print(F("LiDisplay_updatePage page "));
+        Serial.print(LiDisplaySetPageNum);
 
-        Serial1.print(LiDisplay_Page_Str);
-
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
-        Serial1.write(0xFF);
+        LiDisplay_command_begin();
+        LiDisplay_command_appendText_P(PSTR("page "));
+        LiDisplay_command_appendInt(LiDisplaySetPageNum, 1);
+        LiDisplay_command_send(LIDISPLAY_CACHE_NONE);
 
         LiDisplayCurrentPageNum = LiDisplaySetPageNum;
+        LiDisplay_command_invalidateCache(); // Nextion redraws every element when the page changes
 
         if (LiDisplaySetPageNum == LIDISPLAY_SETTINGS_PAGE_ID) LiDisplay_initializeSettingsPage();
     #endif
@@ -585,28 +763,298 @@ void LiDisplay_updatePage() {
 /////////////////////////////////////////////////////////////////////////////////////////
 
 
-String LiDisplay_readCommand() {
-    String ret = "";
-    char buffer = "";
+//USART1 is driven directly (not with Arduino's Serial1), so LiBCM can parse Nextion return frames as each byte arrives
+//Serial1 MUST NOT be used anywhere (Arduino's Serial1 interrupts would conflict with LiBCM's)
 
-    while (Serial1.available() > 0) {
-        buffer = Serial1.read();
-        if ((uint8_t)buffer != 0xff) {  // Ignore Termination character
-            if ((uint8_t)buffer != 26) ret += buffer;   // Ignore Empty Spaces
-        }
-        //ret += char(Serial1.read());  // 2023-OCT-17: Serial1 sometimes saw loads of empty spaces in loop and was adding them to ret, so I added the above.
-    };
+struct LiDisplayEvent
+{
+    uint8_t  type;         //LIDISPLAY_EVENT_xxx
+    uint8_t  length;       //data bytes
+    uint8_t  data[LIDISPLAY_RX_FRAME_MAX_BYTES];
+    uint32_t timestamp_us; //when the frame's last byte was received
+};
+
+//RX ISR adds events at head //LiDisplay_handler() removes events from tail
+volatile LiDisplayEvent LiDisplay_events[LIDISPLAY_EVENT_QUEUE_SIZE];
+volatile uint8_t LiDisplay_events_head = 0;
+volatile uint8_t LiDisplay_events_tail = 0;
+
+//RX ISR working values (only accessed inside ISR, or with interrupts disabled)
+uint8_t  lidisp_rxFrame[LIDISPLAY_RX_FRAME_MAX_BYTES];
+uint8_t  lidisp_rxLength = 0;
+uint8_t  lidisp_rxTerminatorCount = 0; //consecutive 0xFF bytes
+bool     lidisp_isRxFrameTooLong = NO;
+uint32_t lidisp_rxLatestByte_ms = 0;
+
+//raw bytes, for LiDisplay loopback test (see BringupTester)
+volatile uint8_t LiDisplay_rawBytes[LIDISPLAY_RAW_BUFFER_SIZE];
+volatile uint8_t LiDisplay_rawBytes_head = 0;
+volatile uint8_t LiDisplay_rawBytes_tail = 0;
+
+volatile uint8_t LiDisplay_txBuffer[LIDISPLAY_TX_BUFFER_SIZE];
+volatile uint8_t LiDisplay_txBuffer_head = 0;
+volatile uint8_t LiDisplay_txBuffer_tail = 0;
+
+uint16_t LiDisplay_inputLatency_us = 0;
+uint16_t LiDisplay_inputLatencyMax_us = 0;
+
+uint16_t LiDisplay_inputLatency_us_get(void)    { return LiDisplay_inputLatency_us;    }
+uint16_t LiDisplay_inputLatencyMax_us_get(void) { return LiDisplay_inputLatencyMax_us; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void LiDisplay_USART1_begin(uint16_t ubrrValue, uint8_t frameFormat)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    {
+        UCSR1B = 0; //disable USART1 while it's reconfigured
+        LiDisplay_txBuffer_head = 0;
+        LiDisplay_txBuffer_tail = 0;
+        LiDisplay_rawBytes_head = 0;
+        LiDisplay_rawBytes_tail = 0;
+        lidisp_rxLength = 0;
+        lidisp_rxTerminatorCount = 0;
+        lidisp_isRxFrameTooLong = NO;
+
+        UCSR1A = (1 << U2X1); //double speed mode (lower baud rate error)
+        UBRR1H = highByte(ubrrValue);
+        UBRR1L =  lowByte(ubrrValue);
+        UCSR1C = frameFormat;
+        UCSR1B = (1 << RXEN1) | (1 << TXEN1) | (1 << RXCIE1);
+    }
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//57600 baud, 8 data bits, no parity, 1 stop bit
+//2023 OCT -- Credit to IC User AfterEffect for finding that SERIAL_8N1 fixes comms issues with the Nextion
+void LiDisplay_serialBegin(void) { LiDisplay_USART1_begin(LIDISPLAY_UBRR_VALUE, (1 << UCSZ11) | (1 << UCSZ10)); }
 
-    return ret;
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//38400 baud, 8 data bits, even parity, 1 stop bit
+void LiDisplay_beginLoopbackTest(void) { LiDisplay_USART1_begin(LIDISPLAY_UBRR_VALUE_LOOPBACK_TEST, (1 << UPM11) | (1 << UCSZ11) | (1 << UCSZ10)); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t LiDisplay_bytesAvailableForWrite(void) { return (LiDisplay_txBuffer_tail - LiDisplay_txBuffer_head - 1) & (LIDISPLAY_TX_BUFFER_SIZE - 1); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//waits if transmit buffer is full //MUST NOT be called with interrupts disabled
+uint8_t LiDisplay_writeByte(uint8_t data)
+{
+    uint8_t nextHead = (LiDisplay_txBuffer_head + 1) & (LIDISPLAY_TX_BUFFER_SIZE - 1);
+
+    while (nextHead == LiDisplay_txBuffer_tail) { ; } //wait for USART1 UDRE ISR to send the oldest byte
+
+    LiDisplay_txBuffer[LiDisplay_txBuffer_head] = data;
+    LiDisplay_txBuffer_head = nextHead;
+
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    UCSR1B |= (1 << UDRIE1); //ISR also writes UCSR1B
+    SREG = oldSREG;
+
+    return data;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns oldest raw byte received
+uint8_t LiDisplay_readByte(void)
+{
+    uint8_t data = 0;
+
+    if (LiDisplay_rawBytes_tail != LiDisplay_rawBytes_head)
+    {
+        data = LiDisplay_rawBytes[LiDisplay_rawBytes_tail];
+        LiDisplay_rawBytes_tail = (LiDisplay_rawBytes_tail + 1) & (LIDISPLAY_RAW_BUFFER_SIZE - 1);
+    }
+
+    return data;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t LiDisplay_bytesAvailableToRead() { return (LiDisplay_rawBytes_head - LiDisplay_rawBytes_tail) & (LIDISPLAY_RAW_BUFFER_SIZE - 1); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//only call from ISR, or with interrupts disabled
+void LiDisplay_discardRxFrame(void)
+{
+    busStats_add(BUS_LIDISPLAY, BUS_STAT_BYTES_DISCARDED, lidisp_rxLength + lidisp_rxTerminatorCount);
+    lidisp_rxLength = 0;
+    lidisp_rxTerminatorCount = 0;
+    lidisp_isRxFrameTooLong = NO;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//Nextion return frames with a fixed length can contain 0xFF data bytes (e.g. 0x71 numeric returns)
+//only call from ISR, or with interrupts disabled
+bool LiDisplay_isRxFrameDataComplete(void)
+{
+    if (lidisp_rxLength == 0) { return YES; }
+
+    switch (lidisp_rxFrame[0])
+    {
+        case 0x65: return (lidisp_rxLength >= 4); //touch event: 0x65 page component pressed
+        case 0x66: return (lidisp_rxLength >= 2); //current page: 0x66 page
+        case 0x71: return (lidisp_rxLength >= 5); //numeric data: 0x71 b0 b1 b2 b3
+        default:   return YES;                     //text (or status byte) never contains 0xFF
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//sort the received frame into an event, then add it to the queue
+//only call from ISR, or with interrupts disabled
+void LiDisplay_publishRxFrame(uint32_t timestamp_us)
+{
+    uint8_t eventType = 0;
+    uint8_t firstDataByte = 1; //event data doesn't include the return code
+
+    if ((lidisp_rxLength == 0) || (lidisp_isRxFrameTooLong == YES)) { LiDisplay_discardRxFrame(); return; }
+
+    if      ((lidisp_rxFrame[0] == 0x65) && (lidisp_rxLength == 4)) { eventType = LIDISPLAY_EVENT_TOUCH;  }
+    else if ((lidisp_rxFrame[0] == 0x66) && (lidisp_rxLength == 2)) { eventType = LIDISPLAY_EVENT_PAGE;   }
+    else if ((lidisp_rxFrame[0] == 0x71) && (lidisp_rxLength == 5)) { eventType = LIDISPLAY_EVENT_NUMBER; }
+    else if  (lidisp_rxFrame[0] == 'p')                              { eventType = LIDISPLAY_EVENT_COMMAND; firstDataByte = 0; } //'p' is also Nextion's string return code (0x70)
+    else if  (lidisp_rxLength == 1)                                  { eventType = LIDISPLAY_EVENT_STATUS;  firstDataByte = 0; }
+    else                                                             { LiDisplay_discardRxFrame(); return; } //unknown frame
+
+    uint8_t nextHead = (LiDisplay_events_head + 1) & (LIDISPLAY_EVENT_QUEUE_SIZE - 1);
+    if (nextHead == LiDisplay_events_tail)
+    {
+        //queue full //newest event is dropped
+        busStats_increment(BUS_LIDISPLAY, BUS_STAT_OVERRUN_ERRORS);
+        LiDisplay_discardRxFrame();
+        return;
+    }
+
+    volatile LiDisplayEvent *event = &LiDisplay_events[LiDisplay_events_head];
+    event->type = eventType;
+    event->length = lidisp_rxLength - firstDataByte;
+    for (uint8_t ii = 0; ii < event->length; ii++) { event->data[ii] = lidisp_rxFrame[ii + firstDataByte]; }
+    event->timestamp_us = timestamp_us;
+    LiDisplay_events_head = nextHead;
+
+    busStats_increment(BUS_LIDISPLAY, BUS_STAT_FRAMES_OK);
+    busStats_logRxBytesWaiting(BUS_LIDISPLAY, (LiDisplay_events_head - LiDisplay_events_tail) & (LIDISPLAY_EVENT_QUEUE_SIZE - 1));
+
+    lidisp_rxLength = 0;
+    lidisp_rxTerminatorCount = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//Frames are assembled one byte at a time, as each byte arrives
+//Each complete frame is added to the event queue (see LiDisplay_publishRxFrame())
+ISR(USART1_RX_vect)
+{
+    uint32_t timestamp_us = micros(); //RX complete interrupt occurs during the stop bit
+    uint8_t status = UCSR1A; //MUST read before UDR1
+    uint8_t data = UDR1;
+
+    //store raw byte //oldest byte is overwritten if buffer is full
+    LiDisplay_rawBytes[LiDisplay_rawBytes_head] = data;
+    LiDisplay_rawBytes_head = (LiDisplay_rawBytes_head + 1) & (LIDISPLAY_RAW_BUFFER_SIZE - 1);
+    if (LiDisplay_rawBytes_head == LiDisplay_rawBytes_tail) { LiDisplay_rawBytes_tail = (LiDisplay_rawBytes_tail + 1) & (LIDISPLAY_RAW_BUFFER_SIZE - 1); }
+
+    lidisp_rxLatestByte_ms = millis();
+
+    if (status & ((1 << FE1) | (1 << UPE1) | (1 << DOR1)))
+    {
+        //framing error, parity error, or previous byte lost //discard partial frame
+        if (status & (1 << FE1))  { busStats_increment(BUS_LIDISPLAY, BUS_STAT_FRAMING_ERRORS); }
+        if (status & (1 << UPE1)) { busStats_increment(BUS_LIDISPLAY, BUS_STAT_PARITY_ERRORS);  }
+        if (status & (1 << DOR1)) { busStats_increment(BUS_LIDISPLAY, BUS_STAT_OVERRUN_ERRORS); }
+        busStats_increment(BUS_LIDISPLAY, BUS_STAT_BYTES_DISCARDED); //this byte
+        LiDisplay_discardRxFrame();
+        return;
+    }
+
+    if ((data == 0xFF) && (LiDisplay_isRxFrameDataComplete() == YES))
+    {
+        lidisp_rxTerminatorCount++;
+        if (lidisp_rxTerminatorCount == 3) { LiDisplay_publishRxFrame(timestamp_us); }
+        return;
+    }
+
+    if (lidisp_rxTerminatorCount > 0) { LiDisplay_discardRxFrame(); } //0xFF isn't valid text, so this frame is corrupt
+
+    if (lidisp_rxLength < LIDISPLAY_RX_FRAME_MAX_BYTES) { lidisp_rxFrame[lidisp_rxLength++] = data; }
+    else                                                 { lidisp_isRxFrameTooLong = YES; busStats_increment(BUS_LIDISPLAY, BUS_STAT_BYTES_DISCARDED); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+ISR(USART1_UDRE_vect)
+{
+    if (LiDisplay_txBuffer_tail != LiDisplay_txBuffer_head)
+    {
+        UDR1 = LiDisplay_txBuffer[LiDisplay_txBuffer_tail];
+        LiDisplay_txBuffer_tail = (LiDisplay_txBuffer_tail + 1) & (LIDISPLAY_TX_BUFFER_SIZE - 1);
+    }
+
+    if (LiDisplay_txBuffer_tail == LiDisplay_txBuffer_head) { UCSR1B &= ~(1 << UDRIE1); } //nothing left to send
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//publish text that wasn't followed by a terminator (e.g. HMI project sends "p0.b0.rel" without 0xFF 0xFF 0xFF)
+void LiDisplay_publishStalledRxFrame(void)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    if ((lidisp_rxLength > 0) && ((uint32_t)(millis() - lidisp_rxLatestByte_ms) > LIDISPLAY_RX_FRAME_TIMEOUT_ms))
+    {
+        lidisp_rxTerminatorCount = 0;
+        LiDisplay_publishRxFrame(micros());
+    }
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//copies oldest event into 'event' //returns NO if queue is empty
+bool LiDisplay_getNextEvent(LiDisplayEvent *event)
+{
+    if (LiDisplay_events_tail == LiDisplay_events_head) { return NO; }
+
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    {
+        volatile LiDisplayEvent *oldest = &LiDisplay_events[LiDisplay_events_tail];
+        event->type = oldest->type;
+        event->length = oldest->length;
+        for (uint8_t ii = 0; ii < oldest->length; ii++) { event->data[ii] = oldest->data[ii]; }
+        event->timestamp_us = oldest->timestamp_us;
+        LiDisplay_events_tail = (LiDisplay_events_tail + 1) & (LIDISPLAY_EVENT_QUEUE_SIZE - 1);
+    }
+    SREG = oldSREG;
+
+    //time from frame's last stop bit until LiBCM acts on it
+    uint32_t latency_us = micros() - event->timestamp_us;
+    if (latency_us > 0xFFFF) { latency_us = 0xFFFF; }
+    LiDisplay_inputLatency_us = (uint16_t)latency_us;
+    if (LiDisplay_inputLatency_us > LiDisplay_inputLatencyMax_us) { LiDisplay_inputLatencyMax_us = LiDisplay_inputLatency_us; }
+
+    return YES;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void LiDisplay_processCommand(String cmd_str) {
+void LiDisplay_processCommand(const char cmd_str[], uint8_t cmd_length) {
     uint8_t cmd_page_id = 0;
-    char cmd_obj_type = "";
-    String cmd_obj_id_str = "";
-    uint8_t ic_cell_address[2] = {0,0};
+    char cmd_obj_type = 0;
+    uint8_t cmd_obj_id = 0;
+
+    if (cmd_length < 5) { return; } // too short to be a valid command
 
     cmd_page_id = cmd_str[1] - '0'; // Subtract '0' from a char to get the actual integer value.
     cmd_obj_type = cmd_str[3];
@@ -627,7 +1075,7 @@ void LiDisplay_processCommand(String cmd_str) {
     For simplicity, they are always full (1 solid colour) and we colour-code them to show balance relative to the other cells.
     */
 
-    if (String(cmd_obj_type) == "b")
+    if (cmd_obj_type == 'b')
 	{
         // Button Pressed
         if ((cmd_page_id == (uint8_t)LIDISPLAY_DRIVING_PAGE_ID) || (cmd_page_id == (uint8_t)LIDISPLAY_GRIDCHARGE_PAGE_ID))
@@ -642,10 +1090,10 @@ void LiDisplay_processCommand(String cmd_str) {
 				// Fan Button from driving page pressed
 				// LiDisplay_updateDebugTextBox(cmd_str);
 				switch (fan_getSpeed_now()) {
-					case FAN_HIGH: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_OFF); LiDisplay_updateDebugTextBox("Requested Fan Off"); break;
-					//case FAN_MED: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_HIGH); LiDisplay_updateDebugTextBox("Requested Fan High"); break;
-					case FAN_LOW: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_HIGH); LiDisplay_updateDebugTextBox("Requested Fan High"); break;
-					default: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_LOW); LiDisplay_updateDebugTextBox("Requested Fan Low"); break;
+					case FAN_HIGH: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_OFF); LiDisplay_updateDebugTextBox_P(PSTR("Requested Fan Off")); break;
+					//case FAN_MED: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_HIGH); LiDisplay_updateDebugTextBox_P(PSTR("Requested Fan High")); break;
+					case FAN_LOW: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_HIGH); LiDisplay_updateDebugTextBox_P(PSTR("Requested Fan High")); break;
+					default: fan_requestSpeed(FAN_REQUESTOR_USER, FAN_LOW); LiDisplay_updateDebugTextBox_P(PSTR("Requested Fan Low")); break;
 				}
 			}
         }
@@ -658,17 +1106,33 @@ void LiDisplay_processCommand(String cmd_str) {
 			}
         }
     }
-	else if (String(cmd_obj_type) == "j")
+	else if ((cmd_obj_type == 'j') && (cmd_length >= 6))
 	{
         // Bar-Graph Pressed
-        cmd_obj_id_str = (String(cmd_str[4]) + String(cmd_str[5]));
-
-        LiDisplay_updateStringVal(cmd_page_id, "t17", 0, ("Cell " + cmd_obj_id_str + ": " + LiDisplay_getCellVoltage(cmd_obj_id_str) + "V"));
-        if (cmd_obj_id_str.toInt() < 10) cmd_obj_id_str = cmd_obj_id_str[1];    // Nextion gets confused by leading 0.
-        LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, String("j" + cmd_obj_id_str), 4, "65535");
-        LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t17", 4, "65535");
-
-        gc_currently_selected_cell_id_str = cmd_obj_id_str;
+        cmd_obj_id = ((cmd_str[4] - '0') * 10) + (cmd_str[5] - '0');
+
+        LiDisplay_command_beginStringVal(cmd_page_id, PSTR("t17"), LIDISPLAY_ATTR_TXT);
+        LiDisplay_command_appendText_P(PSTR("Cell "));
+        LiDisplay_command_appendInt(cmd_obj_id, 2);
+        LiDisplay_command_appendText_P(PSTR(": "));
+        if (cmd_obj_id > MAX_CELL_INDEX) { LiDisplay_command_appendText_P(PSTR("ERROR")); }
+        else                             { LiDisplay_command_appendFixedPoint(LiDisplay_getCellVoltage_counts(cmd_obj_id), 4, 4); }
+        LiDisplay_command_appendChar('V');
+        LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_NONE);
+
+        LiDisplay_command_begin();
+        LiDisplay_command_appendText_P(PSTR("page"));
+        LiDisplay_command_appendInt(LIDISPLAY_GRIDCHARGE_PAGE_ID, 1);
+        LiDisplay_command_appendText_P(PSTR(".j"));
+        LiDisplay_command_appendInt(cmd_obj_id, 1);    // Nextion gets confused by leading 0.
+        LiDisplay_command_appendText_P(PSTR(".pco=65535"));
+        LiDisplay_command_send(LIDISPLAY_CACHE_NONE);
+
+        LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t17"), LIDISPLAY_ATTR_PCO, 65535, LIDISPLAY_CACHE_NONE);
+
+        // Selected cell is now white, so its colour needs to be resent
+        if (cmd_obj_id <= MAX_CELL_INDEX) { LiDisplay_cellColour_onScreen[cmd_obj_id] = LIDISPLAY_CELL_COLOUR_UNKNOWN; }
+        gc_currently_selected_cell_id = cmd_obj_id;
     }
 }
 
@@ -683,7 +1147,7 @@ void LiDisplay_enforceCorrectPowerState() {
 			else if (gpio_HMIStateNow())
 			{
 				LiDisplayNeedToVerifyPowerState = false;
-				LiDisplay_updateDebugTextBox(" "); // clear on-screen debug text
+				LiDisplay_updateDebugTextBox_P(PSTR(" ")); // clear on-screen debug text
 			}
 			break;
 		case 0:
@@ -694,12 +1158,12 @@ void LiDisplay_enforceCorrectPowerState() {
 					LiDisplay_updatePage(); // TODO_NATALYA: this line may not be necessary, evaulate if it can be deleted
 					LiDisplaySplashPending = false;
 				}
-				if ((millis() - new_power_state_millis) > (total_splash_page_delay_ms + LIDISPLAY_SPLASH_PAGE_MS))
+				if ((millis() - new_power_state_millis) > (total_splash_page_delay_ms + params_get(PARAM_LIDISPLAY_SPLASH_PAGE_ms)))
 				{
 					gpio_turnHMI_off();
 					LiDisplayPowerOffPending = false;
 					LiDisplayNeedToVerifyPowerState = false;
-					LiDisplay_updateDebugTextBox(" "); // clear on-screen debug text
+					LiDisplay_updateDebugTextBox_P(PSTR(" ")); // clear on-screen debug text
 				}
 			}
 			break;
@@ -710,6 +1174,30 @@ void LiDisplay_enforceCorrectPowerState() {
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//Nextion sends LiBCM-specific text when buttons or cells are pressed
+//other events are only shown in the debug text box
+void LiDisplay_processEvent(LiDisplayEvent *event)
+{
+    char cmd_str[LIDISPLAY_RX_FRAME_MAX_BYTES + 1];
+
+    switch (event->type)
+    {
+        case LIDISPLAY_EVENT_COMMAND:
+            for (uint8_t ii = 0; ii < event->length; ii++) { cmd_str[ii] = event->data[ii]; }
+            cmd_str[event->length] = 0;
+            LiDisplay_updateDebugTextBox(cmd_str);
+            LiDisplay_processCommand(cmd_str, event->length);
+            break;
+
+        case LIDISPLAY_EVENT_TOUCH:  LiDisplay_updateDebugTextBox_P(PSTR("Touch event")); break;
+        case LIDISPLAY_EVENT_PAGE:   LiDisplay_updateDebugTextBox_P(PSTR("Page event"));  break;
+        case LIDISPLAY_EVENT_NUMBER: LiDisplay_updateDebugTextBox_P(PSTR("Numeric return")); break;
+        default: break; //status bytes (e.g. 0x1A) are ignored
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 void LiDisplay_handler(void)
 {
     #ifdef LIDISPLAY_CONNECTED
@@ -718,27 +1206,12 @@ void LiDisplay_handler(void)
         static uint32_t splash_millis = 0;
         static uint32_t hmi_read_millis = 0;
 
-        String cmd_str = "";
+        LiDisplayEvent event;
 
         //TODO_NATALYA (JTS added): Global formatting request: please either "vertically align brackets", or "place single line code on same line" (both shown below)
-        // 2023 OCT 17 TODO_NATALYA: Evaluate whether or not we need this cooldown anymore now that comms have been fixed
-        if (LiDisplayWaitingForCommand > 0) { LiDisplayWaitingForCommand -= 1; }
-
-        if (LiDisplayWaitingForCommand == 1)
-        {
-            LiDisplayWaitingForCommand -= 1;
-
-            cmd_str = LiDisplay_readCommand();
-
-            if (cmd_str != "")
-            {
-                LiDisplay_updateDebugTextBox(String(cmd_str));
-                LiDisplay_processCommand(cmd_str);
-            }
-        }
-
-        if (Serial1.available() && (LiDisplayWaitingForCommand == 0)) { LiDisplayWaitingForCommand = 100; }  // 100 ms cooldown
-
+        //RX ISR already parsed each Nextion frame, so every queued event is handled immediately (no cooldown)
+        LiDisplay_publishStalledRxFrame();
+        while (LiDisplay_getNextEvent(&event) == YES) { LiDisplay_processEvent(&event); }
 
         LiDisplay_calculateCorrectPage();
         LiDisplay_handleKeyOrGCStateChange();
@@ -768,7 +1241,7 @@ void LiDisplay_handler(void)
 			else
 			{    // Main page loop
                 if (!gpio_HMIStateNow()) return; //LiDisplay is off, so we don't need to run the loop.
-                if (key_getSampledState() == KEYSTATE_ON) { LiDisplay_calculateKeyTimeStr(false); }  // Increment key time outside the loop in case driver switches to settings page
+                if (key_getSampledState() == KEYSTATE_ON) { LiDisplay_calculateKeyTime(false); }  // Increment key time outside the loop in case driver switches to settings page
 
                 switch (LiDisplayCurrentPageNum)
                 {
@@ -777,12 +1250,32 @@ void LiDisplay_handler(void)
                         switch (LiDisplayElementToUpdate)
                         {
                             // 6 elements update very frequently so we won't track their previous value
-                            case 0: LiDisplay_updateStringVal(0, "t3", 0, String((LTC68042result_packVoltage_get() * adc_getLatestBatteryCurrent_amps())*0.001)); break;
-                            case 1: LiDisplay_calculateChrgAsstGaugeBars(); LiDisplay_updateNumericVal(0, "p1", 2, String(LiDisplayChrgAsstPicId)); break;
-                            case 2: LiDisplay_updateStringVal(0, "t9", 0, (String((LTC68042result_hiCellVoltage_get() * 0.0001),3))); break;
-                            case 3: LiDisplay_updateStringVal(0, "t6", 0, (String((LTC68042result_loCellVoltage_get() * 0.0001),3))); break;
-                            case 4: LiDisplay_updateStringVal(0, "t13", 0, key_time); break;
-                            case 5: LiDisplay_updateStringVal(0, "t14", 0, (String(((LTC68042result_hiCellVoltage_get() * 0.1) - (LTC68042result_loCellVoltage_get() * 0.1)),1)+"")); break;
+                            case 0: // kW
+                                LiDisplay_command_beginStringVal(0, PSTR("t3"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendFixedPoint((int32_t)LTC68042result_packVoltage_get() * adc_getLatestBatteryCurrent_amps(), 3, 2);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_POWER);
+                                break;
+                            case 1: LiDisplay_calculateChrgAsstGaugeBars(); LiDisplay_updateNumericVal(0, PSTR("p1"), LIDISPLAY_ATTR_PIC, LiDisplayChrgAsstPicId, LIDISPLAY_CACHE_CHRGASST_PIC); break;
+                            case 2:
+                                LiDisplay_command_beginStringVal(0, PSTR("t9"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendFixedPoint(LTC68042result_hiCellVoltage_get(), 4, 3);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_HI_CELL);
+                                break;
+                            case 3:
+                                LiDisplay_command_beginStringVal(0, PSTR("t6"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendFixedPoint(LTC68042result_loCellVoltage_get(), 4, 3);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_LO_CELL);
+                                break;
+                            case 4:
+                                LiDisplay_command_beginStringVal(0, PSTR("t13"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendTime(key_time_hours, key_time_minutes, key_time_seconds);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_KEY_TIME);
+                                break;
+                            case 5: // mV
+                                LiDisplay_command_beginStringVal(0, PSTR("t14"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendFixedPoint((int32_t)LTC68042result_hiCellVoltage_get() - LTC68042result_loCellVoltage_get(), 1, 1);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_CELL_DELTA);
+                                break;
                             // The other elements update less frequently.  We will update 1 of them.
                             // Priority is from least-likely to change to most-likely to change.
                             case 6:
@@ -791,33 +1284,41 @@ void LiDisplay_handler(void)
                                 LiDisplay_calculateSoCGaugeBars();
                                 if (LiDisplayFanSpeed_onScreen != currentFanSpeed)
 								{
-                                    LiDisplay_updateStringVal(0, "b1", 0, (String(fanSpeedDisplay[currentFanSpeed])));
+                                    LiDisplay_updateStringVal_P(0, PSTR("b1"), LIDISPLAY_ATTR_TXT, (PGM_P)pgm_read_ptr(&fanSpeedDisplay[currentFanSpeed]), LIDISPLAY_CACHE_FAN_SPEED);
                                     LiDisplayFanSpeed_onScreen = currentFanSpeed;
                                 }
 								else if (LiDisplaySoCBars_onScreen != LiDisplaySoCBarCount)
 								{
-                                    LiDisplay_updateNumericVal(0, "p0", 2, String(LiDisplaySoCBarCount));
+                                    LiDisplay_updateNumericVal(0, PSTR("p0"), LIDISPLAY_ATTR_PIC, LiDisplaySoCBarCount, LIDISPLAY_CACHE_SOC_BARS);
                                     LiDisplaySoCBars_onScreen = LiDisplaySoCBarCount;
                                 }
 								else if (LiDisplaySoC_onScreen != SoC_getBatteryStateNow_percent())
 								{
-                                    LiDisplay_updateStringVal(0, "t1", 0, (String(SoC_getBatteryStateNow_percent()) + "%"));
+                                    LiDisplay_command_beginStringVal(0, PSTR("t1"), LIDISPLAY_ATTR_TXT);
+                                    LiDisplay_command_appendInt(SoC_getBatteryStateNow_percent(), 1);
+                                    LiDisplay_command_appendChar('%');
+                                    LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_SOC);
                                     LiDisplaySoC_onScreen = SoC_getBatteryStateNow_percent();
                                 }
 								else if (LiDisplayPackVoltageActual_onScreen != LTC68042result_packVoltage_get())
 								{
-                                    LiDisplay_updateStringVal(0, "t4", 0, String(LTC68042result_packVoltage_get()));
+                                    LiDisplay_command_beginStringVal(0, PSTR("t4"), LIDISPLAY_ATTR_TXT);
+                                    LiDisplay_command_appendInt(LTC68042result_packVoltage_get(), 1);
+                                    LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_PACK_VOLTAGE);
                                     LiDisplayPackVoltageActual_onScreen = LTC68042result_packVoltage_get();
                                 }
 								else if (LiDisplayTemp_onScreen != temperature_battery_getLatest())
 								{
-                                    LiDisplay_updateStringVal(0, "t11", 0, (String(temperature_battery_getLatest()) + "C"));
-                                    LiDisplayPackVoltageActual_onScreen = temperature_battery_getLatest();
+                                    LiDisplay_command_beginStringVal(0, PSTR("t11"), LIDISPLAY_ATTR_TXT);
+                                    LiDisplay_command_appendInt(temperature_battery_getLatest(), 1);
+                                    LiDisplay_command_appendChar('C');
+                                    LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_TEMPERATURE);
+                                    LiDisplayTemp_onScreen = temperature_battery_getLatest();
                                 }
 								else // Nothing else needed to update so we will update the chrg asst bar display again instead.
 								{
                                     LiDisplay_calculateChrgAsstGaugeBars();
-                                    LiDisplay_updateNumericVal(0, "p1", 2, String(LiDisplayChrgAsstPicId));
+                                    LiDisplay_updateNumericVal(0, PSTR("p1"), LIDISPLAY_ATTR_PIC, LiDisplayChrgAsstPicId, LIDISPLAY_CACHE_CHRGASST_PIC);
                                 }
                             break;
                         }
@@ -827,8 +1328,12 @@ void LiDisplay_handler(void)
 						if (LiDisplayElementToUpdate >= 2) { LiDisplayElementToUpdate = 0; }
 						switch (LiDisplayElementToUpdate)
 						{
-							case 0: LiDisplay_updateStringVal(1, "t1", 0, String(FW_VERSION)); break;
-							case 1: LiDisplay_updateStringVal(1, "t3", 0, String(REQUIRED_FIRMWARE_UPDATE_PERIOD_HOURS - eeprom_uptimeStoredInEEPROM_hours_get())); break;
+							case 0: LiDisplay_updateStringVal_P(1, PSTR("t1"), LIDISPLAY_ATTR_TXT, PSTR(FW_VERSION), LIDISPLAY_CACHE_FW_VERSION); break;
+							case 1:
+								LiDisplay_command_beginStringVal(1, PSTR("t3"), LIDISPLAY_ATTR_TXT);
+								LiDisplay_command_appendInt((int32_t)REQUIRED_FIRMWARE_UPDATE_PERIOD_HOURS - eeprom_uptimeStoredInEEPROM_hours_get(), 1);
+								LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_FW_HOURS_LEFT);
+								break;
 						}
 					break;
 
@@ -849,47 +1354,66 @@ void LiDisplay_handler(void)
                         break;
                     case LIDISPLAY_GRIDCHARGE_PAGE_ID:
 
-                        LiDisplay_calculateGCTimeStr();
+                        LiDisplay_calculateGCTime();
                         switch (LiDisplayElementToUpdate)
                         {
                             // 4 elements update very frequently so we won't track their previous value
                             case 0: // This one doesn't update frequently, but its priority is high because we want to notify the user the instant it does update.
 
-                                if (gpio_isGridChargerChargingNow() && !cellBalance_areCellsBalancing()) { LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t7", 0,     "CHARGING"); }
-                                else if (gpio_isGridChargerChargingNow() && (cellBalance_areCellsBalancing())) { LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t7", 0, "CHRG + BLNC"); }
-								else if ((!gpio_isGridChargerChargingNow()) && (cellBalance_areCellsBalancing())) { LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t7", 0, "BALANCING"); }
-								else { LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t7", 0, "IDLE"); }
+                                if (gpio_isGridChargerChargingNow() && !cellBalance_areCellsBalancing()) { LiDisplay_updateStringVal_P(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t7"), LIDISPLAY_ATTR_TXT, PSTR("CHARGING"), LIDISPLAY_CACHE_GC_STATE); }
+                                else if (gpio_isGridChargerChargingNow() && (cellBalance_areCellsBalancing())) { LiDisplay_updateStringVal_P(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t7"), LIDISPLAY_ATTR_TXT, PSTR("CHRG + BLNC"), LIDISPLAY_CACHE_GC_STATE); }
+								else if ((!gpio_isGridChargerChargingNow()) && (cellBalance_areCellsBalancing())) { LiDisplay_updateStringVal_P(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t7"), LIDISPLAY_ATTR_TXT, PSTR("BALANCING"), LIDISPLAY_CACHE_GC_STATE); }
+								else { LiDisplay_updateStringVal_P(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t7"), LIDISPLAY_ATTR_TXT, PSTR("IDLE"), LIDISPLAY_CACHE_GC_STATE); }
 
                             break;
-                            case 1: LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t3", 0, String(LiDisplayAverageCellVoltage * 0.0001,3)); break;
+                            case 1:
+                                LiDisplay_command_beginStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t3"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendFixedPoint(LiDisplayAverageCellVoltage, 4, 3);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_AVG_CELL);
+                                break;
                             case 2: LiDisplay_updateNextCellValue();    break;
-                            case 3: LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t8", 0, String(gc_time));  break;
+                            case 3:
+                                LiDisplay_command_beginStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t8"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendTime(gc_connected_hours, gc_connected_minutes, gc_connected_seconds);
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_GC_TIME);
+                                break;
                             case 4:
                                 LiDisplay_calculateFanSpeedStr();
                                 if (!gc_sixty_s_fomoco_e_block_enabled && (MAX_CELL_INDEX == 59))
 								{
-                                    LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t16", 3, "65516"); // E block label will be missing on a 60S FoMoCo pack display if we don't run this once.
+                                    LiDisplay_updateNumericVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t16"), LIDISPLAY_ATTR_BCO, 65516, LIDISPLAY_CACHE_NONE); // E block label will be missing on a 60S FoMoCo pack display if we don't run this once.
                                     gc_sixty_s_fomoco_e_block_enabled = true;
                                 }
 								else if (LiDisplayFanSpeed_onScreen != currentFanSpeed)
 								{
-                                    LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "b1", 0, (String(fanSpeedDisplay[currentFanSpeed])));
+                                    LiDisplay_updateStringVal_P(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("b1"), LIDISPLAY_ATTR_TXT, (PGM_P)pgm_read_ptr(&fanSpeedDisplay[currentFanSpeed]), LIDISPLAY_CACHE_FAN_SPEED);
                                     LiDisplayFanSpeed_onScreen = currentFanSpeed;
                                 }
 								else if (LiDisplaySoC_onScreen != SoC_getBatteryStateNow_percent())
 								{
-                                    LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t1", 0, (String(SoC_getBatteryStateNow_percent()) + "%"));
+                                    LiDisplay_command_beginStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t1"), LIDISPLAY_ATTR_TXT);
+                                    LiDisplay_command_appendInt(SoC_getBatteryStateNow_percent(), 1);
+                                    LiDisplay_command_appendChar('%');
+                                    LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_SOC);
                                     LiDisplaySoC_onScreen = SoC_getBatteryStateNow_percent();
                                 }
 								else if (LiDisplayPackVoltageActual_onScreen != LTC68042result_packVoltage_get())
 								{
-                                    LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t4", 0, String(LTC68042result_packVoltage_get()));
+                                    LiDisplay_command_beginStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t4"), LIDISPLAY_ATTR_TXT);
+                                    LiDisplay_command_appendInt(LTC68042result_packVoltage_get(), 1);
+                                    LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_PACK_VOLTAGE);
                                     LiDisplayPackVoltageActual_onScreen = LTC68042result_packVoltage_get();
                                 }
 								else LiDisplay_updateNextCellValue();     break;
 
                             case 5: LiDisplay_updateNextCellValue();    break;
-                            case 6: maxElementId = 5; LiDisplay_updateStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, "t10", 0, (String(gc_begin_soc_str))); break;
+                            case 6:
+                                maxElementId = 5;
+                                LiDisplay_command_beginStringVal(LIDISPLAY_GRIDCHARGE_PAGE_ID, PSTR("t10"), LIDISPLAY_ATTR_TXT);
+                                LiDisplay_command_appendInt(gc_begin_soc_percent, 1);
+                                LiDisplay_command_appendChar('%');
+                                LiDisplay_command_sendStringVal(LIDISPLAY_CACHE_GC_BEGIN_SOC);
+                                break;
                         }
                     break;
                     default : break;
@@ -913,10 +1437,10 @@ void LiDisplay_keyOn(void)
         Serial.print(F("\nLiDisplay_keyOn"));
         Serial.print(F("\nLiDisplay HMI Power On"));
         gpio_turnHMI_on();
-        Serial1.begin(57600,SERIAL_8N1);    // 2023 OCT -- Credit to IC User AfterEffect for finding that SERIAL_8N1 fixes comms issues with the Nextion
+        LiDisplay_serialBegin();
         hmi_power_millis = millis();
         key_time_begin_ms = millis();
-        LiDisplay_calculateKeyTimeStr(true);
+        LiDisplay_calculateKeyTime(true);
 		LiDisplayCurrentPageNum = 100;	// When the Nextion is turned on set this to a nonsensical number to initialize it.
         LiDisplaySetPageNum = LIDISPLAY_DRIVING_PAGE_ID;
 
@@ -936,7 +1460,7 @@ void LiDisplay_keyOff(void)
     #ifdef LIDISPLAY_CONNECTED
         // Check if gpio HMI was already off
         Serial.print(F("\nLiDisplay_keyOff:  gpio_HMIStateNow = "));
-        Serial.print(String(gpio_HMIStateNow()));
+        Serial.print((uint8_t)gpio_HMIStateNow());
         LiDisplaySettingsPageRequested = false;
 
         if (gpio_HMIStateNow())
@@ -959,11 +1483,11 @@ void LiDisplay_gridChargerPluggedIn(void)
         Serial.print(F("\nLiDisplay_gridChargerPluggedIn"));
         Serial.print(F("\nLiDisplay HMI Power On"));
         Serial.print(F("\ngpio_HMIStateNow() = "));
-        Serial.print(String(gpio_HMIStateNow()));
+        Serial.print((uint8_t)gpio_HMIStateNow());
         if (!gpio_HMIStateNow())
 		{
             gpio_turnHMI_on();
-            Serial1.begin(57600,SERIAL_8N1);
+            LiDisplay_serialBegin();
             hmi_power_millis = millis();
         }
         gc_sixty_s_fomoco_e_block_enabled = false;
@@ -972,7 +1496,7 @@ void LiDisplay_gridChargerPluggedIn(void)
         gc_connected_seconds = 0;
         gc_connected_minutes = 0;
         gc_connected_hours = 0;
-        gc_begin_soc_str = (String(SoC_getBatteryStateNow_percent()) + "%");
+        gc_begin_soc_percent = SoC_getBatteryStateNow_percent();
         LiDisplaySoC_onScreen = 100;
         LiDisplayFanSpeed_onScreen = 100;
         maxElementId = 6;
@@ -1010,40 +1534,3 @@ void LiDisplay_setPageNumber(uint8_t page)
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-
-uint8_t LiDisplay_bytesAvailableForWrite(void)
-{
-    #ifdef LIDISPLAY_CONNECTED
-        return Serial1.availableForWrite();
-    #endif
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////
-
-uint8_t LiDisplay_writeByte(uint8_t data)
-{
-    #ifdef LIDISPLAY_CONNECTED
-        Serial1.write(data);
-        return data;
-    #endif
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////
-
-uint8_t LiDisplay_readByte(void)
-{
-    #ifdef LIDISPLAY_CONNECTED
-        return Serial1.read();
-    #endif
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////
-
-uint8_t LiDisplay_bytesAvailableToRead()
-{
-    #ifdef LIDISPLAY_CONNECTED
-        return Serial1.available();
-    #endif
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////
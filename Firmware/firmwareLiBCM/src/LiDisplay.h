@@ -4,6 +4,24 @@
 #ifndef lidisplay_h
     #define lidisplay_h
 
+    #define LIDISPLAY_UBRR_VALUE               (((F_CPU / 4 / 57600) - 1) / 2) //57600 baud (double speed mode)
+    #define LIDISPLAY_UBRR_VALUE_LOOPBACK_TEST (((F_CPU / 4 / 38400) - 1) / 2) //38400 baud (double speed mode)
+
+    #define LIDISPLAY_TX_BUFFER_SIZE  64 //MUST be a power of two
+    #define LIDISPLAY_RAW_BUFFER_SIZE 16 //MUST be a power of two
+
+    //Nextion return frames are terminated by three 0xFF bytes
+    #define LIDISPLAY_RX_FRAME_MAX_BYTES 12 //e.g. "p3.j04.rel" //longer frames are discarded
+    #define LIDISPLAY_RX_FRAME_TIMEOUT_ms 10 //partial frame is published if no terminator arrives
+    #define LIDISPLAY_EVENT_QUEUE_SIZE 4 //MUST be a power of two
+
+    //event types //USART1 RX ISR sorts each complete Nextion return frame into one of these
+    #define LIDISPLAY_EVENT_COMMAND 0 //LiBCM-specific text (e.g. "p0.b0.rel")
+    #define LIDISPLAY_EVENT_TOUCH   1 //0x65 page component pressed
+    #define LIDISPLAY_EVENT_PAGE    2 //0x66 page
+    #define LIDISPLAY_EVENT_NUMBER  3 //0x71 b0 b1 b2 b3 (little endian)
+    #define LIDISPLAY_EVENT_STATUS  4 //single byte instruction return code (e.g. 0x1A invalid variable)
+
     void LiDisplay_begin(void);
 
     void LiDisplay_handler(void);
@@ -18,6 +36,10 @@
 
     void LiDisplay_setPageNumber(uint8_t page); // Candidate for deletion -- page selection should probably only be done within LiDisplay.cpp
 
+    void LiDisplay_serialBegin(void);
+
+    void LiDisplay_beginLoopbackTest(void);
+
     uint8_t LiDisplay_bytesAvailableForWrite(void);
 
     uint8_t LiDisplay_writeByte(uint8_t data);
@@ -26,4 +48,7 @@
 
     uint8_t LiDisplay_bytesAvailableToRead();
 
+    uint16_t LiDisplay_inputLatency_us_get(void);
+    uint16_t LiDisplay_inputLatencyMax_us_get(void);
+
 #endif
@@ -4,15 +4,10 @@
 //maintains battery state of charge
 
 //JTS2doLater: add "REMAP_ACTUAL_SoC_TO_FULL_SCALE_PERCENT" feature //remaps actual SoC and displays to user as "0%=empty" and "100%=full"
-//JTS2doLater:
-//-Save SoC(RAM) to EEPROM
-//-If value in RAM is more than 10% different from EEPROM value, update EEPROM.
-//-Also store if key recently turned off (keyState_previous == on && keyState_now == off)
-
 #include "libcm.h"
 
 //These variables should only be used until the next "////////////////////" comment (after that, use these functions instead)
-uint16_t stackFull_Calculated_mAh  = STACK_mAh_NOM; //JTS2doLater: LiBCM needs to adjust value after it figures out actual pack mAh
+uint16_t stackFull_Calculated_mAh  = STACK_mAh_NOM; //learned value loaded from EEPROM in SoC_begin()
 uint16_t packCharge_Now_mAh = 3000; //immediately overwritten if keyOFF when LiBCM turns on
 uint8_t  packCharge_Now_percent = (packCharge_Now_mAh * 100) / stackFull_Calculated_mAh;
 
@@ -24,6 +19,8 @@ void     SoC_setBatteryStateNow_mAh(uint16_t newPackCharge_mAh) { packCharge_Now
 uint8_t SoC_getBatteryStateNow_percent(void) { return packCharge_Now_percent; }
 void    SoC_setBatteryStateNow_percent(uint8_t newSoC_percent) { packCharge_Now_mAh = (uint16_t)(stackFull_Calculated_mAh * 0.01) * newSoC_percent; }
 
+uint16_t SoC_getStackFullCapacity_mAh(void) { return stackFull_Calculated_mAh; }
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //calculate SoC percent from mAh value (LiBCM stores battery SoC in mAh, not %)
@@ -43,12 +40,210 @@ void SoC_calculateBatteryStateNow_percent(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//Pack capacity learning
+//Capacity is calculated from the charge counted between two resting cell voltage SoC estimates (i.e. 'anchors')
+//Example: if 2000 mAh is removed while resting SoC falls from 80% to 40%, then capacity is 2000 mAh / 40% = 5000 mAh
+//Any charge that isn't coulomb counted (e.g. grid charging & keyOFF cell balancing) invalidates the previous anchor
+
+int32_t  capacityLearning_netCharge_mAh = 0; //charge counted since previous anchor //positive during regen
+uint8_t  capacityLearning_anchorSoC_percent = 0;
+bool     capacityLearning_isAnchorValid = NO;
+uint32_t capacityLearning_latestCurrentFlow_ms = 0;
+
+//called each loop
+void SoC_capacityLearning_checkForUncountedCharge(void)
+{
+    if      (key_getSampledState() == KEYSTATE_ON) { capacityLearning_latestCurrentFlow_ms = millis(); } //current is coulomb counted
+    else if ((gpio_isGridChargerPluggedInNow() == YES) || (cellBalance_areCellsBalancing() == YES))
+    {
+        //current isn't coulomb counted when keyOFF
+        capacityLearning_latestCurrentFlow_ms = millis();
+        capacityLearning_isAnchorValid = NO;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void SoC_capacityLearning_updateCapacity(uint16_t newCapacity_mAh)
+{
+    Serial.print(F("\nLearned capacity (mAh): "));
+    Serial.print(stackFull_Calculated_mAh);
+    Serial.print(F(" -> "));
+    Serial.print(newCapacity_mAh);
+
+    stackFull_Calculated_mAh = newCapacity_mAh;
+    eeprom_learnedCapacity_mAh_set(newCapacity_mAh); //only written when learned value changes
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call with each new resting cell voltage SoC estimate, before SoC is updated
+void SoC_capacityLearning_handleNewAnchor(uint8_t restingSoC_percent)
+{
+    if ((millis() - capacityLearning_latestCurrentFlow_ms) < SoC_CAPACITY_LEARNING_REST_TIME_ms) { return; } //cells haven't settled yet
+
+    if (capacityLearning_isAnchorValid == YES)
+    {
+        int16_t deltaSoC_percent = (int16_t)restingSoC_percent - capacityLearning_anchorSoC_percent; //positive after net charge
+        uint16_t deltaSoC_magnitude = abs(deltaSoC_percent);
+
+        bool isSameDirection = ( ((deltaSoC_percent > 0) && (capacityLearning_netCharge_mAh > 0)) ||
+                                 ((deltaSoC_percent < 0) && (capacityLearning_netCharge_mAh < 0))  );
+
+        if ((deltaSoC_magnitude >= SoC_CAPACITY_LEARNING_MIN_DELTA_SoC_PERCENT) && (isSameDirection == YES))
+        {
+            uint32_t netCharge_magnitude_mAh = abs(capacityLearning_netCharge_mAh);
+            uint32_t measuredCapacity_mAh = (netCharge_magnitude_mAh * 100) / deltaSoC_magnitude;
+
+            if ((measuredCapacity_mAh >= SoC_CAPACITY_LEARNING_MIN_mAh) && (measuredCapacity_mAh <= SoC_CAPACITY_LEARNING_MAX_mAh))
+            {
+                //SoC is estimated in 1% steps, so larger SoC swings are more trustworthy
+                //Example: 20% swing -> 10% weight //50% swing -> 25% weight (max)
+                uint8_t weight_percent = deltaSoC_magnitude >> 1;
+                if (weight_percent > SoC_CAPACITY_LEARNING_MAX_WEIGHT_PERCENT) { weight_percent = SoC_CAPACITY_LEARNING_MAX_WEIGHT_PERCENT; }
+
+                int32_t capacityError_mAh = (int32_t)measuredCapacity_mAh - stackFull_Calculated_mAh;
+                uint16_t blendedCapacity_mAh = (uint16_t)(stackFull_Calculated_mAh + ((capacityError_mAh * weight_percent) / 100));
+
+                if (blendedCapacity_mAh != stackFull_Calculated_mAh) { SoC_capacityLearning_updateCapacity(blendedCapacity_mAh); }
+            }
+            else { Serial.print(F("\nCapacity estimate out of range")); }
+        }
+    }
+
+    //this resting SoC becomes the next anchor
+    capacityLearning_anchorSoC_percent = restingSoC_percent;
+    capacityLearning_netCharge_mAh = 0;
+    capacityLearning_isAnchorValid = YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//SoC snapshot
+//SoC is saved to EEPROM at keyOFF, and each time SoC changes by SoC_SNAPSHOT_SAVE_DELTA_mAh
+//After a reset (e.g. firmware update or watchdog), the newest snapshot is used until the first cell voltage measurement verifies it
+//LiBCM doesn't have a real time clock, so snapshot age is measured with the EEPROM uptime counter
+
+uint8_t  SoC_source = SoC_SOURCE_DEFAULT;
+uint16_t snapshot_latestSaved_mAh = 0;
+uint32_t SoC_bootToValid_ms = 0; //time when SoC was first verified after LiBCM turned on
+
+uint32_t SoC_bootToValid_ms_get(void) { return SoC_bootToValid_ms; }
+uint8_t  SoC_source_get(void)         { return SoC_source;         }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void SoC_snapshot_save(void)
+{
+    if (SoC_source != SoC_SOURCE_VERIFIED) { return; } //don't overwrite a good snapshot with unverified SoC
+
+    eeprom_SoCsnapshot_save(packCharge_Now_mAh, eeprom_uptimeStoredInEEPROM_hours_get());
+    snapshot_latestSaved_mAh = packCharge_Now_mAh;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//called each loop
+//only saves when EEPROM write queue is empty, so the 8 byte record is queued without ever waiting for EEPROM
+//otherwise the save is retried next loop (keyOFF save is unconditional)
+void SoC_snapshot_saveIfChanged(void)
+{
+    uint16_t deltaCharge_mAh = abs((int32_t)packCharge_Now_mAh - snapshot_latestSaved_mAh);
+
+    if ((deltaCharge_mAh >= SoC_SNAPSHOT_SAVE_DELTA_mAh) && (eeprom_isIdle() == YES)) { SoC_snapshot_save(); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void SoC_snapshot_restore(void)
+{
+    uint16_t snapshot_mAh = 0;
+    uint16_t snapshot_hours = 0;
+
+    if (eeprom_SoCsnapshot_findNewest(&snapshot_mAh, &snapshot_hours) == NO) { Serial.print(F("\nNo SoC snapshot")); return; }
+
+    uint16_t snapshotAge_hours = eeprom_uptimeStoredInEEPROM_hours_get() - snapshot_hours;
+
+    if      (snapshotAge_hours > SoC_SNAPSHOT_MAX_AGE_HOURS) { Serial.print(F("\nSoC snapshot too old"));   }
+    else if (snapshot_mAh > stackFull_Calculated_mAh)        { Serial.print(F("\nSoC snapshot invalid"));   }
+    else
+    {
+        packCharge_Now_mAh = snapshot_mAh;
+        snapshot_latestSaved_mAh = snapshot_mAh;
+        SoC_calculateBatteryStateNow_percent();
+        SoC_source = SoC_SOURCE_SNAPSHOT;
+
+        Serial.print(F("\nSoC restored from snapshot: "));
+        Serial.print(packCharge_Now_percent);
+        Serial.print('%');
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns YES if the restored snapshot agrees with the cell voltage SoC estimate
+bool SoC_snapshot_isConsistent(uint8_t cellVoltageSoC_percent, uint8_t maxError_percent)
+{
+    if (SoC_source != SoC_SOURCE_SNAPSHOT) { return NO; }
+
+    uint8_t error_percent = abs((int16_t)cellVoltageSoC_percent - packCharge_Now_percent);
+
+    if (error_percent <= maxError_percent) { return YES; }
+    else                                   { return NO;  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void SoC_markValid(void)
+{
+    if (SoC_source != SoC_SOURCE_VERIFIED)
+    {
+        SoC_source = SoC_SOURCE_VERIFIED;
+        SoC_bootToValid_ms = millis();
+        snapshot_latestSaved_mAh = packCharge_Now_mAh; //next snapshot saved after SoC changes
+
+        Serial.print(F("\nSoC valid after (ms): "));
+        Serial.print(SoC_bootToValid_ms);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call each time a complete cell voltage frame is processed (keyON only)
+//SoC is unknown if LiBCM turns on while keyON (e.g. after a firmware update)
+void SoC_verifyUsingLoadedCellVoltage(void)
+{
+    if (SoC_source == SoC_SOURCE_VERIFIED) { return; }
+
+    //cell voltage is zero after an isoSPI PEC error
+    if ((LTC68042result_loCellVoltage_get() < 25000) || (LTC68042result_loCellVoltage_get() > 45000)) { return; }
+
+    uint8_t loadedSoC_percent = SoC_estimateFromRestingCellVoltage_percent(); //less accurate than resting estimate
+
+    if (SoC_snapshot_isConsistent(loadedSoC_percent, SoC_SNAPSHOT_MAX_ERROR_KEYON_PERCENT) == YES)
+    {
+        Serial.print(F("\nSoC snapshot verified"));
+    }
+    else
+    {
+        Serial.print(F("\nSoC estimated from loaded cell voltage: "));
+        Serial.print(loadedSoC_percent);
+        Serial.print('%');
+        SoC_setBatteryStateNow_percent(loadedSoC_percent);
+    }
+
+    SoC_markValid();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 //integrate current over time (coulomb counting)
 //LiBCM uses this function to determine SoC while keyON
-void SoC_integrateCharge_adcCounts(int16_t adcCounts)
+//adcCounts12b is oversampled current sensor result (4x 10b result)
+void SoC_integrateCharge_adcCounts12b(int16_t adcCounts12b)
 {
     //determine how much 'charge' (in ADC counts) went into the battery
-    int16_t deltaCharge_counts = adcCounts - ADC_NOMINAL_0A_COUNTS; //positive during assist, negative during regen //adcCounts already calibrated to zero crossing
+    int16_t deltaCharge_counts = adcCounts12b - ADC_NOMINAL_0A_COUNTS_12b; //positive during assist, negative during regen //adcCounts already calibrated to zero crossing
     
     //Time for some dimensional analysis!
     //Note: items in brackets are units (e.g. "123 [amps]", "456 [volts]")
@@ -65,29 +260,33 @@ void SoC_integrateCharge_adcCounts(int16_t adcCounts)
     //int32_t deltaCharge_uCoulomb = (int32_t)deltaCharge_counts * (ADC_MILLIAMPS_PER_COUNT * time_loopPeriod_ms_get());
     //Note: if the battery current value isn't updated each loop, then multiply by the number of loops required for each result
     //JTS2doLater: change time_loopPeriod_ms_get() to delta millis since last run //prevents accumulated error if we don't meet our loop time
-    int32_t deltaCharge_uCoulomb = (int32_t)deltaCharge_counts * (time_loopPeriod_ms_get() * ADC_MILLIAMPS_PER_COUNT);
+    //Note: 12b counts are 1/4 ADC_MILLIAMPS_PER_COUNT, so buffer below stores quarter uCoulombs (no rounding error)
+    int32_t deltaCharge_uCoulomb_x4 = (int32_t)deltaCharge_counts * (time_loopPeriod_ms_get() * ADC_MILLIAMPS_PER_COUNT);
 
     //Notes:
     //5 Ah is 18.0E9 uCoulombs, whereas 2^32 is ~4.3E9 counts...
     //so uint32_t isn't large enough to store the entire battery's charge...
     //so instead we'll store the total battery charge in microAmpHours (1 uAh = 3600 uC)...
     //and we'll decriment an intermediate uCoulomb buffer to zero
-    static int32_t intermediateChargeBuffer_uCoulomb = 0;
+    static int32_t intermediateChargeBuffer_uCoulomb_x4 = 0;
 
-    intermediateChargeBuffer_uCoulomb += deltaCharge_uCoulomb; //gets more positive during assist //gets more negative during regen
+    intermediateChargeBuffer_uCoulomb_x4 += deltaCharge_uCoulomb_x4; //gets more positive during assist //gets more negative during regen
 
     #define ONE_MILLIAMPHOUR_IN_MICROCOULOMBS 3600000
+    #define ONE_MILLIAMPHOUR_IN_MICROCOULOMBS_x4 (ONE_MILLIAMPHOUR_IN_MICROCOULOMBS << ADC_OVERSAMPLE_EXTRA_BITS) //14.4E6 fits in int32_t
 
-    while (intermediateChargeBuffer_uCoulomb > ONE_MILLIAMPHOUR_IN_MICROCOULOMBS )
+    while (intermediateChargeBuffer_uCoulomb_x4 > ONE_MILLIAMPHOUR_IN_MICROCOULOMBS_x4 )
     {   //assist
-        intermediateChargeBuffer_uCoulomb -= ONE_MILLIAMPHOUR_IN_MICROCOULOMBS;  //remove 1 mAh from buffer
+        intermediateChargeBuffer_uCoulomb_x4 -= ONE_MILLIAMPHOUR_IN_MICROCOULOMBS_x4;  //remove 1 mAh from buffer
         if (SoC_getBatteryStateNow_mAh() >    0) { SoC_setBatteryStateNow_mAh( SoC_getBatteryStateNow_mAh() - 1 ); } //pack discharged 1 mAh (assist)
+        capacityLearning_netCharge_mAh--;
     }
 
-    while (intermediateChargeBuffer_uCoulomb < -ONE_MILLIAMPHOUR_IN_MICROCOULOMBS)
+    while (intermediateChargeBuffer_uCoulomb_x4 < -ONE_MILLIAMPHOUR_IN_MICROCOULOMBS_x4)
     {   //regen
-        intermediateChargeBuffer_uCoulomb += ONE_MILLIAMPHOUR_IN_MICROCOULOMBS; //add 1 mAh to buffer
+        intermediateChargeBuffer_uCoulomb_x4 += ONE_MILLIAMPHOUR_IN_MICROCOULOMBS_x4; //add 1 mAh to buffer
         if (SoC_getBatteryStateNow_mAh() < 65535) { SoC_setBatteryStateNow_mAh( SoC_getBatteryStateNow_mAh() + 1 ); } //pack charged 1 mAh (regen)
+        capacityLearning_netCharge_mAh++;
     }
 }
 
@@ -101,15 +300,26 @@ void SoC_updateUsingLatestOpenCircuitVoltage(void)
     uint8_t batterySoC_percent = SoC_estimateFromRestingCellVoltage_percent(); //determine resting SoC
 
     Serial.print(F("\nOld SoC: "));
-    Serial.print( String(SoC_getBatteryStateNow_percent()) );
+    Serial.print(SoC_getBatteryStateNow_percent());
     Serial.print(F("%, New SoC:"));
-    Serial.print(String(batterySoC_percent));
+    Serial.print(batterySoC_percent);
     Serial.print('%');
 
-    if (LTC68042result_hiCellVoltage_get() > CELL_VMAX_REGEN)       { Serial.print(F("\nDANGER: Cell(s) Overcharged!!")); }
-    if (LTC68042result_loCellVoltage_get() < CELL_VMIN_GRIDCHARGER) { Serial.print(F("\nDANGER: Cell(s) Discharged!!" )); }
+    if (LTC68042result_hiCellVoltage_get() > params_get(PARAM_CELL_VMAX_REGEN)      ) { Serial.print(F("\nDANGER: Cell(s) Overcharged!!")); }
+    if (LTC68042result_loCellVoltage_get() < params_get(PARAM_CELL_VMIN_GRIDCHARGER)) { Serial.print(F("\nDANGER: Cell(s) Discharged!!" )); }
 
-    SoC_setBatteryStateNow_percent(batterySoC_percent); //update SoC
+    //cells are resting, so capacity learner and EKF are anchored even when the snapshot is kept
+    SoC_capacityLearning_handleNewAnchor(batterySoC_percent); //MUST run before SoC is updated
+
+    if (SoC_snapshot_isConsistent(batterySoC_percent, SoC_SNAPSHOT_MAX_ERROR_KEYOFF_PERCENT) == YES)
+    {
+        Serial.print(F("\nSoC snapshot verified")); //coulomb counted snapshot is more precise than 1% resting estimate
+    }
+    else { SoC_setBatteryStateNow_percent(batterySoC_percent); } //update SoC
+
+    SoC_EKF_anchorToOpenCircuitVoltage();
+
+    SoC_markValid();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -119,12 +329,12 @@ void SoC_updateUsingLatestOpenCircuitVoltage(void)
 //prevents over-discharge during extended keyOFF
 void SoC_turnOffLiBCM_ifPackEmpty(void)
 {
-    if (LTC68042result_loCellVoltage_get() < CELL_VMIN_GRIDCHARGER)
+    if (LTC68042result_loCellVoltage_get() < params_get(PARAM_CELL_VMIN_GRIDCHARGER))
     {
         Serial.print(F("\nBattery is empty"));
         gpio_turnLiBCM_off(); //game over, thanks for playing
     }
-    else if ((LTC68042result_loCellVoltage_get() < CELL_VMIN_KEYOFF) && //battery is low
+    else if ((LTC68042result_loCellVoltage_get() < params_get(PARAM_CELL_VMIN_KEYOFF)) && //battery is low
              (time_hasKeyBeenOffLongEnough_toTurnOffLiBCM() == true) && //give user time to plug in charger
              (gpio_isGridChargerChargingNow() == NO)                  ) //grid charger isn't charging
     {   
@@ -141,7 +351,7 @@ bool SoC_isThermalManagementAllowed(void)
 
     if ((key_getSampledState() == KEYSTATE_ON)                                                ||
         ((gpio_isGridChargerPluggedInNow() == YES) && (SoC_getBatteryStateNow_percent() > 3)) ||
-        (SoC_getBatteryStateNow_percent() > KEYOFF_DISABLE_THERMAL_MANAGEMENT_BELOW_SoC)       )
+        (SoC_getBatteryStateNow_percent() > params_get(PARAM_KEYOFF_THERMAL_MIN_SoC))                        )
     { enoughEnergy = YES; }
 
     return enoughEnergy;
@@ -152,9 +362,8 @@ bool SoC_isThermalManagementAllowed(void)
 //Calling this function when battery is sourcing/sinking current will cause estimation error
 //Wait at least ten minutes after keyOff for most accurate results
 #ifdef BATTERY_TYPE_5AhG3
-    uint8_t SoC_estimateFromRestingCellVoltage_percent(void)
+    uint8_t SoC_convertRestingCellVoltage_toSoC_percent(uint16_t restingCellVoltage)
     {
-        uint16_t restingCellVoltage = LTC68042result_loCellVoltage_get(); //JTS2doLater: need an algorithm to look at hi cell, too.
         uint8_t estimatedSoC = 0;
 
         if      (restingCellVoltage >= 42000) { estimatedSoC = 100; }
@@ -264,9 +473,8 @@ bool SoC_isThermalManagementAllowed(void)
 
 #elif defined BATTERY_TYPE_47AhFoMoCo
 
-    uint8_t SoC_estimateFromRestingCellVoltage_percent(void)
+    uint8_t SoC_convertRestingCellVoltage_toSoC_percent(uint16_t restingCellVoltage)
         {
-            uint16_t restingCellVoltage = LTC68042result_loCellVoltage_get();
             uint8_t estimatedSoC = 0;
 
             //~/Honda_Insight_LiBCM/Electronics/Lithium Batteries/47 Ah FoMoCo Modules/Resting SoC Discharge Curve
@@ -378,9 +586,26 @@ bool SoC_isThermalManagementAllowed(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+uint8_t SoC_estimateFromRestingCellVoltage_percent(void)
+{
+    return SoC_convertRestingCellVoltage_toSoC_percent(LTC68042result_loCellVoltage_get()); //JTS2doLater: need an algorithm to look at hi cell, too.
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void SoC_begin(void)
+{
+    stackFull_Calculated_mAh = eeprom_learnedCapacity_mAh_get(); //eeprom_begin() already verified this value
+    SoC_snapshot_restore();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 void SoC_handler(void)
 {
+    SoC_capacityLearning_checkForUncountedCharge();
     SoC_calculateBatteryStateNow_percent();
+    SoC_snapshot_saveIfChanged();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -4,7 +4,7 @@
 #ifndef soc_h
     #define soc_h
 
-    void SoC_integrateCharge_adcCounts(int16_t adcCounts);
+    void SoC_integrateCharge_adcCounts12b(int16_t adcCounts12b);
 
     uint16_t SoC_getBatteryStateNow_mAh(void);
     void     SoC_setBatteryStateNow_mAh(uint16_t newPackCharge_mAh);
@@ -12,14 +12,25 @@
     uint8_t SoC_getBatteryStateNow_percent(void);
     void    SoC_setBatteryStateNow_percent(uint8_t newSoC);
 
+    uint16_t SoC_getStackFullCapacity_mAh(void);
+
     uint8_t SoC_estimateFromRestingCellVoltage_percent(void);
+    uint8_t SoC_convertRestingCellVoltage_toSoC_percent(uint16_t restingCellVoltage);
 
     void SoC_updateUsingLatestOpenCircuitVoltage(void);
 
+    void SoC_verifyUsingLoadedCellVoltage(void);
+
+    void SoC_snapshot_save(void);
+    uint32_t SoC_bootToValid_ms_get(void);
+    uint8_t  SoC_source_get(void);
+
     void SoC_turnOffLiBCM_ifPackEmpty(void);
 
     bool SoC_isThermalManagementAllowed(void);
 
+    void SoC_begin(void);
+
     void SoC_handler(void);
 
     #ifdef BATTERY_TYPE_5AhG3
@@ -34,4 +45,19 @@
         #error (Battery type not specified in config.h)
     #endif
 
+    #define SoC_CAPACITY_LEARNING_REST_TIME_ms          KEY_OFF_UPDATE_PERIOD_TEN_MINUTES_ms //resting voltage is only accurate after cells settle
+    #define SoC_CAPACITY_LEARNING_MIN_DELTA_SoC_PERCENT 20 //anchors closer than this are too noisy to learn from
+    #define SoC_CAPACITY_LEARNING_MAX_WEIGHT_PERCENT    25 //max fraction of each new estimate blended into learned capacity
+    #define SoC_CAPACITY_LEARNING_MIN_mAh               (STACK_mAh_NOM >> 1) //50% nominal //estimates outside this range are discarded
+    #define SoC_CAPACITY_LEARNING_MAX_mAh               (STACK_mAh_NOM + (STACK_mAh_NOM / 5)) //120% nominal
+
+    #define SoC_SOURCE_DEFAULT  0 //LiBCM just turned on //SoC unknown
+    #define SoC_SOURCE_SNAPSHOT 1 //restored from EEPROM //not yet verified with cell voltage
+    #define SoC_SOURCE_VERIFIED 2
+
+    #define SoC_SNAPSHOT_SAVE_DELTA_mAh           (STACK_mAh_NOM / 50) //2% //~100 keyON saves per 32 record ring rotation
+    #define SoC_SNAPSHOT_MAX_AGE_HOURS            24 //older snapshots are ignored
+    #define SoC_SNAPSHOT_MAX_ERROR_KEYOFF_PERCENT  5 //snapshot is discarded if resting voltage SoC is further away than this
+    #define SoC_SNAPSHOT_MAX_ERROR_KEYON_PERCENT  15 //loaded cell voltage is less accurate
+
 #endif
@@ -0,0 +1,222 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//Extended Kalman Filter (EKF) SoC estimator
+//corrects the coulomb counted SoC using the loaded cell voltage, so SoC doesn't drift during long keyON drives
+//
+//State vector: x = [SoC, V_RC]
+//  -SoC  units: centiPercent (10000 = 100.00%)
+//  -V_RC units: LTC6804 counts (1 count = 100 uV)
+//
+//Predict: SoC is predicted by the coulomb counter (SoC_integrateCharge_adcCounts12b() runs every loop)
+//         V_RC decays towards (I * R1) with time constant tau
+//Update:  the measured cell voltage is compared against the model (OCV(SoC) - I*R0 - V_RC)...
+//         and the weighted error corrects both SoC and V_RC
+//
+//Only runs once per complete cell voltage frame (~170 ms when 48S)
+//All math is int32 (no floats or int64)
+//Per update cost is four 32b divides & ~twenty 32b multiplies, which is well under 1 ms
+
+#include "libcm.h"
+
+//These variables should only be used until the next "////////////////////" comment (after that, use these functions instead)
+int32_t ekf_P_SoC   = SoC_EKF_P_SoC_MAX; //P11 //SoC is unknown when LiBCM boots //units: centiPercent^2
+int32_t ekf_P_cross = 0;                 //P12 //units: centiPercent * counts
+int32_t ekf_P_VRC   = 0;                 //P22 //units: counts^2
+
+int16_t ekf_VRC_counts = 0;
+int16_t ekf_innovation_counts = 0; //latest (measured - predicted) cell voltage
+
+int32_t ekf_correctionRemainder_mAh_x64 = 0; //corrections smaller than 1 mAh accumulate here
+
+uint32_t ekf_previousUpdate_ms = 0;
+
+//resting cell voltage at 0%, 10%, 20% ... 100% SoC //see SoC_estimateFromRestingCellVoltage_percent()
+//stored in flash (PROGMEM) //MUST read with pgm_read_word()
+#define SoC_EKF_OCV_TABLE_STEP_centiPercent 1000
+#ifdef BATTERY_TYPE_5AhG3
+    const uint16_t ekf_restingCellVoltage_counts[11] PROGMEM = { 29000, 34200, 35200, 35900, 36550, 37050, 37650, 38300, 39400, 40500, 42000 };
+#elif defined BATTERY_TYPE_47AhFoMoCo
+    const uint16_t ekf_restingCellVoltage_counts[11] PROGMEM = { 29500, 34000, 35000, 35600, 36000, 36400, 37100, 38200, 39200, 40400, 42000 };
+#endif
+
+int16_t SoC_EKF_latestInnovation_counts_get(void) { return ekf_innovation_counts; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns one standard deviation, rounded down
+uint8_t SoC_EKF_uncertainty_percent_get(void)
+{
+    uint8_t sigma_percent = 0;
+
+    //1% = 100 centiPercent //integer square root
+    while ( ((uint32_t)(sigma_percent + 1) * 100) * ((uint32_t)(sigma_percent + 1) * 100) <= (uint32_t)ekf_P_SoC ) { sigma_percent++; }
+
+    return sigma_percent;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//cells were just resting, so there's no polarization voltage
+void SoC_EKF_handleKeyOn(void)
+{
+    ekf_VRC_counts = 0;
+    ekf_P_cross = 0;
+    ekf_P_VRC = 0;
+    ekf_previousUpdate_ms = millis();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call each time SoC is set from resting cell voltage
+void SoC_EKF_anchorToOpenCircuitVoltage(void)
+{
+    ekf_P_SoC = SoC_EKF_P_SoC_AFTER_OCV;
+    ekf_correctionRemainder_mAh_x64 = 0;
+    SoC_EKF_handleKeyOn();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+int32_t clampToRange(int32_t value, int32_t minValue, int32_t maxValue)
+{
+    if      (value < minValue) { return minValue; }
+    else if (value > maxValue) { return maxValue; }
+    else                       { return value;    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//piecewise linear interpolation between OCV table entries
+//returns OCV (counts) and stores the local slope (Q8 counts/centiPercent) in *slope_Q8
+uint16_t SoC_EKF_calculateOCV_counts(int16_t SoC_centiPercent, int16_t *slope_Q8)
+{
+    SoC_centiPercent = (int16_t)clampToRange(SoC_centiPercent, 0, 9999);
+
+    uint8_t index = SoC_centiPercent / SoC_EKF_OCV_TABLE_STEP_centiPercent;
+    int16_t offsetWithinStep_centiPercent = SoC_centiPercent - (index * SoC_EKF_OCV_TABLE_STEP_centiPercent);
+    uint16_t stepStartVoltage_counts = pgm_read_word(&ekf_restingCellVoltage_counts[index]);
+    int16_t stepVoltage_counts = pgm_read_word(&ekf_restingCellVoltage_counts[index + 1]) - stepStartVoltage_counts;
+
+    //largest step is 5200 counts (5AhG3, 0% to 10%) //(5200 << 8) fits in int32 //result is 1331, always less than 2048
+    *slope_Q8 = (int16_t)(((int32_t)stepVoltage_counts << 8) / SoC_EKF_OCV_TABLE_STEP_centiPercent);
+
+    //largest product: 5200 * 999 = 5.2E6 fits in int32 //result is less than stepVoltage_counts, so sum fits in uint16
+    return stepStartVoltage_counts + (uint16_t)(((int32_t)stepVoltage_counts * offsetWithinStep_centiPercent) / SoC_EKF_OCV_TABLE_STEP_centiPercent);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//inverse of SoC_EKF_calculateOCV_counts() //interpolated, so each count (100 uV) is resolved (unlike 1% resting SoC table)
+uint16_t SoC_EKF_calculateSoC_centiPercent(uint16_t restingCellVoltage_counts)
+{
+    if (restingCellVoltage_counts <= pgm_read_word(&ekf_restingCellVoltage_counts[0]))  { return 0;     }
+    if (restingCellVoltage_counts >= pgm_read_word(&ekf_restingCellVoltage_counts[10])) { return 10000; }
+
+    uint8_t index = 0;
+    while (restingCellVoltage_counts >= pgm_read_word(&ekf_restingCellVoltage_counts[index + 1])) { index++; }
+
+    uint16_t stepStartVoltage_counts = pgm_read_word(&ekf_restingCellVoltage_counts[index]);
+    uint16_t stepVoltage_counts = pgm_read_word(&ekf_restingCellVoltage_counts[index + 1]) - stepStartVoltage_counts;
+
+    //largest product: 5199 * 1000 fits in uint32
+    return (index * SoC_EKF_OCV_TABLE_STEP_centiPercent) +
+           (uint16_t)(((uint32_t)(restingCellVoltage_counts - stepStartVoltage_counts) * SoC_EKF_OCV_TABLE_STEP_centiPercent) / stepVoltage_counts);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//the SoC correction is applied to the coulomb counter, which then predicts SoC until the next update
+void SoC_EKF_applyCorrection(int32_t correction_centiPercent_Q10)
+{
+    correction_centiPercent_Q10 = clampToRange(correction_centiPercent_Q10, -((int32_t)SoC_EKF_MAX_CORRECTION_centiPercent << 10),
+                                                                             ((int32_t)SoC_EKF_MAX_CORRECTION_centiPercent << 10));
+
+    //Q10 -> Q6 //(200 << 6) * 65535 mAh fits in int32
+    ekf_correctionRemainder_mAh_x64 += ((correction_centiPercent_Q10 >> 4) * SoC_getStackFullCapacity_mAh()) / 10000;
+
+    int16_t correction_mAh = (int16_t)(ekf_correctionRemainder_mAh_x64 / 64);
+    ekf_correctionRemainder_mAh_x64 -= (int32_t)correction_mAh * 64;
+
+    int32_t newCharge_mAh = (int32_t)SoC_getBatteryStateNow_mAh() + correction_mAh;
+    SoC_setBatteryStateNow_mAh( (uint16_t)clampToRange(newCharge_mAh, 0, SoC_getStackFullCapacity_mAh()) );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//Call each time a complete cell voltage frame is processed (keyON only)
+void SoC_EKF_update(void)
+{
+    #ifndef DISABLE_SoC_EKF
+        #ifdef SoC_EKF_USE_AVERAGE_CELL_VOLTAGE
+            uint16_t measuredCellVoltage_counts = LTC68042result_avgCellVoltage_get();
+        #else
+            uint16_t measuredCellVoltage_counts = LTC68042result_loCellVoltage_get(); //SoC is defined by the lowest cell
+        #endif
+
+        //cell voltage is zero after an isoSPI PEC error //don't corrupt SoC with bad data
+        if ((measuredCellVoltage_counts < 25000) || (measuredCellVoltage_counts > 45000)) { return; }
+
+        //time since previous update
+        uint32_t timeNow_ms = millis();
+        uint32_t deltaTime_ms = timeNow_ms - ekf_previousUpdate_ms;
+        ekf_previousUpdate_ms = timeNow_ms;
+        if (deltaTime_ms > SoC_EKF_TAU_ms) { deltaTime_ms = SoC_EKF_TAU_ms; }
+
+        //positive during assist //deciAmps * microOhms / 1000 = counts //max value: 1400 dA * 1200 uOhm
+        int16_t current_deciAmps = adc_getLatestBatteryCurrent_deciAmps();
+        int32_t voltageDrop_R0_counts = ((int32_t)current_deciAmps * SoC_EKF_R0_microOhms) / 1000;
+        int32_t voltageDrop_R1_counts = ((int32_t)current_deciAmps * SoC_EKF_R1_microOhms) / 1000;
+
+        //////////////////////
+        // Predict
+        //////////////////////
+
+        //SoC prediction is the coulomb counter's latest value
+        int16_t SoC_centiPercent = (int16_t)(((uint32_t)SoC_getBatteryStateNow_mAh() * 10000) / SoC_getStackFullCapacity_mAh());
+
+        //a = exp(-dt/tau) ~= 1 - dt/tau //Q15
+        int32_t decay_Q15 = 32768 - (int32_t)((deltaTime_ms << 15) / SoC_EKF_TAU_ms);
+
+        ekf_VRC_counts = (int16_t)((decay_Q15 * ekf_VRC_counts + (32768 - decay_Q15) * voltageDrop_R1_counts) >> 15);
+
+        //P = F*P*F' + Q, where F = [1 0; 0 a]
+        ekf_P_SoC   = clampToRange(ekf_P_SoC + SoC_EKF_Q_SoC, 1, SoC_EKF_P_SoC_MAX);
+        ekf_P_cross = (decay_Q15 * (ekf_P_cross >> 4)) >> 11; //P12 max (126000 >> 4) * 32768 fits in int32
+        ekf_P_VRC   = clampToRange(((((decay_Q15 * decay_Q15) >> 15) * ekf_P_VRC) >> 15) + SoC_EKF_Q_VRC, 0, SoC_EKF_P_VRC_MAX);
+
+        //////////////////////
+        // Update
+        //////////////////////
+
+        int16_t slope_Q8 = 0; //H = [dOCV/dSoC, -1]
+        uint16_t predictedOCV_counts = SoC_EKF_calculateOCV_counts(SoC_centiPercent, &slope_Q8);
+
+        int32_t predictedCellVoltage_counts = (int32_t)predictedOCV_counts - voltageDrop_R0_counts - ekf_VRC_counts;
+        ekf_innovation_counts = (int16_t)clampToRange((int32_t)measuredCellVoltage_counts - predictedCellVoltage_counts, -2000, 2000);
+
+        //P*H' //largest product: SoC_EKF_P_SoC_MAX * 2047 fits in int32
+        int32_t PHt_SoC = ((ekf_P_SoC   * slope_Q8) >> 8) - ekf_P_cross;
+        int32_t PHt_VRC = ((ekf_P_cross * slope_Q8) >> 8) - ekf_P_VRC;
+
+        //S = H*P*H' + R //always at least R
+        int32_t innovationVariance = (((PHt_SoC >> 4) * slope_Q8) >> 4) - PHt_VRC + SoC_EKF_R_VCELL;
+        if (innovationVariance < SoC_EKF_R_VCELL) { innovationVariance = SoC_EKF_R_VCELL; }
+
+        //K = P*H' / S //Q10 //S >> 6 is at least 312, so precision loss is under 0.5%
+        int32_t innovationVariance_div64 = innovationVariance >> 6;
+        int32_t gain_SoC_Q10 = (PHt_SoC << 4) / innovationVariance_div64;
+        int32_t gain_VRC_Q10 = (PHt_VRC << 4) / innovationVariance_div64;
+
+        //x = x + K*y
+        SoC_EKF_applyCorrection(gain_SoC_Q10 * ekf_innovation_counts);
+        ekf_VRC_counts += (int16_t)((gain_VRC_Q10 * ekf_innovation_counts) >> 10);
+
+        //P = P - K*H*P
+        ekf_P_SoC   = clampToRange(ekf_P_SoC   - ((gain_SoC_Q10 >> 2) * (PHt_SoC >> 8)), 1, SoC_EKF_P_SoC_MAX);
+        ekf_P_cross = clampToRange(ekf_P_cross - ((gain_SoC_Q10 >> 2) * (PHt_VRC >> 8)), -SoC_EKF_P_CROSS_MAX, SoC_EKF_P_CROSS_MAX);
+        ekf_P_VRC   = clampToRange(ekf_P_VRC   - ((gain_VRC_Q10 * (PHt_VRC >> 4)) >> 6), 0, SoC_EKF_P_VRC_MAX);
+    #endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,45 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef soc_ekf_h
+    #define soc_ekf_h
+
+    void SoC_EKF_handleKeyOn(void);
+
+    void SoC_EKF_anchorToOpenCircuitVoltage(void);
+
+    void SoC_EKF_update(void);
+
+    uint16_t SoC_EKF_calculateSoC_centiPercent(uint16_t restingCellVoltage_counts);
+
+    int16_t SoC_EKF_latestInnovation_counts_get(void);
+    uint8_t SoC_EKF_uncertainty_percent_get(void);
+
+    //Equivalent circuit model: Vcell = OCV(SoC) - (I * R0) - V_RC
+    //V_RC is the voltage across a single parallel RC branch (R1 || C1), with time constant tau = R1 * C1
+    //JTS2doLater: characterize these values versus temperature and SoC
+    #ifdef BATTERY_TYPE_5AhG3
+        #define SoC_EKF_R0_microOhms  1200 //cell ohmic resistance
+        #define SoC_EKF_R1_microOhms   800 //cell polarization resistance
+        #define SoC_EKF_TAU_ms       20000 //polarization time constant
+        #define SoC_EKF_Q_SoC            2 //process noise added to SoC variance each update  //units: centiPercent^2
+    #elif defined BATTERY_TYPE_47AhFoMoCo
+        #define SoC_EKF_R0_microOhms   600
+        #define SoC_EKF_R1_microOhms   400
+        #define SoC_EKF_TAU_ms       40000
+        #define SoC_EKF_Q_SoC            1
+    #endif
+
+    #define SoC_EKF_Q_VRC            4 //process noise added to V_RC variance each update //units: counts^2 (4 = 0.2 mV sigma)
+    #define SoC_EKF_R_VCELL      20000 //measurement noise (mostly OCV table & model error) //units: counts^2 (20000 = 14 mV sigma)
+
+    //All covariance terms are clamped to these values, which prevents int32 overflow (see SoC_EKF.cpp)
+    #define SoC_EKF_P_SoC_MAX   400000 //SoC variance //units: centiPercent^2 (400000 = 6.3% sigma)
+    #define SoC_EKF_P_VRC_MAX    40000 //V_RC variance //units: counts^2 (40000 = 20 mV sigma)
+    #define SoC_EKF_P_CROSS_MAX 126000 //sqrt(SoC_EKF_P_SoC_MAX * SoC_EKF_P_VRC_MAX)
+
+    #define SoC_EKF_P_SoC_AFTER_OCV  40000 //SoC variance immediately after resting voltage SoC estimate (2% sigma)
+
+    #define SoC_EKF_MAX_CORRECTION_centiPercent 200 //limits how far a single measurement can move SoC
+
+#endif
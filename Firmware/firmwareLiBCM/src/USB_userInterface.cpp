@@ -26,6 +26,17 @@ void printDebug(void)
 
     Serial.print(F("\n -Has LiBCM limited regen since last cleared?: "));
     (eeprom_hasLibcmDisabledRegen_get() == EEPROM_LIBCM_DISABLED_REGEN) ? Serial.print(F("YES")) : Serial.print(F("NO"));
+
+    Serial.print(F("\n -EEPROM bytes written since boot: "));
+    Serial.print(eeprom_bytesWritten_get());
+    Serial.print(F(", skipped (unchanged) "));
+    Serial.print(eeprom_bytesSkipped_get());
+    Serial.print(F(", coalesced "));
+    Serial.print(eeprom_bytesCoalesced_get());
+    Serial.print(F(", max queued "));
+    Serial.print(eeprom_queueHighWater_get());
+    Serial.print(F(", CPU blocked us "));
+    Serial.print(eeprom_blockedTime_us_get());
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -87,7 +98,7 @@ void USB_userInterface_runTestCode(uint8_t testToRun)
     else if (testToRun == '9')
     {
         Serial.print(F("\nadcResult_CurrentSensor(10b): "));
-        Serial.print(analogRead(PIN_BATTCURRENT));
+        Serial.print(adc_getLatest_counts(PIN_BATTCURRENT));
         adc_calibrateBatteryCurrentSensorOffset();
     }
 
@@ -141,7 +152,14 @@ void printHelp(void)
         "\n -'$DEBUG': info stored in EEPROM. 'DEBUG=CLR' to restore defaults"
         "\n -'$KEYms': delay after keyON before LiBCM starts. 'KEYms=___' to set (0 to 254 ms)"
         "\n -'$SoC': battery charge in percent. 'SoC=___' to set (0 to 100%)"
-        "\n -'$DISP=PWR'/SCI/CELL/TEMP/DBG/OFF: data to stream (power/BAT&METSCI/Vcell/temperature/none)"
+        "\n -'$BAL': lifetime time each cell has balanced. 'BAL=CLR' to clear"
+        "\n -'$BUS': BATTSCI/METSCI/LiDisplay error counts & frame timing (this drive & previous drive)"
+        "\n -'$FREC': signals recorded before latest fault (saved to EEPROM). '$FREC=NOW' to save latest seconds"
+        "\n -'$RESETS': cause & last running task of latest resets (saved to EEPROM)"
+        "\n -'$MEM': RAM used by .data/.bss/heap/stack, and smallest free RAM since boot"
+        "\n -'$GET': list tunable parameters (stored in EEPROM). '$GET=NAME' to show one"
+        "\n -'$SET=NAME=___': change tunable parameter. '$SET=DEFAULTS' to restore config.h values"
+        "\n -'$DISP=PWR'/SCI/CELL/TEMP/DBG/BIN/OFF: data to stream (power/BAT&METSCI/Vcell/temperature/debug/binary/none)"
         "\n -'$RATE=___': USB updates per second (1 to 255 Hz)"
         "\n -'$LOOP: LiBCM loop period. '$LOOP=___' to set (1 to 255 ms)"
         "\n -'$SCIms': period between BATTSCI frames. '$SCIms=___' to set (0 to 255 ms)"
@@ -157,9 +175,6 @@ void printHelp(void)
         "\n -'$REGEN_OFF' disable regen until LiBCM resets."
         "\n -'$REGEN_ON' enable regen until LiBCM resets."
         "\n -'BATTmAh' display battery capacity in mAh.  'BATTmAh=____' to set."
-        "\n -'SoC_MAX' display max allowed SoC.  'SoC_MAX=__' to set."
-        "\n -'SoC_MIN' display min allowed SoC.  'SoC_MIN=__' to set."
-        "\n -'GRIDVMAX' display max grid charger voltage. 'GRIDVMAX=_.___' to set."
         */
         ));
     //When adding new commands, make sure to add cases to the following functions:
@@ -206,6 +221,7 @@ void USB_userInterface_executeUserInput(void)
         else if ((line[1] == 'B') && (line[2] == 'O') && (line[3] == 'O') && (line[4] == 'T'))
         {
             Serial.print(F("\nRebooting LiBCM"));
+            eeprom_waitUntilIdle(); //queued EEPROM writes are lost at reboot
             delay(50); //give serial buffer time to send
             rebootLiBCM();
         }
@@ -223,6 +239,48 @@ void USB_userInterface_executeUserInput(void)
             }
             else if (line[6] == STRING_TERMINATION_CHARACTER) { printDebug(); }
         }
+
+        //$BAL
+        else if ((line[1] == 'B') && (line[2] == 'A') && (line[3] == 'L'))
+        {
+            if ((line[4] == '=') && (line[5] == 'C') && (line[6] == 'L') && (line[7] == 'R'))
+            {
+                Serial.print(F("\nClearing balance history"));
+                cellBalance_history_reset();
+            }
+            else if (line[4] == STRING_TERMINATION_CHARACTER) { cellBalance_history_print(); }
+        }
+
+        //$BUS
+        else if ((line[1] == 'B') && (line[2] == 'U') && (line[3] == 'S'))
+        {
+            if (line[4] == STRING_TERMINATION_CHARACTER) { busStats_print(); }
+        }
+
+        //$FREC
+        else if ((line[1] == 'F') && (line[2] == 'R') && (line[3] == 'E') && (line[4] == 'C'))
+        {
+            if ((line[5] == '=') && (line[6] == 'N') && (line[7] == 'O') && (line[8] == 'W')) { flightRecorder_trigger(FLIGHTREC_TRIGGER_USER, 0); }
+            else if (line[5] == STRING_TERMINATION_CHARACTER) { flightRecorder_printSaved(); }
+        }
+
+        //$RESETS
+        else if ((line[1] == 'R') && (line[2] == 'E') && (line[3] == 'S') && (line[4] == 'E') && (line[5] == 'T') && (line[6] == 'S'))
+        {
+            if (line[7] == STRING_TERMINATION_CHARACTER) { resetLog_printHistory(); }
+        }
+
+        //$MEM
+        else if ((line[1] == 'M') && (line[2] == 'E') && (line[3] == 'M'))
+        {
+            if (line[4] == STRING_TERMINATION_CHARACTER) { ramMonitor_print(); }
+        }
+
+        //$SET
+        else if ((line[1] == 'S') && (line[2] == 'E') && (line[3] == 'T')) { params_handleUserSet(&line[4]); }
+
+        //$GET
+        else if ((line[1] == 'G') && (line[2] == 'E') && (line[3] == 'T')) { params_handleUserGet(&line[4]); }
 /*
         //$LIDISP //TOTO_Natalya: Move to '$TEST' //JTS2doLater: Delete if no longer used
         else if ((line[1] == 'L') && (line[2] == 'I') && (line[3] == 'D') && (line[4] == 'I') && (line[5] == 'S') && (line[6] == 'P'))
@@ -261,6 +319,16 @@ void USB_userInterface_executeUserInput(void)
             {
                 Serial.print(F("\nBattery SoC is (%): "));
                 Serial.print(SoC_getBatteryStateNow_percent(),DEC);
+                Serial.print(F(" +/- "));
+                Serial.print(SoC_EKF_uncertainty_percent_get(),DEC);
+                Serial.print(F("\nLearned capacity (mAh): "));
+                Serial.print(SoC_getStackFullCapacity_mAh(),DEC);
+                Serial.print(F("\nSoC valid after (ms): "));
+                Serial.print(SoC_bootToValid_ms_get(),DEC);
+                Serial.print(F("\nSoC snapshots saved (this boot/total): "));
+                Serial.print(eeprom_SoCsnapshot_savesSinceBoot_get(),DEC);
+                Serial.print('/');
+                Serial.print(eeprom_SoCsnapshot_savesTotal_get(),DEC);
             }
         }
 
@@ -274,6 +342,7 @@ void USB_userInterface_executeUserInput(void)
             else if ((line[6] == 'O') && (line[7] == 'F') && (line[8] == 'F')) { debugUSB_dataTypeToStream_set(DEBUGUSB_STREAM_NONE);       }
             else if ((line[6] == 'T') && (line[7] == 'E') && (line[8] == 'M')) { debugUSB_dataTypeToStream_set(DEBUGUSB_STREAM_TEMP);       }
             else if ((line[6] == 'D') && (line[7] == 'B') && (line[8] == 'G')) { debugUSB_dataTypeToStream_set(DEBUGUSB_STREAM_DEBUG);      }
+            else if ((line[6] == 'B') && (line[7] == 'I') && (line[8] == 'N')) { debugUSB_dataTypeToStream_set(DEBUGUSB_STREAM_BINARY);     }
         }
 
         //RATE
@@ -310,6 +379,7 @@ void USB_userInterface_executeUserInput(void)
             {
                 Serial.print(F("\nBATTSCI period is (ms): "));
                 Serial.print(BATTSCI_framePeriod_ms_get(),DEC);
+                BATTSCI_printJitterHistogram();
             }
         }
 
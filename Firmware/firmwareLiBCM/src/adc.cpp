@@ -2,12 +2,38 @@
 //github.com/doppelhub/Honda_Insight_LiBCM
 
 //handles all ADC calls
-//JTS2doLater: Remove Arduino functions
-//JTS2doLater: use interrupts, so ADC calls don't block execution (each conversion takes ~112 us)
+//The ADC continuously scans every analog input in the background (ADC complete interrupt).
+//Callers read the cached results, so they never wait for a conversion (each conversion takes ~104 us).
 
 #include "libcm.h"
 
-int8_t calibratedCurrentSensorOffset = 0; //calibrated when current is known to be zero (e.g. each time after key turns off)
+//ADC channel for each slot //channels 8 to 15 require MUX5
+const uint8_t adcSlotChannel[ADC_NUM_SLOTS] PROGMEM = {
+    PIN_BATTCURRENT - A0,
+    PIN_USER_SW     - A0,
+    PIN_VPIN_IN     - A0,
+    PIN_TEMP_YEL    - A0,
+    PIN_TEMP_GRN    - A0,
+    PIN_TEMP_WHT    - A0,
+    PIN_TEMP_BLU    - A0,
+    PIN_TEMP_BAY1   - A0,
+    PIN_TEMP_BAY2   - A0,
+    PIN_TEMP_BAY3   - A0
+};
+
+volatile uint16_t adcLatest_counts[ADC_NUM_SLOTS] = {0};
+volatile uint16_t adcAverage_counts_x16[ADC_NUM_SLOTS] = {0}; //scaled by 2^ADC_AVERAGE_SHIFT
+
+volatile uint8_t adcScanSlot = 0; //slot being converted now
+volatile bool adcIsResultValid = NO; //first conversion after channel change is discarded
+volatile uint8_t adcScansCompleted = 0;
+
+volatile uint16_t adcBattCurrent_counts12b = 0;
+volatile uint16_t adcBattCurrentAverage_counts12b_x16 = 0; //scaled by 2^ADC_AVERAGE_SHIFT //max 4092*16 fits in uint16_t
+uint16_t adcOversampleSum = 0; //only accessed in ISR (and adc_begin before ISR is enabled)
+uint8_t adcOversampleCount = 0;
+
+int16_t calibratedCurrentSensorOffset_counts12b = 0; //calibrated when current is known to be zero (e.g. each time after key turns off)
 
 int16_t battCurrent_deciAmps = 0;
 int16_t spoofedCurrent_deciAmps = 0;
@@ -33,7 +59,7 @@ uint8_t adc_packVoltage_VpinIn(void) //returns pack voltage (in volts)
           //packVoltage_VpinIn  =              adc_VPIN_raw() * 260 / 1024
           //packVoltage_VpinIn ~=              adc_VPIN_raw() /  4        + 3 //approximately equal between 120VDC and 250VDC
           //packVoltage_VpinIn ~=              adc_VPIN_raw() >> 2        + 3
-    uint8_t packVoltage_VpinIn  = (uint8_t)(analogRead(PIN_VPIN_IN) >> 2) + 3;
+    uint8_t packVoltage_VpinIn  = (uint8_t)(adc_getLatest_counts(PIN_VPIN_IN) >> 2) + 3;
 
     return packVoltage_VpinIn; //pack voltage in volts
 } 
@@ -41,34 +67,33 @@ uint8_t adc_packVoltage_VpinIn(void) //returns pack voltage (in volts)
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //sample battery current and update in deciAmps
-//Returned current value is not accurate enough for coulomb counting (use "SoC_integrateCharge_adcCounts" for that)
+//Returned current value is not accurate enough for coulomb counting (use "SoC_integrateCharge_adcCounts12b" for that)
 void sampleAndProcessBatteryCurrent(void)
 {
     //Regardless of I2V resistance value, 0A (no regen or assist) is ~332 counts (~1.62 volts when VREF is 5V)
     //Actual VCC voltage doesn't matter, since ADC reference is also VCC (the two values are ratiometric)
     //ADC counts increase as assist current increases //1023 counts is maximum assist //0 counts is maximum regen
 
-    uint16_t battCurrent_countsRAW = analogRead(PIN_BATTCURRENT);
-    uint16_t battCurrent_counts;
+    //12b result (4x 10b result) //1 count is ~54 mA
+    int16_t battCurrent_countsRAW = adc_getBatteryCurrent_counts12b();
+    int16_t battCurrent_counts = battCurrent_countsRAW + calibratedCurrentSensorOffset_counts12b;
 
     //bound adc result
-    if      ( (calibratedCurrentSensorOffset > 0)                            &&
-            (battCurrent_countsRAW > (1023 - calibratedCurrentSensorOffset))  ) { battCurrent_counts = 1023; } //prevent values greater than 2^10-1
-    else if ( (calibratedCurrentSensorOffset < 0)                            &&
-            (battCurrent_countsRAW < (   0 - calibratedCurrentSensorOffset))  ) { battCurrent_counts = 0; } //prevent wraparound
-    else /* result will be between 0 & 1023 */                                  { battCurrent_counts = battCurrent_countsRAW + calibratedCurrentSensorOffset; }
+    if      (battCurrent_counts > ADC_MAX_COUNTS_12b) { battCurrent_counts = ADC_MAX_COUNTS_12b; }
+    else if (battCurrent_counts < 0)                  { battCurrent_counts = 0;                  }
 
-    SoC_integrateCharge_adcCounts(battCurrent_counts);
+    SoC_integrateCharge_adcCounts12b(battCurrent_counts);
 
-    //convert current sensor's 10b adc result to deciAmps
+    //convert current sensor's 12b adc result to deciAmps
     //see "RevC/V&V/OEM Current Sensor.ods" for measured results
     //see SPICE simulation for complete derivation
-    constexpr uint8_t SCALAR_HIGH_ASSIST = 35; //prevents uint16 overflow during heavy assist (max assist is 1023 adc counts) 
-    constexpr uint8_t SCALAR_OTHERWISE   = 69; //more accurate during regen and light assist, but overflows at very high assist current
-    constexpr uint16_t MAX_COUNTS_NO_OVERFLOW = 65535/SCALAR_OTHERWISE; //uint16_t transition point //adc results above this value will overflow 
+    //each scalar is shifted two extra bits (compared to 10b result)
+    constexpr uint8_t SCALAR_HIGH_ASSIST = 35; //measured fit during heavy assist
+    constexpr uint8_t SCALAR_OTHERWISE   = 69; //more accurate during regen and light assist
+    constexpr uint16_t TRANSITION_COUNTS = (65535/SCALAR_OTHERWISE) << ADC_OVERSAMPLE_EXTRA_BITS; //same transition point as original 10b fit
 
-    if (battCurrent_counts < MAX_COUNTS_NO_OVERFLOW) { battCurrent_deciAmps = (int16_t)((battCurrent_counts * SCALAR_OTHERWISE  ) >> 5) - 715; } //200 mA uncertainty
-    else                                             { battCurrent_deciAmps = (int16_t)((battCurrent_counts * SCALAR_HIGH_ASSIST) >> 4) - 741; } //300 mA uncertainty
+    if (battCurrent_counts < TRANSITION_COUNTS) { battCurrent_deciAmps = (int16_t)(((uint32_t)battCurrent_counts * SCALAR_OTHERWISE  ) >> 7) - 715; } //200 mA uncertainty
+    else                                        { battCurrent_deciAmps = (int16_t)(((uint32_t)battCurrent_counts * SCALAR_HIGH_ASSIST) >> 6) - 741; } //300 mA uncertainty
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -100,17 +125,17 @@ void adc_updateBatteryCurrent(void)
 //MCM closes main contactor ~330 ms after keyOn
 void adc_calibrateBatteryCurrentSensorOffset(void)
 {
-    uint16_t adcResult = analogRead(PIN_BATTCURRENT);
+    uint16_t adcResult = adc_getBatteryCurrentAverage_counts12b(); //no current flowing, so average filters noise
 
-    int8_t delta = ADC_NOMINAL_0A_COUNTS - adcResult;
+    int16_t delta = ADC_NOMINAL_0A_COUNTS_12b - adcResult;
 
-    Serial.print(F("\nADC 0A offset: "));
+    Serial.print(F("\nADC 0A offset (12b): "));
     Serial.print(delta);
 
-    //verify returned value is in the right ballpark
-    if ((delta > -10) && (delta < +10)) 
+    //verify returned value is in the right ballpark (+/- 10 counts @ 10b)
+    if ((delta > -(10 << ADC_OVERSAMPLE_EXTRA_BITS)) && (delta < (10 << ADC_OVERSAMPLE_EXTRA_BITS)))
     {
-        calibratedCurrentSensorOffset = delta;
+        calibratedCurrentSensorOffset_counts12b = delta;
         Serial.print(F(" (pass)"));
     } 
     else { Serial.print(F(" (fail)")); }
@@ -118,6 +143,175 @@ void adc_calibrateBatteryCurrentSensorOffset(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint16_t adc_getTemperature(uint8_t tempToMeasure) { return analogRead(tempToMeasure); }
+uint16_t adc_getTemperature(uint8_t tempToMeasure) { return adc_getLatest_counts(tempToMeasure); } //average lags sensor powerup
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t adc_pinToSlot(uint8_t pin)
+{
+    switch (pin)
+    {
+        case PIN_BATTCURRENT: return ADC_SLOT_BATTCURRENT;
+        case PIN_USER_SW:     return ADC_SLOT_USER_SW;
+        case PIN_VPIN_IN:     return ADC_SLOT_VPIN_IN;
+        case PIN_TEMP_YEL:    return ADC_SLOT_TEMP_YEL;
+        case PIN_TEMP_GRN:    return ADC_SLOT_TEMP_GRN;
+        case PIN_TEMP_WHT:    return ADC_SLOT_TEMP_WHT;
+        case PIN_TEMP_BLU:    return ADC_SLOT_TEMP_BLU;
+        case PIN_TEMP_BAY1:   return ADC_SLOT_TEMP_BAY1;
+        case PIN_TEMP_BAY2:   return ADC_SLOT_TEMP_BAY2;
+        case PIN_TEMP_BAY3:   return ADC_SLOT_TEMP_BAY3;
+        default:              return ADC_SLOT_INVALID;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns 0 if pin isn't in scan list
+uint16_t adc_getLatest_counts(uint8_t pin)
+{
+    uint8_t slot = adc_pinToSlot(pin);
+    if (slot == ADC_SLOT_INVALID) { return 0; }
+
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    uint16_t counts = adcLatest_counts[slot];
+    SREG = oldSREG;
+
+    return counts;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns 0 if pin isn't in scan list
+uint16_t adc_getAverage_counts(uint8_t pin)
+{
+    uint8_t slot = adc_pinToSlot(pin);
+    if (slot == ADC_SLOT_INVALID) { return 0; }
+
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    uint16_t counts_x16 = adcAverage_counts_x16[slot];
+    SREG = oldSREG;
+
+    return (counts_x16 + (1 << (ADC_AVERAGE_SHIFT - 1))) >> ADC_AVERAGE_SHIFT; //rounded
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t adc_getBatteryCurrent_counts12b(void)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    uint16_t counts = adcBattCurrent_counts12b;
+    SREG = oldSREG;
+
+    return counts;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t adc_getBatteryCurrentAverage_counts12b(void)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    uint16_t counts_x16 = adcBattCurrentAverage_counts12b_x16;
+    SREG = oldSREG;
+
+    return (uint16_t)((counts_x16 + (1UL << (ADC_AVERAGE_SHIFT - 1))) >> ADC_AVERAGE_SHIFT); //rounded //32b prevents overflow
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST only be called when no conversion is in progress
+void adc_selectChannel(uint8_t channel)
+{
+    ADMUX = (channel & 0x07); //REFS = 0b00: external AREF (5V coupled to filtered VCC) //right adjusted result
+
+    if (channel & 0x08) { ADCSRB |=  (1 << MUX5); } //channels 8 to 15
+    else                { ADCSRB &= ~(1 << MUX5); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void adc_begin(void)
+{
+    ADCSRA = 0; //disable ADC while configuring
+    ADCSRB = 0; //free running trigger source unused (each conversion is started in ISR)
+
+    //disable digital input buffers on scanned pins (saves power, reduces noise)
+    for (uint8_t slot = 0; slot < ADC_NUM_SLOTS; slot++)
+    {
+        uint8_t channel = pgm_read_byte(&adcSlotChannel[slot]);
+        if (channel < 8) { DIDR0 |= (1 << channel);       }
+        else             { DIDR2 |= (1 << (channel - 8)); }
+    }
+
+    adcScanSlot = 0;
+    adcIsResultValid = NO;
+    adcScansCompleted = 0;
+    adcOversampleSum = 0;
+    adcOversampleCount = 0;
+    adc_selectChannel(pgm_read_byte(&adcSlotChannel[0]));
+
+    //ADC clock = 16 MHz / 128 = 125 kHz //13 ADC clocks per conversion
+    ADCSRA = (1 << ADEN) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0) | (1 << ADSC);
+
+    //wait for first scan, so every slot has a valid result before anything reads it (~4 ms)
+    uint32_t startTime_ms = millis();
+    while ((adcScansCompleted == 0) && ((millis() - startTime_ms) < 10)) { ; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//sums ADC_OVERSAMPLE_COUNT current sensor conversions, then decimates sum to 12b
+//returns YES when oversampled result is ready //result is then replaced with decimated 10b value
+bool adc_oversampleBatteryCurrent(uint16_t * result)
+{
+    adcOversampleSum += *result;
+    if (++adcOversampleCount < ADC_OVERSAMPLE_COUNT) { return NO; } //same channel, so next conversion doesn't need to be discarded
+
+    uint16_t result_counts12b = (adcOversampleSum + (1 << (ADC_OVERSAMPLE_EXTRA_BITS - 1))) >> ADC_OVERSAMPLE_EXTRA_BITS; //sum of 16 is 14b //discard 2 LSBs (rounded)
+    adcOversampleSum = 0;
+    adcOversampleCount = 0;
+
+    adcBattCurrent_counts12b = result_counts12b;
+
+    if (adcScansCompleted == 0) { adcBattCurrentAverage_counts12b_x16 = result_counts12b << ADC_AVERAGE_SHIFT; } //seed average
+    else { adcBattCurrentAverage_counts12b_x16 += result_counts12b - (adcBattCurrentAverage_counts12b_x16 >> ADC_AVERAGE_SHIFT); }
+
+    *result = result_counts12b >> ADC_OVERSAMPLE_EXTRA_BITS; //10b result (for adc_getLatest_counts() & adc_getAverage_counts())
+
+    return YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//each conversion starts the next one
+ISR(ADC_vect)
+{
+    uint16_t result = ADC;
+
+    if (adcIsResultValid == NO) { adcIsResultValid = YES; } //discard first conversion after channel change
+    else if ( (adcScanSlot == ADC_SLOT_BATTCURRENT) && (adc_oversampleBatteryCurrent(&result) == NO) ) { ; } //keep sampling current
+    else
+    {
+        adcLatest_counts[adcScanSlot] = result;
+
+        if (adcScansCompleted == 0) { adcAverage_counts_x16[adcScanSlot] = result << ADC_AVERAGE_SHIFT; } //seed average
+        else { adcAverage_counts_x16[adcScanSlot] += result - (adcAverage_counts_x16[adcScanSlot] >> ADC_AVERAGE_SHIFT); }
+
+        if (++adcScanSlot >= ADC_NUM_SLOTS)
+        {
+            adcScanSlot = 0;
+            if (adcScansCompleted < 0xFF) { adcScansCompleted++; }
+        }
+
+        adc_selectChannel(pgm_read_byte(&adcSlotChannel[adcScanSlot]));
+        adcIsResultValid = NO;
+    }
+
+    ADCSRA |= (1 << ADSC); //start next conversion
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -18,21 +18,38 @@
 
     void adc_calibrateBatteryCurrentSensorOffset(void);
 
+    void adc_begin(void); //MUST run after gpio_begin()
+
+    uint16_t adc_getLatest_counts(uint8_t pin);  //constant time //most recent background conversion
+    uint16_t adc_getAverage_counts(uint8_t pin); //constant time //moving average of recent conversions
+
+    uint16_t adc_getBatteryCurrent_counts12b(void);        //oversampled current sensor result
+    uint16_t adc_getBatteryCurrentAverage_counts12b(void); //moving average of oversampled results
+
     #define ADC_NOMINAL_0A_COUNTS 332 //calculated ADC 10b result when no current flows through sensor
     #define ADC_MILLIAMPS_PER_COUNT 215 //Derivation here: ~/Electronics/PCB (KiCAD)/RevC/V&V/OEM Current Sensor.ods
 
-#endif
+    //current sensor is oversampled to increase resolution (requires ~1 LSB noise on signal, which sensor has)
+    //each additional bit requires 4x more conversions
+    #define ADC_OVERSAMPLE_EXTRA_BITS 2
+    #define ADC_OVERSAMPLE_COUNT (1 << (2 * ADC_OVERSAMPLE_EXTRA_BITS)) //16 conversions //sum MUST fit in uint16_t
+    #define ADC_NOMINAL_0A_COUNTS_12b (ADC_NOMINAL_0A_COUNTS << ADC_OVERSAMPLE_EXTRA_BITS)
+    #define ADC_MAX_COUNTS_12b (1023 << ADC_OVERSAMPLE_EXTRA_BITS)
+
+    //background scan list //each slot is converted twice per scan (first result after MUX change is discarded)
+    #define ADC_SLOT_BATTCURRENT 0
+    #define ADC_SLOT_USER_SW     1
+    #define ADC_SLOT_VPIN_IN     2
+    #define ADC_SLOT_TEMP_YEL    3
+    #define ADC_SLOT_TEMP_GRN    4
+    #define ADC_SLOT_TEMP_WHT    5
+    #define ADC_SLOT_TEMP_BLU    6
+    #define ADC_SLOT_TEMP_BAY1   7
+    #define ADC_SLOT_TEMP_BAY2   8
+    #define ADC_SLOT_TEMP_BAY3   9
+    #define ADC_NUM_SLOTS       10 //~3.6 ms per scan (35 conversions at 104 us each, including oversampled current)
+    #define ADC_SLOT_INVALID  0xFF
+
+    #define ADC_AVERAGE_SHIFT 4 //moving average of 2^n conversions (per slot)
 
-/*
-To implement later:
-
-#define ADC_DDR DDRF
-    #define ADC_DIR PORTF
-    #define ADC_CURRENT_BIT  0 //mega pin A0 PF0
-    #define ADC_TEMP_YEL_BIT 3 //mega pin A3 PF3
-    #define ADC_TEMP_GRN_BIT 4 //mega pin A4 PF4
-    #define ADC_TEMP_WHT_BIT 5 //mega pin A5 PF5
-    #define ADC_TEMP_BLU_BIT 6 //mega pin A6 PF6
-    #define ADC_VPIN_IN_BIT  7 //mega pin A7 PF7
-    #define ADC_MASK ((1<<ADC_CURRENT_BIT)|(1<<ADC_TEMP_YEL_BIT)|(1<<ADC_TEMP_GRN_BIT)|(1<<ADC_TEMP_WHT_BIT)|(1<<ADC_TEMP_BLU_BIT)|(1<<ADC_VPIN_IN_BIT))
-*/
+#endif
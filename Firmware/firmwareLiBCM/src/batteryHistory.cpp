@@ -6,10 +6,30 @@
 //Y axis: Temp
 //Z axis: uint16 value is hours spent at this Temp & SoC
 
+//previously each hour incremented one table bin in EEPROM (~3.3 ms blocking, even while driving)...
+//so a car parked at the same Temp & SoC wrote the same EEPROM byte ~8760 times per year
+//now each sample (every 6 minutes) increments an entry in RAM
+//whole hours are appended to the EEPROM journal at keyOFF, daily while keyOFF, and before LiBCM turns off
+//the journal is added to the table at keyOFF once half full (see eeprom_batteryHistory_mergeJournal())
+//typical usage (2 keyOFF events + 1 daily save per day, ~2 bins per save):
+// -each journal record is written ~35 times per year (32 records, ~1100 appends per year)
+// -each table bin is written at most ~70 times per year (one per merge)
+// -nothing is written to EEPROM while keyON (unless more than 16 bins are visited, or a bin exceeds 25 hours)
+
 #include "libcm.h"
 
 //JTS2doLater: add two similar graphs showing the cumulative Ah (both charge and discharge) at each SoC+Temperature.
 
+struct unsavedBin
+{
+    uint8_t indexTemperature;
+    uint8_t indexSoC;
+    uint8_t samples; //0 if this entry is unused
+};
+
+unsavedBin batteryHistory_unsaved[BATTERY_HISTORY_NUM_UNSAVED_BINS]; //not yet appended to EEPROM journal
+uint32_t batteryHistory_latestSave_ms = 0;
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 uint8_t calcArrayIndex_temperature(void)
@@ -48,6 +68,69 @@ uint8_t calcArrayIndex_SoC(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//appends whole hours to EEPROM journal //the remainder stays in RAM until the next save
+void batteryHistory_saveBin(uint8_t bin)
+{
+    uint8_t unsaved_hours = batteryHistory_unsaved[bin].samples / BATTERY_HISTORY_SAMPLES_PER_HOUR;
+
+    if (unsaved_hours > 0)
+    {
+        eeprom_batteryHistory_appendHours(batteryHistory_unsaved[bin].indexTemperature, batteryHistory_unsaved[bin].indexSoC, unsaved_hours);
+        batteryHistory_unsaved[bin].samples -= unsaved_hours * BATTERY_HISTORY_SAMPLES_PER_HOUR;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//called at keyOFF, daily while keyOFF, and before LiBCM turns off
+void batteryHistory_save(void)
+{
+    for (uint8_t bin = 0; bin < BATTERY_HISTORY_NUM_UNSAVED_BINS; bin++) { batteryHistory_saveBin(bin); }
+
+    batteryHistory_latestSave_ms = millis();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void batteryHistory_handleKeyOff(void)
+{
+    batteryHistory_save();
+
+    if (eeprom_batteryHistory_journalPending_get() >= BATTERY_HISTORY_MERGE_THRESHOLD) { eeprom_batteryHistory_mergeJournal(); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns entry for this Temp & SoC //reuses the entry with the fewest samples if none are available
+uint8_t batteryHistory_findBin(uint8_t indexTemperature, uint8_t indexSoC)
+{
+    uint8_t emptiestBin = 0;
+
+    for (uint8_t bin = 0; bin < BATTERY_HISTORY_NUM_UNSAVED_BINS; bin++)
+    {
+        if ((batteryHistory_unsaved[bin].samples > 0) &&
+            (batteryHistory_unsaved[bin].indexTemperature == indexTemperature) &&
+            (batteryHistory_unsaved[bin].indexSoC == indexSoC)) { return bin; }
+
+        if (batteryHistory_unsaved[bin].samples < batteryHistory_unsaved[emptiestBin].samples) { emptiestBin = bin; }
+    }
+
+    if (batteryHistory_unsaved[emptiestBin].samples > 0)
+    {
+        //all entries used //round remaining samples to nearest hour
+        batteryHistory_unsaved[emptiestBin].samples += (BATTERY_HISTORY_SAMPLES_PER_HOUR / 2);
+        batteryHistory_saveBin(emptiestBin);
+    }
+
+    batteryHistory_unsaved[emptiestBin].indexTemperature = indexTemperature;
+    batteryHistory_unsaved[emptiestBin].indexSoC = indexSoC;
+    batteryHistory_unsaved[emptiestBin].samples = 0;
+
+    return emptiestBin;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 void batteryHistory_handler(void)
 {
     static uint32_t timestamp_lastUpdate_ms = 0;
@@ -56,14 +139,31 @@ void batteryHistory_handler(void)
     { 
         timestamp_lastUpdate_ms = millis();
 
-        eeprom_batteryHistory_incrementValue(calcArrayIndex_temperature(), calcArrayIndex_SoC());
+        uint8_t bin = batteryHistory_findBin(calcArrayIndex_temperature(), calcArrayIndex_SoC());
+
+        batteryHistory_unsaved[bin].samples++;
+
+        if (batteryHistory_unsaved[bin].samples >= BATTERY_HISTORY_MAX_UNSAVED_SAMPLES) { batteryHistory_saveBin(bin); }
     }
+
+    if ( (key_getSampledState() == KEYSTATE_OFF) &&
+         ((millis() - batteryHistory_latestSave_ms) > BATTERY_HISTORY_SAVE_PERIOD_ms) ) { batteryHistory_save(); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 void batteryHistory_printAll(void)
 {
+    //pending journal records aren't in the table yet
+    uint8_t  pending_indexTemperature[BATTERY_HISTORY_JOURNAL_NUM_RECORDS];
+    uint8_t  pending_indexSoC[BATTERY_HISTORY_JOURNAL_NUM_RECORDS];
+    uint16_t pending_hours[BATTERY_HISTORY_JOURNAL_NUM_RECORDS];
+    uint8_t  numPending = 0;
+
+    for (uint8_t record = 0; record < BATTERY_HISTORY_JOURNAL_NUM_RECORDS; record++)
+    {
+        if (eeprom_batteryHistory_journalRecord_get(record, &pending_indexTemperature[numPending], &pending_indexSoC[numPending], &pending_hours[numPending]) == YES) { numPending++; }
+    }
 
     Serial.print(F("\nBattery Temperature and SoC History"
     "\n -Columns: Battery SoC (%)"
@@ -96,12 +196,34 @@ void batteryHistory_printAll(void)
         for (uint8_t stateOfChargeBin=0; stateOfChargeBin<TOTAL_SoC_BINS; stateOfChargeBin++)
         {
             Serial.print(',');
-            uint16_t valueToPrint = eeprom_batteryHistory_getValue(temperatureBin, stateOfChargeBin);
+            uint32_t valueToPrint = eeprom_batteryHistory_getValue(temperatureBin, stateOfChargeBin);
+
+            if (valueToPrint != 0xFFFF)
+            {
+                for (uint8_t ii = 0; ii < numPending; ii++)
+                {
+                    if ((pending_indexTemperature[ii] == temperatureBin) && (pending_indexSoC[ii] == stateOfChargeBin)) { valueToPrint += pending_hours[ii]; }
+                }
+
+                for (uint8_t bin = 0; bin < BATTERY_HISTORY_NUM_UNSAVED_BINS; bin++)
+                {
+                    if ((batteryHistory_unsaved[bin].indexTemperature == temperatureBin) && (batteryHistory_unsaved[bin].indexSoC == stateOfChargeBin))
+                    {
+                        valueToPrint += batteryHistory_unsaved[bin].samples / BATTERY_HISTORY_SAMPLES_PER_HOUR;
+                    }
+                }
+
+                if (valueToPrint > BATTERY_HISTORY_MAX_HOURS) { valueToPrint = BATTERY_HISTORY_MAX_HOURS; }
+            }
+
             Serial.print(valueToPrint);      
         }
     }
 
-
+    Serial.print(F("\nJournal records pending: "));
+    Serial.print(numPending);
+    Serial.print(F(", appended since boot: "));
+    Serial.print(eeprom_batteryHistory_appendsSinceBoot_get());
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
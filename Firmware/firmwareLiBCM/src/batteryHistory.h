@@ -4,7 +4,12 @@
 #ifndef batteryHistory_h
     #define batteryHistory_h
 
-    #define BATTERY_HISTORY_UPDATE_PERIOD_ms MILLISECONDS_PER_HOUR
+    #define BATTERY_HISTORY_SAMPLES_PER_HOUR 10 //each sample is 6 minutes
+    #define BATTERY_HISTORY_UPDATE_PERIOD_ms (MILLISECONDS_PER_HOUR / BATTERY_HISTORY_SAMPLES_PER_HOUR)
+    #define BATTERY_HISTORY_MAX_UNSAVED_SAMPLES 250 //uint8 //entry is saved when it reaches this value (25 hours)
+    #define BATTERY_HISTORY_NUM_UNSAVED_BINS 16 //distinct Temp+SoC bins accumulated in RAM between saves
+    #define BATTERY_HISTORY_SAVE_PERIOD_ms (24 * MILLISECONDS_PER_HOUR) //max time between saves while keyOFF
+    #define BATTERY_HISTORY_MERGE_THRESHOLD (BATTERY_HISTORY_JOURNAL_NUM_RECORDS / 2) //merge journal at keyOFF if this many records are pending
 
     #define TEMP_BIN_WIDTH_DEGC          4 //must be 2^n //e.g. -26 to -23, -22 d to -19, etc
     #define TEMP_BIN_WIDTH_RIGHTSHIFTS   2 //must match above (DEGC = 2^RIGHTSHIFTS)
@@ -28,5 +33,8 @@
     void batteryHistory_printAll(void);
 
     void batteryHistory_handler(void);
+
+    void batteryHistory_save(void);
+    void batteryHistory_handleKeyOff(void);
     
 #endif
@@ -8,7 +8,13 @@
 /************************************************************************************************************************
  * The BCM constantly sends two different 12 Byte frames to the MCM.
  *
- * frame syntax is documented in function "BATTSCI_sendFrames"
+ * frame syntax is documented in functions "BATTSCI_buildFrame87" & "BATTSCI_buildFrameAA"
+ *
+ * Frames are built in the main loop, then sent by interrupts at an exact cadence (independent of loop timing):
+ * -Timer2 interrupts every millisecond.  Every 'framePeriod_ms', the next frame is handed to USART2.
+ * -USART2 data register empty interrupt then sends each byte.
+ * Each frame type is double buffered.  The main loop rebuilds a frame type each time the ISR starts sending it.
+ * Serial2 MUST NOT be used anywhere (Arduino's Serial2 interrupts would conflict with LiBCM's)
  ************************************************************************************************************************/
 
 #include "libcm.h"
@@ -16,15 +22,29 @@
 uint8_t spoofedVoltageToSend_Counts = 0; //formatted as MCM expects to see it (Vpack / 2) //2 volts per count
 int16_t spoofedCurrentToSend_Counts = 0; //formatted as MCM expects to see it (2048 - deciAmps * 2) //50 mA per count
 
-uint8_t framePeriod_ms = 33;
+volatile uint8_t framePeriod_ms = 33;
+
+//triple buffer //main loop builds the idle buffer while the ISR sends another, and the third holds the latest published frame
+uint8_t BATTSCI_frames[2][BATTSCI_NUM_BUFFERS][BATTSCI_BYTES_IN_FRAME]; //[frame type][buffer][byte]
+volatile uint8_t BATTSCI_bufferToSend[2] = {0, 0};    //for each frame type, the buffer the ISR sends next (latest published)
+volatile uint8_t BATTSCI_bufferSending[2] = {0, 0};   //for each frame type, the buffer the ISR sent most recently (might still be sending)
+volatile bool    BATTSCI_isFrameStale[2] = {YES, YES}; //ISR sent this frame type since it was last published (SoC hysteresis steps once per sent frame)
+volatile bool    BATTSCI_isTransmitEnabled = NO;
+
+//only accessed in ISRs
+const uint8_t *txFrame = BATTSCI_frames[0][0];
+uint8_t txIndex = 0;
+
+//frame period jitter (actual period minus nominal period)
+volatile uint16_t BATTSCI_jitterHistogram[BATTSCI_JITTER_HISTOGRAM_BINS] = {0};
 
 //JTS2doLater: Add different SoC profile for "charges every day" crew
-//JTS2doLater: store in 'PROGMEM' to keep out of RAM (but note array elements must be indexed differently)
 //LUT remaps actual lithium battery SoC (unit: percent) to mimic OEM NiMH behavior (unit: deciPercent)
 //input: actual lithium SoC (unit: percent integer)
 //output: OEM NiMH SoC equivalent (unit: decipercent integer)
-//Example: if the actual lithium SoC is 85%, then "remap_actualToSpoofedSoC[85]" will return 799d (79.9%), which is the value to send on BATTSCI
-const uint16_t remap_actualToSpoofedSoC[101] = {
+//Example: if the actual lithium SoC is 85%, then "BATTSCI_remapActualToSpoofedSoC(85)" will return 799d (79.9%), which is the value to send on BATTSCI
+//stored in flash (PROGMEM) //MUST read with pgm_read_word()
+const uint16_t remap_actualToSpoofedSoC[101] PROGMEM = {
       0, 22, 44, 67, 89,111,133,156,178,190, //LiCBM SoC = 00% to 09%
     200,209,217,225,232,240,248,256,264,272, //LiCBM SoC = 10% to 19%
     279,287,295,303,311,319,326,334,342,350, //LiCBM SoC = 20% to 29% //MCM enables heavy regen below 350 (35.0%)
@@ -38,7 +58,9 @@ const uint16_t remap_actualToSpoofedSoC[101] = {
     1000,                                    //LiCBM SoC = 100%
 };  //Data empirically gathered from OEM NiMH IMA system //see ../Firmware/Prototype Building Blocks/Remap SoC.ods for calculations
 
-uint16_t previousOutputSoC_deciPercent = remap_actualToSpoofedSoC[SoC_getBatteryStateNow_percent()];
+uint16_t BATTSCI_remapActualToSpoofedSoC(uint8_t SoC_percent) { return pgm_read_word(&remap_actualToSpoofedSoC[SoC_percent]); }
+
+uint16_t previousOutputSoC_deciPercent = BATTSCI_remapActualToSpoofedSoC(SoC_getBatteryStateNow_percent());
 
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -51,14 +73,25 @@ void BATTSCI_begin(void)
   pinMode(PIN_BATTSCI_REn, OUTPUT);
   digitalWrite(PIN_BATTSCI_REn,HIGH);
 
-  Serial2.begin(9600,SERIAL_8E1);
+  //USART2: 9600 baud, 8 data bits, even parity, 1 stop bit
+  UCSR2A = (1 << U2X2); //double speed mode (lower baud rate error)
+  UBRR2H = highByte(BATTSCI_UBRR_VALUE);
+  UBRR2L =  lowByte(BATTSCI_UBRR_VALUE);
+  UCSR2C = (1 << UPM21) | (1 << UCSZ21) | (1 << UCSZ20);
+  UCSR2B = (1 << TXEN2);
+
+  //Timer2: 1 kHz interrupt (16 MHz / 128 / 125)
+  TCCR2A = (1 << WGM21); //CTC mode
+  TCCR2B = (1 << CS22) | (1 << CS20); //prescaler = 128
+  OCR2A  = 124;
+  TIMSK2 = (1 << OCIE2A);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 void BATTSCI_enable(void) {
-    digitalWrite(PIN_BATTSCI_DE,HIGH);
-    previousOutputSoC_deciPercent = remap_actualToSpoofedSoC[SoC_getBatteryStateNow_percent()]; // If user grid charged over night SoC may have changed a lot.
+    gpio_fastWrite(PIN_BATTSCI_DE, HIGH);
+    previousOutputSoC_deciPercent = BATTSCI_remapActualToSpoofedSoC(SoC_getBatteryStateNow_percent()); // If user grid charged over night SoC may have changed a lot.
     
     //JTS: Don't want to overload serial buffer on cold boot (will cause check engine light)
     //Serial.print(F("\nLiBCM SoC: "));
@@ -68,24 +101,22 @@ void BATTSCI_enable(void) {
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void BATTSCI_disable(void) { digitalWrite(PIN_BATTSCI_DE,LOW); }
-
-/////////////////////////////////////////////////////////////////////////////////////////
-
-uint8_t BATTSCI_bytesAvailableForWrite(void) { return Serial2.availableForWrite(); }
+void BATTSCI_disable(void)
+{
+    BATTSCI_isTransmitEnabled = NO;
+    BATTSCI_isFrameStale[BATTSCI_FRAME_87] = YES; //MCM throws CEL if old data sent when key first turned on
+    BATTSCI_isFrameStale[BATTSCI_FRAME_AA] = YES;
+    gpio_fastWrite(PIN_BATTSCI_DE, LOW);
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//only used when frames aren't being sent (e.g. BringupTester loopback test)
 uint8_t BATTSCI_writeByte(uint8_t data)
 {
-    Serial2.write(data);
-    if (debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BATTMETSCI)
-    {
-        if (data < 0x10) { Serial.print('0'); } //print leading zero for single digit hex
-        Serial.print(data,HEX);
-        Serial.print(',');
-    }
-    
+    while ( !(UCSR2A & (1 << UDRE2)) ) { ; } //wait for previous byte to start sending
+    UDR2 = data;
+
     return data;
 }
 
@@ -96,6 +127,10 @@ uint8_t BATTSCI_framePeriod_ms_get(void) { return framePeriod_ms; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+uint16_t BATTSCI_SoC_deciPercent_get(void) { return previousOutputSoC_deciPercent; } //latest SoC sent to MCM
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 //Convert battery voltage (unit: volts) into BATTSCI format (unit: 2 volts per count)
 void BATTSCI_setPackVoltage(uint8_t spoofedVoltage) { spoofedVoltageToSend_Counts = (spoofedVoltage >> 1); }
 
@@ -152,8 +187,8 @@ int16_t cellVoltageOffsetDueToESR(void)
 //JTS2doLater: Add five second timeout
 bool BATTSCI_isPackFull(void)
 {
-    if ((LTC68042result_hiCellVoltage_get() < CELL_VMAX_REGEN) && //below maximum cell voltage limit (if SoC estimator is wrong)
-        (  SoC_getBatteryStateNow_percent() < STACK_SoC_MAX  )  ) //below maximum SoC limit
+    if ((LTC68042result_hiCellVoltage_get() < params_get(PARAM_CELL_VMAX_REGEN)) && //below maximum cell voltage limit (if SoC estimator is wrong)
+        (  SoC_getBatteryStateNow_percent() < params_get(PARAM_STACK_SoC_MAX)    )  ) //below maximum SoC limit
          { return NO;  } //pack is good
     else { return YES; } //pack is overcharged
 }
@@ -162,8 +197,8 @@ bool BATTSCI_isPackFull(void)
 
 bool BATTSCI_isPackEmpty(void)
 {
-    if ((LTC68042result_loCellVoltage_get() > CELL_VMIN_ASSIST) && //above minimum cell voltage limit (if SoC estimator is wrong))
-        (  SoC_getBatteryStateNow_percent() > STACK_SoC_MIN   )  ) //above minimum SoC limit
+    if ((LTC68042result_loCellVoltage_get() > params_get(PARAM_CELL_VMIN_ASSIST)) && //above minimum cell voltage limit (if SoC estimator is wrong))
+        (  SoC_getBatteryStateNow_percent() > params_get(PARAM_STACK_SoC_MIN)     )  ) //above minimum SoC limit
          { return NO;  } //pack is good
     else { return YES; } //pack is undercharged
 }
@@ -311,7 +346,7 @@ uint16_t BATTSCI_calculateSpoofedSoC(void)
     uint16_t SoC_toMCM_deciPercent = 0;
     if      (BATTSCI_isPackFull()  == YES) { SoC_toMCM_deciPercent = 820; } //disable regen  //JTS2doLater: See if this is actually required (also sent as flag)
     else if (BATTSCI_isPackEmpty() == YES) { SoC_toMCM_deciPercent = 200; } //disable assist //JTS2doLater: Does MCM open contactor when low SoC value sent?
-    else                                   { SoC_toMCM_deciPercent = remap_actualToSpoofedSoC[SoC_getBatteryStateNow_percent()]; } //get MCM-remapped SoC value
+    else                                   { SoC_toMCM_deciPercent = BATTSCI_remapActualToSpoofedSoC(SoC_getBatteryStateNow_percent()); } //get MCM-remapped SoC value
 
     SoC_toMCM_deciPercent = BATTSCI_SoC_Hysteresis(SoC_toMCM_deciPercent);
 
@@ -320,66 +355,200 @@ uint16_t BATTSCI_calculateSpoofedSoC(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void BATTSCI_sendFrames(void)
+//finish frame //sum(byte0:byte11) should equal 0
+void BATTSCI_appendChecksum(uint8_t frame[])
 {
-    static uint32_t previousMillis = 0;
+    uint8_t frameSum = 0; //this will overflow, which is ok for CRC
+    for (uint8_t ii = 0; ii < (BATTSCI_BYTES_IN_FRAME - 1); ii++) { frameSum += frame[ii]; }
 
-    if (( BATTSCI_bytesAvailableForWrite() > BATTSCI_BYTES_IN_FRAME )            && //Verify serial send ring buffer has room
-        ( (uint32_t)(millis() - previousMillis) >= BATTSCI_framePeriod_ms_get() ) )
-    {
-        //time to send a BATTSCI frame!
-        previousMillis = millis(); //stores the next frame start time
+    frame[BATTSCI_BYTES_IN_FRAME - 1] = BATTSCI_calculateChecksum(frameSum);
+}
 
-        static uint8_t frame2send = 0x87; //stores the next frame type to send
+/////////////////////////////////////////////////////////////////////////////////////////
 
-        if (debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BATTMETSCI)
-        { 
-            if (frame2send == 0x87) { Serial.print('\n'); }
-            else                    { Serial.print(' ');  }
-            Serial.print(F("BAT:"));
-        }
+void BATTSCI_buildFrame87(uint8_t frame[], bool wasPreviousFrameSent)
+{
+    static uint16_t spoofedSoC_Bytes = 0;
+
+    //frame is rebuilt every loop, but SoC hysteresis only steps once per sent 0x87 frame (see BATTSCI_SoC_Hysteresis())
+    if (wasPreviousFrameSent == YES) { spoofedSoC_Bytes = BATTSCI_calculateSpoofedSoC(); }
+
+    frame[ 0] = 0x87;                                              //B0 Never changes
+    frame[ 1] = 0x40;                                              //B1 Never changes
+    frame[ 2] = spoofedVoltageToSend_Counts;                       //B2 Half Vbatt_actual (e.g. 0x40 = d64 = 128 V
+    frame[ 3] = highByte(spoofedSoC_Bytes);                        //B3 SoC (upper byte)
+    frame[ 4] =  lowByte(spoofedSoC_Bytes);                        //B4 SoC (lower byte)
+    frame[ 5] = highByte(spoofedCurrentToSend_Counts << 1) & 0x7F; //B5 Battery Current (upper byte)
+    frame[ 6] =  lowByte(spoofedCurrentToSend_Counts     ) & 0x7F; //B6 Battery Current (lower byte)
+    frame[ 7] = 0x32;                                              //B7 always 0x32, except before 0xAAbyte5 changes from 0x00 to 0x10 (then 0x23)
+    frame[ 8] = BATTSCI_calculateTemperatureByte();                //B8 max battery module temp
+    frame[ 9] = BATTSCI_calculateTemperatureByte();                //B9 min battery module temp
+    frame[10] = METSCI_getPacketB3();                              //B10 MCM latest B3 data byte
+    BATTSCI_appendChecksum(frame);                                 //B11 Checksum
+}
 
-        if (frame2send == 0x87)
-        {
-            //Place 0x87 frame into serial send buffer
-            uint8_t frameSum_87 = 0; //this will overflow, which is ok for CRC
-            frameSum_87 += BATTSCI_writeByte( 0x87 );                                              //B0 Never changes
-            frameSum_87 += BATTSCI_writeByte( 0x40 );                                              //B1 Never changes
-            frameSum_87 += BATTSCI_writeByte( spoofedVoltageToSend_Counts );                       //B2 Half Vbatt_actual (e.g. 0x40 = d64 = 128 V
-
-            uint16_t spoofedSoC_Bytes = BATTSCI_calculateSpoofedSoC();
-            frameSum_87 += BATTSCI_writeByte( highByte(spoofedSoC_Bytes) );                        //B3 SoC (upper byte)
-            frameSum_87 += BATTSCI_writeByte(  lowByte(spoofedSoC_Bytes) );                        //B4 SoC (lower byte)
-
-            frameSum_87 += BATTSCI_writeByte( highByte(spoofedCurrentToSend_Counts << 1) & 0x7F ); //B5 Battery Current (upper byte)
-            frameSum_87 += BATTSCI_writeByte(  lowByte(spoofedCurrentToSend_Counts     ) & 0x7F ); //B6 Battery Current (lower byte)
-            frameSum_87 += BATTSCI_writeByte( 0x32 );                                              //B7 always 0x32, except before 0xAAbyte5 changes from 0x00 to 0x10 (then 0x23)
-            frameSum_87 += BATTSCI_writeByte( BATTSCI_calculateTemperatureByte() );                //B8 max battery module temp
-            frameSum_87 += BATTSCI_writeByte( BATTSCI_calculateTemperatureByte() );                //B9 min battery module temp
-            frameSum_87 += BATTSCI_writeByte( METSCI_getPacketB3() );                              //B10 MCM latest B3 data byte
-                           BATTSCI_writeByte( BATTSCI_calculateChecksum(frameSum_87) );            //B11 Send Checksum. sum(byte0:byte11) should equal 0
-            frame2send = 0xAA;
-        }
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BATTSCI_buildFrameAA(uint8_t frame[])
+{
+    frame[ 0] = 0xAA;                                              //B0 Never changes
+    frame[ 1] = 0x10;                                              //B1 Always 0x10, unless METSCI signal not received
+    frame[ 2] = 0x00; //JTS2doLater: Add critical Pcodes           //B2 Never changes unless P codes
+    frame[ 3] = 0x00; //JTS2doLater: Pcode if key and charger on   //B3 Never changes unless P codes
+    frame[ 4] = 0x00;                                              //B4 Never changes unless P codes
+    frame[ 5] = BATTSCI_calculateRegenAssistFlags();               //B5 Disable assist/regen flags
+    frame[ 6] = BATTSCI_calculateChargeRequestByte();              //B6 Request regen/noRegen if battery low/high
+    frame[ 7] = 0x61;                                              //B7 BCM hardware/firmware version?
+    frame[ 8] = highByte(spoofedCurrentToSend_Counts << 1) & 0x7F; //B8 Battery Current (upper byte)
+    frame[ 9] =  lowByte(spoofedCurrentToSend_Counts     ) & 0x7F; //B9 Battery Current (lower byte)
+    frame[10] = METSCI_getPacketB4();                              //B10 MCM latest B4 data byte
+    BATTSCI_appendChecksum(frame);                                 //B11 Checksum
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
 
-        else if ( frame2send == 0xAA )
+//only prints if USB transmit buffer has room (never blocks)
+void BATTSCI_printFrame(const uint8_t frame[])
+{
+    if ((debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BATTMETSCI) &&
+        (Serial.availableForWrite() > (BATTSCI_BYTES_IN_FRAME * 3 + 5))  )
+    {
+        if (frame[0] == 0x87) { Serial.print('\n'); }
+        else                  { Serial.print(' ');  }
+        Serial.print(F("BAT:"));
+
+        for (uint8_t ii = 0; ii < BATTSCI_BYTES_IN_FRAME; ii++)
         {
-            //Place 0xAA frame into serial send buffer
-            uint8_t frameSum_AA = 0; //this will overflow, which is ok for CRC
-            frameSum_AA += BATTSCI_writeByte( 0xAA );                                           //B0 Never changes
-            frameSum_AA += BATTSCI_writeByte( 0x10 );                                           //B1 Always 0x10, unless METSCI signal not received
-            frameSum_AA += BATTSCI_writeByte( 0x00 ); //JTS2doLater: Add critical Pcodes          //B2 Never changes unless P codes
-            frameSum_AA += BATTSCI_writeByte( 0x00 ); //JTS2doLater: Pcode if key and charger on  //B3 Never changes unless P codes
-            frameSum_AA += BATTSCI_writeByte( 0x00 );                                           //B4 Never changes unless P codes
-            frameSum_AA += BATTSCI_writeByte( BATTSCI_calculateRegenAssistFlags()  );           //B5 Disable assist/regen flags
-            frameSum_AA += BATTSCI_writeByte( BATTSCI_calculateChargeRequestByte() );           //B6 Request regen/noRegen if battery low/high
-            frameSum_AA += BATTSCI_writeByte( 0x61 );                                           //B7 BCM hardware/firmware version?
-            frameSum_AA += BATTSCI_writeByte( highByte(spoofedCurrentToSend_Counts << 1) & 0x7F ); //B8 Battery Current (upper byte)
-            frameSum_AA += BATTSCI_writeByte(  lowByte(spoofedCurrentToSend_Counts     ) & 0x7F ); //B9 Battery Current (lower byte)
-            frameSum_AA += BATTSCI_writeByte( METSCI_getPacketB4() );                           //B10 MCM latest B4 data byte //
-                           BATTSCI_writeByte( BATTSCI_calculateChecksum(frameSum_AA) );         //B11 Send Checksum. sum(byte0:byte11) should equal 0
-            frame2send = 0x87;
+            if (frame[ii] < 0x10) { Serial.print('0'); } //print leading zero for single digit hex
+            Serial.print(frame[ii],HEX);
+            Serial.print(',');
         }
     }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
+
+//call each keyON loop
+//both frame types are rebuilt every loop, so the ISR always sends the latest current, SoC and flags
+void BATTSCI_sendFrames(void)
+{
+    static bool wasPreviousFrameSent[2] = {YES, YES}; //YES: ISR sent this frame type before latest publish
+
+    for (uint8_t frameType = BATTSCI_FRAME_87; frameType <= BATTSCI_FRAME_AA; frameType++)
+    {
+        //idle buffer is neither published nor being sent //ISR only ever starts sending the published buffer
+        uint8_t oldSREG = SREG;
+        noInterrupts();
+        uint8_t bufferPublished = BATTSCI_bufferToSend[frameType];
+        uint8_t bufferSending   = BATTSCI_bufferSending[frameType];
+        SREG = oldSREG;
+
+        uint8_t bufferToBuild = 0;
+        while ((bufferToBuild == bufferPublished) || (bufferToBuild == bufferSending)) { bufferToBuild++; }
+
+        if (BATTSCI_isTransmitEnabled == NO) { wasPreviousFrameSent[frameType] = YES; } //first build after keyON MUST use latest SoC
+
+        if (frameType == BATTSCI_FRAME_87) { BATTSCI_buildFrame87(BATTSCI_frames[frameType][bufferToBuild], wasPreviousFrameSent[frameType]); }
+        else                               { BATTSCI_buildFrameAA(BATTSCI_frames[frameType][bufferToBuild]); }
+
+        //publish new frame //stale flag is read and cleared with the swap, so a frame sent during the build isn't lost
+        oldSREG = SREG;
+        noInterrupts();
+        BATTSCI_bufferToSend[frameType] = bufferToBuild;
+        wasPreviousFrameSent[frameType] = BATTSCI_isFrameStale[frameType];
+        BATTSCI_isFrameStale[frameType] = NO;
+        SREG = oldSREG;
+
+        if (wasPreviousFrameSent[frameType] == YES) { BATTSCI_printFrame(BATTSCI_frames[frameType][bufferToBuild]); } //once per sent frame
+    }
+
+    BATTSCI_isTransmitEnabled = YES; //both frames are built
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//called from ISR
+void BATTSCI_logFramePeriod(uint32_t period_us)
+{
+    uint32_t nominalPeriod_us = (uint32_t)framePeriod_ms * 1000;
+    uint32_t jitter_us = (period_us > nominalPeriod_us) ? (period_us - nominalPeriod_us) : (nominalPeriod_us - period_us);
+
+    uint8_t bin = 0;
+    while ( (bin < (BATTSCI_JITTER_HISTOGRAM_BINS - 1)) && (jitter_us >= ((uint32_t)BATTSCI_JITTER_BIN0_us << bin)) ) { bin++; }
+
+    if (BATTSCI_jitterHistogram[bin] < 0xFFFF) { BATTSCI_jitterHistogram[bin]++; }
+
+    busStats_logFramePeriod(BUS_BATTSCI, period_us);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void BATTSCI_printJitterHistogram(void)
+{
+    Serial.print(F("\nBATTSCI frame period jitter (us: frames):"));
+
+    for (uint8_t bin = 0; bin < BATTSCI_JITTER_HISTOGRAM_BINS; bin++)
+    {
+        Serial.print(F("\n "));
+        if (bin == (BATTSCI_JITTER_HISTOGRAM_BINS - 1)) { Serial.print(F(">=")); Serial.print(BATTSCI_JITTER_BIN0_us << (bin - 1)); }
+        else                                            { Serial.print(F(" <")); Serial.print(BATTSCI_JITTER_BIN0_us << bin);       }
+        Serial.print(F(": "));
+        noInterrupts();
+        uint16_t frameCount = BATTSCI_jitterHistogram[bin];
+        interrupts();
+        Serial.print(frameCount);
+    }
+
+    Serial.print(F("\n skipped (previous frame still sending): "));
+    Serial.print(busStats_get(BUS_BATTSCI, BUS_STAT_OVERRUN_ERRORS));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//sends next frame every 'framePeriod_ms'
+ISR(TIMER2_COMPA_vect)
+{
+    static uint8_t elapsedTime_ms = 0;
+    static uint8_t frameTypeToSend = BATTSCI_FRAME_87;
+    static uint32_t previousFrameStart_us = 0;
+    static bool wasPreviousFrameSent = NO;
+
+    if (++elapsedTime_ms < framePeriod_ms) { return; }
+    elapsedTime_ms = 0;
+
+    if (BATTSCI_isTransmitEnabled == NO) { wasPreviousFrameSent = NO; return; }
+
+    if (UCSR2B & (1 << UDRIE2))
+    {
+        //previous frame is still sending (i.e. framePeriod_ms is too short)
+        busStats_increment(BUS_BATTSCI, BUS_STAT_OVERRUN_ERRORS);
+        wasPreviousFrameSent = NO;
+        return;
+    }
+
+    uint32_t frameStart_us = micros();
+    if (wasPreviousFrameSent == YES) { BATTSCI_logFramePeriod(frameStart_us - previousFrameStart_us); }
+    previousFrameStart_us = frameStart_us;
+    wasPreviousFrameSent = YES;
+
+    BATTSCI_bufferSending[frameTypeToSend] = BATTSCI_bufferToSend[frameTypeToSend]; //main loop won't build this buffer until it's sent
+    txFrame = BATTSCI_frames[frameTypeToSend][BATTSCI_bufferSending[frameTypeToSend]];
+    txIndex = 0;
+    BATTSCI_isFrameStale[frameTypeToSend] = YES;
+    busStats_increment(BUS_BATTSCI, BUS_STAT_FRAMES_OK);
+    frameTypeToSend ^= 1; //alternate between 0x87 & 0xAA frames
+
+    UCSR2B |= (1 << UDRIE2); //USART2_UDRE_vect sends frame
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//sends one byte each time USART2 transmit buffer is empty
+ISR(USART2_UDRE_vect)
+{
+    UDR2 = txFrame[txIndex++];
+
+    if (txIndex >= BATTSCI_BYTES_IN_FRAME) { UCSR2B &= ~(1 << UDRIE2); } //entire frame sent
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,15 @@
     #define battsci_h
 
     #define BATTSCI_BYTES_IN_FRAME 12
+    #define BATTSCI_NUM_BUFFERS     3 //per frame type
+
+    #define BATTSCI_UBRR_VALUE (((F_CPU / 4 / 9600) - 1) / 2) //9600 baud (double speed mode)
+
+    #define BATTSCI_FRAME_87 0
+    #define BATTSCI_FRAME_AA 1
+
+    #define BATTSCI_JITTER_HISTOGRAM_BINS 8 //each bin is twice as wide as the previous bin
+    #define BATTSCI_JITTER_BIN0_us        8 //micros() resolution is 4 us
     #define RUNNING 1
     #define STOPPED 0
 
@@ -36,4 +45,8 @@
     void BATTSCI_framePeriod_ms_set(uint8_t period);
     uint8_t BATTSCI_framePeriod_ms_get(void);
 
+    uint16_t BATTSCI_SoC_deciPercent_get(void);
+
+    void BATTSCI_printJitterHistogram(void);
+
 #endif
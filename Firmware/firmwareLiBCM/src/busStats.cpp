@@ -0,0 +1,200 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//timing & integrity statistics for each serial bus (BATTSCI, METSCI, LiDisplay)
+//used to diagnose bad harness connections
+//stats are reset each keyON, then saved to EEPROM at keyOFF (so the latest drive can be reviewed later)
+//many stats are updated inside ISRs, so everything else must read/write them with interrupts disabled
+
+#include "libcm.h"
+
+volatile uint16_t busStats[BUS_COUNT][BUS_NUM_STATS];
+
+bool busStats_isUnsaved = NO; //stats haven't been saved since keyON
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void busStats_reset(void)
+{
+    noInterrupts();
+    for (uint8_t bus = 0; bus < BUS_COUNT; bus++)
+    {
+        for (uint8_t stat = 0; stat < BUS_NUM_STATS; stat++) { busStats[bus][stat] = 0; }
+        busStats[bus][BUS_STAT_FRAME_PERIOD_MIN_ms] = 0xFFFF; //no frames yet
+    }
+    interrupts();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void busStats_begin(void) { busStats_reset(); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void busStats_handleKeyOn(void)
+{
+    busStats_reset();
+    busStats_isUnsaved = YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//can be called from ISR
+void busStats_add(uint8_t bus, uint8_t stat, uint8_t count)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if ((uint16_t)(0xFFFF - busStats[bus][stat]) > count) { busStats[bus][stat] += count; }
+    else                                                  { busStats[bus][stat] = 0xFFFF; }
+
+    SREG = oldSREG;
+}
+
+void busStats_increment(uint8_t bus, uint8_t stat) { busStats_add(bus, stat, 1); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//can be called from ISR
+void busStats_logFramePeriod(uint8_t bus, uint32_t period_us)
+{
+    uint32_t period_ms = period_us / 1000;
+    if (period_ms > 0xFFFE) { period_ms = 0xFFFE; }
+
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if (period_ms < busStats[bus][BUS_STAT_FRAME_PERIOD_MIN_ms]) { busStats[bus][BUS_STAT_FRAME_PERIOD_MIN_ms] = period_ms; }
+    if (period_ms > busStats[bus][BUS_STAT_FRAME_PERIOD_MAX_ms]) { busStats[bus][BUS_STAT_FRAME_PERIOD_MAX_ms] = period_ms; }
+
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//can be called from ISR
+void busStats_logRxBytesWaiting(uint8_t bus, uint8_t bytesWaiting)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if (bytesWaiting > busStats[bus][BUS_STAT_RX_HIGH_WATER]) { busStats[bus][BUS_STAT_RX_HIGH_WATER] = bytesWaiting; }
+
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t busStats_get(uint8_t bus, uint8_t stat)
+{
+    noInterrupts();
+    uint16_t value = busStats[bus][stat];
+    interrupts();
+
+    return value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call at keyOFF
+void busStats_save(void)
+{
+    if (busStats_isUnsaved == NO) { return; } //LiBCM just booted (keyOFF event occurs at boot) //don't overwrite previous drive's stats
+
+    uint8_t statsToSave[BUS_STATS_NUM_BYTES];
+
+    noInterrupts();
+    for (uint8_t bus = 0; bus < BUS_COUNT; bus++)
+    {
+        for (uint8_t stat = 0; stat < BUS_NUM_STATS; stat++)
+        {
+            uint8_t index = ((bus * BUS_NUM_STATS) + stat) * 2;
+            statsToSave[index    ] = highByte(busStats[bus][stat]);
+            statsToSave[index + 1] =  lowByte(busStats[bus][stat]);
+        }
+    }
+    interrupts();
+
+    eeprom_busStats_save(statsToSave, BUS_STATS_NUM_BYTES);
+    busStats_isUnsaved = NO;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void busStats_printValue(uint16_t value)
+{
+    Serial.print('\t');
+    if (value == 0xFFFF) { Serial.print('-'); } //no data or saturated
+    else                 { Serial.print(value, DEC); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void busStats_printTable(const uint8_t stats[])
+{
+    Serial.print(F("\n\t\tBATTSCI\tMETSCI\tLiDisp"));
+
+    for (uint8_t stat = 0; stat < BUS_NUM_STATS; stat++)
+    {
+        switch (stat)
+        {
+            case BUS_STAT_FRAMES_OK:           Serial.print(F("\nframes OK\t")); break;
+            case BUS_STAT_CHECKSUM_ERRORS:     Serial.print(F("\nchecksum err\t")); break;
+            case BUS_STAT_FRAMING_ERRORS:      Serial.print(F("\nframing err\t")); break;
+            case BUS_STAT_PARITY_ERRORS:       Serial.print(F("\nparity err\t")); break;
+            case BUS_STAT_OVERRUN_ERRORS:      Serial.print(F("\noverruns\t")); break;
+            case BUS_STAT_BYTES_DISCARDED:     Serial.print(F("\nbytes discarded")); break;
+            case BUS_STAT_FRAME_PERIOD_MIN_ms: Serial.print(F("\nmin period ms\t")); break;
+            case BUS_STAT_FRAME_PERIOD_MAX_ms: Serial.print(F("\nmax period ms\t")); break;
+            case BUS_STAT_RX_HIGH_WATER:       Serial.print(F("\nRX backlog max\t")); break;
+        }
+
+        for (uint8_t bus = 0; bus < BUS_COUNT; bus++)
+        {
+            uint8_t index = ((bus * BUS_NUM_STATS) + stat) * 2;
+            busStats_printValue( (stats[index] << 8) | stats[index + 1] );
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void busStats_print(void)
+{
+    uint8_t stats[BUS_STATS_NUM_BYTES];
+
+    for (uint8_t bus = 0; bus < BUS_COUNT; bus++)
+    {
+        for (uint8_t stat = 0; stat < BUS_NUM_STATS; stat++)
+        {
+            uint16_t value = busStats_get(bus, stat);
+            uint8_t index = ((bus * BUS_NUM_STATS) + stat) * 2;
+            stats[index    ] = highByte(value);
+            stats[index + 1] =  lowByte(value);
+        }
+    }
+
+    Serial.print(F("\nSerial bus stats since keyON:"));
+    busStats_printTable(stats);
+    Serial.print(F("\nLiDisp input latency us\t"));
+    Serial.print(LiDisplay_inputLatency_us_get());
+    Serial.print(F(" (max "));
+    Serial.print(LiDisplay_inputLatencyMax_us_get());
+    Serial.print(')');
+
+    Serial.print(F("\n4x20 LCD I2C transactions "));
+    Serial.print(twi_transactionCount_get());
+    Serial.print(F(", errors "));
+    Serial.print(twi_errorCount_get());
+    Serial.print(F(", CPU blocked us "));
+    Serial.print(twi_blockedTime_us_get());
+    Serial.print(F(" (max "));
+    Serial.print(twi_blockedTimeMax_us_get());
+    Serial.print(')');
+
+    Serial.print(F("\n\nSerial bus stats saved at latest keyOFF:"));
+    if (eeprom_busStats_load(stats, BUS_STATS_NUM_BYTES) == YES) { busStats_printTable(stats); }
+    else                                                          { Serial.print(F(" none")); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,39 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef busstats_h
+    #define busstats_h
+
+    #define BUS_BATTSCI   0
+    #define BUS_METSCI    1
+    #define BUS_LIDISPLAY 2
+    #define BUS_COUNT     3
+
+    //all stats are uint16 //counters saturate at 0xFFFF
+    #define BUS_STAT_FRAMES_OK          0
+    #define BUS_STAT_CHECKSUM_ERRORS    1
+    #define BUS_STAT_FRAMING_ERRORS     2 //UCSRnA FEn
+    #define BUS_STAT_PARITY_ERRORS      3 //UCSRnA UPEn
+    #define BUS_STAT_OVERRUN_ERRORS     4 //RX: UCSRnA DORn or RX buffer full //BATTSCI: frame skipped because previous frame still sending
+    #define BUS_STAT_BYTES_DISCARDED    5 //received bytes that weren't part of a valid frame
+    #define BUS_STAT_FRAME_PERIOD_MIN_ms 6
+    #define BUS_STAT_FRAME_PERIOD_MAX_ms 7
+    #define BUS_STAT_RX_HIGH_WATER      8 //METSCI: max frames published between main loop reads //LiDisplay: max events waiting in queue
+    #define BUS_NUM_STATS               9
+
+    #define BUS_STATS_NUM_BYTES (BUS_COUNT * BUS_NUM_STATS * 2)
+
+    void busStats_begin(void);
+    void busStats_handleKeyOn(void);
+
+    void busStats_increment(uint8_t bus, uint8_t stat);
+    void busStats_add(uint8_t bus, uint8_t stat, uint8_t count);
+    void busStats_logFramePeriod(uint8_t bus, uint32_t period_us);
+    void busStats_logRxBytesWaiting(uint8_t bus, uint8_t bytesWaiting);
+
+    uint16_t busStats_get(uint8_t bus, uint8_t stat);
+
+    void busStats_save(void);
+    void busStats_print(void);
+
+#endif
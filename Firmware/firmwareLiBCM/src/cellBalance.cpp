@@ -9,29 +9,118 @@ bool cellsAreBalancing = NO;
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-//JTS2doLater: Add an array that accumulates how long each cell is discharging
-//pseudocode:
-// uint16_t cellBalanceTimer_seconds[NUMCELLS]=0;
-// uint8_t balancingComplete = false;
-
-// if (gridChargerJustPluggedIn) { clear cellBalanceTimer_seconds(); balancingComplete = false; } //set all array elements to zero
-
-// if (balancingFinished) { balancingComplete = true; } //the first time balancing finishes, we stop accumulating the cell timers
-
-// if (hasOneSecondPassed && (balancingComplete == FALSE)) {
-//    for (cellNumber=1; cellNumber<NUMCELLS; cellNumber++) {
-//       if (cellStatus[cellNumber] == BALANCING) { cellBalanceTimer_seconds[cellNumber]++; }
-// }} 
-
-//Allow LiBCM to print this array over USB
-// -if all cells are similar, then all array elements should have similar values (ideally they would all be 0).
+//Balance history
+//Accumulates how long each cell's discharge resistor has been on (stored in EEPROM, '$BAL' to print)
+// -if all cells are similar, then all cells should have similar values (ideally they would all be 0).
 // -cells with less capacity will self-discharge more (at rest, at idle etc).
 // -cells with more capacity will span a narrower voltage range (compared to cells with less capacity).
-// -The absolute value stored for each cell in the cellBalanceTimer_seconds array isn't important, but the difference between the various cells is.
+// -The absolute value stored for each cell isn't important, but the difference between the various cells is.
 // -Outlier cells (i.e. that spend more or less time balancing) are suspect.
 // -a weaker cell will tend to self-discharge more often than healthy cells.
 //Since healthy cells won't lose this energy (through self-discharge), they'll spend more time balancing.
-//(Theory) Therefore, weaker cells will likely tend to have lower stored values in the cellBalanceTimer_seconds array.
+//(Theory) Therefore, weaker cells will likely tend to have lower stored values.
+
+uint16_t balanceHistory_unsaved_seconds[TOTAL_IC][CELLS_PER_IC] = {{0}}; //not yet added to EEPROM
+uint32_t balanceHistory_latestSave_ms = 0;
+
+#define BALANCE_HISTORY_SAVE_IDLE 0xFF
+uint8_t balanceHistory_nextCellToSave = BALANCE_HISTORY_SAVE_IDLE; //(ic * CELLS_PER_IC) + cell
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//only whole minutes are written to EEPROM //the remainder stays in RAM until the next save
+//cells with less than one unsaved minute aren't written
+void cellBalance_history_saveCell(uint8_t ic, uint8_t cell)
+{
+    uint16_t unsaved_minutes = balanceHistory_unsaved_seconds[ic][cell] / 60;
+
+    if (unsaved_minutes == 0) { return; }
+
+    uint16_t total_minutes = eeprom_balanceHistory_minutes_get(ic, cell);
+
+    if (total_minutes > (BALANCE_HISTORY_MAX_MINUTES - unsaved_minutes)) { total_minutes = BALANCE_HISTORY_MAX_MINUTES; }
+    else                                                                  { total_minutes += unsaved_minutes;            }
+
+    eeprom_balanceHistory_minutes_set(ic, cell, total_minutes);
+    balanceHistory_unsaved_seconds[ic][cell] -= unsaved_minutes * 60;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//EEPROM wear: requested hourly while balancing, and when balancing stops
+//cells are saved a few per loop by cellBalance_history_saveNextCells(), so the loop is never blocked
+void cellBalance_history_requestSave(void)
+{
+    balanceHistory_nextCellToSave = 0;
+    balanceHistory_latestSave_ms = millis();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void cellBalance_history_saveNextCells(void)
+{
+    if (balanceHistory_nextCellToSave == BALANCE_HISTORY_SAVE_IDLE) { return; }
+    if (eeprom_isIdle() == NO)                                      { return; } //other EEPROM writes have priority
+
+    for (uint8_t ii = 0; ii < BALANCE_HISTORY_CELLS_SAVED_PER_LOOP; ii++)
+    {
+        cellBalance_history_saveCell(balanceHistory_nextCellToSave / CELLS_PER_IC, balanceHistory_nextCellToSave % CELLS_PER_IC);
+
+        if (++balanceHistory_nextCellToSave >= (TOTAL_IC * CELLS_PER_IC)) { balanceHistory_nextCellToSave = BALANCE_HISTORY_SAVE_IDLE; return; }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//saves all cells now //blocks until every write is queued (up to ~290 ms)
+//only call before LiBCM turns off
+void cellBalance_history_save(void)
+{
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++) { cellBalance_history_saveCell(ic, cell); }
+    }
+
+    balanceHistory_nextCellToSave = BALANCE_HISTORY_SAVE_IDLE;
+    balanceHistory_latestSave_ms = millis();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void cellBalance_history_reset(void)
+{
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++) { balanceHistory_unsaved_seconds[ic][cell] = 0; }
+    }
+
+    eeprom_balanceHistory_reset();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void cellBalance_history_print(void)
+{
+    Serial.print(F("\nLifetime cell balancing ('$BAL=CLR' to clear)"));
+    Serial.print(F("\nminutes discharged / estimated mAh bled:"));
+
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        Serial.print(F("\nIC"));
+        Serial.print(ic);
+        Serial.print(':');
+
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++)
+        {
+            uint32_t total_minutes = eeprom_balanceHistory_minutes_get(ic, cell) + (balanceHistory_unsaved_seconds[ic][cell] / 60);
+
+            Serial.print(' ');
+            Serial.print(total_minutes);
+            Serial.print('/');
+            Serial.print((total_minutes * CELL_BALANCE_NOMINAL_CURRENT_mA) / 60);
+        }
+    }
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,41 +128,187 @@ bool cellBalance_areCellsBalancing(void) { return cellsAreBalancing; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//Per-cell SoC model
+//Each cell's charge is estimated from its resting voltage (i.e. the 'anchor'), minus the charge bled through its discharge resistor since then.
+//Cells are discharged until they're within CELL_BALANCE_TO_WITHIN_PERMILLE of the emptiest cell.
+//Unlike a voltage threshold, this works in the flat (midrange SoC) part of the OCV curve, where each mV is a lot of charge.
+//All cells use the pack's learned capacity (cells are in series, so each cell's capacity is the stack capacity).
+//The anchor is interpolated from the OCV table (each 100 uV count is resolved), and is only taken after the discharge resistors have been off for CELL_BALANCE_ANCHOR_REST_ms.
+//Charge is stored in milliamp-seconds, so the balance loop doesn't divide.
+
+int32_t  cellModel_charge_mAs[TOTAL_IC][CELLS_PER_IC] = {{0}}; //anchor charge, minus charge bled since latest anchor
+uint16_t cellsDischargingNow[TOTAL_IC] = {0}; //discharge resistor bitmaps sent to each LTC6804
+bool     cellModel_isAnchorValid = NO;
+bool     cellModel_isAnchorPending = NO; //resistors are off while cells rest before anchoring
+uint32_t cellModel_latestAnchor_ms = 0;
+uint32_t cellModel_latestDischarge_ms = 0; //latest time any discharge resistor was on
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//cells aren't balancing (resistors off), but balancing resumes once cells rest long enough to anchor
+bool cellBalance_isBalancingPending(void) { return cellModel_isAnchorPending; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call each time the discharge resistor bitmaps are about to change
+void cellModel_accumulateBalanceTime(void)
+{
+    static uint32_t latestUpdate_ms = 0;
+    static uint16_t elapsedTime_remainder_ms = 0;
+
+    uint32_t elapsedTime_ms = millis() - latestUpdate_ms;
+    latestUpdate_ms = millis();
+
+    //LTC6804 watchdog turns discharge resistors off if not refreshed
+    if (elapsedTime_ms > CELL_BALANCE_MAX_REFRESH_PERIOD_ms) { elapsedTime_ms = CELL_BALANCE_MAX_REFRESH_PERIOD_ms; }
+
+    elapsedTime_remainder_ms += elapsedTime_ms;
+    uint8_t elapsedTime_seconds = elapsedTime_remainder_ms / 1000;
+    elapsedTime_remainder_ms -= elapsedTime_seconds * 1000;
+
+    if (elapsedTime_seconds == 0) { return; }
+
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        if (cellsDischargingNow[ic] == 0) { continue; } //no cells discharging on this IC
+
+        cellModel_latestDischarge_ms = latestUpdate_ms; //resistors were on until now
+
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++)
+        {
+            if (cellsDischargingNow[ic] & (1 << cell))
+            {
+                uint16_t dischargeCurrent_mA = ((uint32_t)LTC68042result_specificCellVoltage_get(ic, cell) * CELL_BALANCE_mA_PER_COUNT_Q16) >> 16;
+                cellModel_charge_mAs[ic][cell] -= (uint16_t)elapsedTime_seconds * dischargeCurrent_mA;
+
+                if (balanceHistory_unsaved_seconds[ic][cell] < (0xFFFF - elapsedTime_seconds)) { balanceHistory_unsaved_seconds[ic][cell] += elapsedTime_seconds; }
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST only be called after discharge resistors have been off for CELL_BALANCE_ANCHOR_REST_ms
+void cellModel_anchorToRestingVoltage(void)
+{
+    uint16_t stackFullCapacity_mAh = SoC_getStackFullCapacity_mAh();
+
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++)
+        {
+            uint16_t anchorSoC_centiPercent = SoC_EKF_calculateSoC_centiPercent(LTC68042result_specificCellVoltage_get(ic, cell));
+
+            //mAs = centiPercent * mAh * 3600 / 10000 = (centiPercent * mAh / 25) * 9 //largest intermediate: 10000 * 65535 fits in uint32
+            cellModel_charge_mAs[ic][cell] = (int32_t)((((uint32_t)anchorSoC_centiPercent * stackFullCapacity_mAh) / 25) * 9);
+        }
+    }
+
+    cellModel_isAnchorValid = YES;
+    cellModel_isAnchorPending = NO;
+    cellModel_latestAnchor_ms = millis();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//discharge resistors are turned off until cell voltages recover, then cells are anchored
+//returns YES when anchor is valid (i.e. cells can be balanced)
+bool cellModel_updateAnchor(void)
+{
+    if ((cellModel_isAnchorValid == YES) && ((millis() - cellModel_latestAnchor_ms) <= CELL_BALANCE_REANCHOR_PERIOD_ms)) { return YES; }
+
+    if ((millis() - cellModel_latestDischarge_ms) >= CELL_BALANCE_ANCHOR_REST_ms)
+    {
+        cellModel_anchorToRestingVoltage();
+        return YES;
+    }
+
+    cellModel_isAnchorValid = NO; //previous anchor is stale
+    cellModel_isAnchorPending = YES;
+
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        cellsDischargingNow[ic] = 0;
+        debugUSB_setCellBalanceStatus(ic, 0, params_get(PARAM_CELL_VMAX_REGEN));
+        LTC68042configure_setBalanceResistors((ic + FIRST_IC_ADDR), 0, LTC6804_DISCHARGE_TIMEOUT_02_SECONDS);
+    }
+
+    return NO;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 //JTS2doLater: Write keyOff test that measures each cell voltage twice: once with discharge resistor off, and again with resistor on.
 //             Then verify voltage drop, which means the discharge resistor is turning off and on.  If there isn't enough resolution,
 //             another method would be to wait a few hours for pack voltages to settle, then log all cell voltages an hour apart.
-//JTS2doLater: Add per-cell SoC, to allow balancing at any SoC (see icn.net:post#1502833,comment#579)
 //balance cells (if needed)
 void configureDischargeResistors(void)
 {   
-    static uint8_t balanceHysteresis = CELL_BALANCE_TO_WITHIN_COUNTS_TIGHT;
-    uint16_t cellDischargeVoltageThreshold = 0; //cells above this value are discharged
-    uint16_t cellsToDischarge[TOTAL_IC] = {0}; //each uint16's QTY12 LSBs correspond to each LTC6804's QTY12 cells
+    static uint8_t balanceTolerance_permille = params_get(PARAM_CELL_BALANCE_PERMILLE_TIGHT); //initialized on first call (after params_begin())
+    bool wereCellsBalancing = cellsAreBalancing;
 
-    cellsAreBalancing = NO;
+    cellModel_accumulateBalanceTime(); //MUST run before cellsDischargingNow[] changes
+
+    if (cellModel_updateAnchor() == NO)
+    {
+        //cells are resting before anchor
+        cellsAreBalancing = NO;
+        if (wereCellsBalancing == YES) { cellBalance_history_requestSave(); }
+        return;
+    }
+
+    bool isAnyCellOvercharged = (LTC68042result_hiCellVoltage_get() > CELL_VREST_85_PERCENT_SoC);
 
-    if (LTC68042result_hiCellVoltage_get() > CELL_VREST_85_PERCENT_SoC) { cellDischargeVoltageThreshold = CELL_VREST_85_PERCENT_SoC; }
-    else { cellDischargeVoltageThreshold = LTC68042result_loCellVoltage_get() + balanceHysteresis; }
+    //find emptiest cell
+    int32_t emptiestCellCharge_mAs = 0x7FFFFFFF;
+    uint16_t emptiestCellVoltage = CELL_VREST_85_PERCENT_SoC;
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++)
+        {
+            if (cellModel_charge_mAs[ic][cell] < emptiestCellCharge_mAs)
+            {
+                emptiestCellCharge_mAs = cellModel_charge_mAs[ic][cell];
+                if (isAnyCellOvercharged == NO) { emptiestCellVoltage = LTC68042result_specificCellVoltage_get(ic, cell); }
+            }
+        }
+    }
+
+    //mAs = mAh * permille * 3600 / 1000 = (mAh * permille * 18) / 5
+    int32_t cellDischargeChargeThreshold_mAs = emptiestCellCharge_mAs + ((((uint32_t)SoC_getStackFullCapacity_mAh() * balanceTolerance_permille) * 18) / 5);
+
+    cellsAreBalancing = NO;
 
     //determine which cells to balance
     for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
     {
+        uint16_t cellsToDischarge = 0; //QTY12 LSBs correspond to this LTC6804's QTY12 cells
+
         for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++)
         {
-            if (LTC68042result_specificCellVoltage_get(ic, cell) > cellDischargeVoltageThreshold)
+            bool isCellTooFull = NO;
+
+            if (isAnyCellOvercharged == YES) { isCellTooFull = (LTC68042result_specificCellVoltage_get(ic, cell) > CELL_VREST_85_PERCENT_SoC); } //max cell voltage for long lifetime
+            else                             { isCellTooFull = (cellModel_charge_mAs[ic][cell] > cellDischargeChargeThreshold_mAs);           }
+
+            if (isCellTooFull == YES)
             { 
-                //this cell voltage is higher than the lowest cell voltage + hysteresis
-                cellsToDischarge[ic] |= (1 << cell); //this cell will be discharged
+                cellsToDischarge |= (1 << cell); //this cell will be discharged
                 cellsAreBalancing = YES;
-                balanceHysteresis = CELL_BALANCE_TO_WITHIN_COUNTS_TIGHT;
+                balanceTolerance_permille = params_get(PARAM_CELL_BALANCE_PERMILLE_TIGHT);
             }
         }
 
-        debugUSB_setCellBalanceStatus(ic, cellsToDischarge[ic], cellDischargeVoltageThreshold);
-        LTC68042configure_setBalanceResistors((ic + FIRST_IC_ADDR), cellsToDischarge[ic], LTC6804_DISCHARGE_TIMEOUT_02_SECONDS);
+        cellsDischargingNow[ic] = cellsToDischarge;
+        debugUSB_setCellBalanceStatus(ic, cellsToDischarge, emptiestCellVoltage);
+        LTC68042configure_setBalanceResistors((ic + FIRST_IC_ADDR), cellsToDischarge, LTC6804_DISCHARGE_TIMEOUT_02_SECONDS);
     }
 
-    if (cellsAreBalancing == NO) { balanceHysteresis = CELL_BALANCE_TO_WITHIN_COUNTS_LOOSE; } 
+    if (cellsAreBalancing == NO) { balanceTolerance_permille = params_get(PARAM_CELL_BALANCE_PERMILLE_LOOSE); } 
+
+    if ( ((wereCellsBalancing == YES) && (cellsAreBalancing == NO)) ||
+         ((millis() - balanceHistory_latestSave_ms) > BALANCE_HISTORY_SAVE_PERIOD_ms) ) { cellBalance_history_requestSave(); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -83,12 +318,18 @@ void disableDischargeResistors(void)
     //to save power, only called once each time balancing is disabled
     const uint16_t cellsToDischarge = 0;
 
+    cellModel_accumulateBalanceTime(); //MUST run before cellsDischargingNow[] changes
+
     for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
     {
-        debugUSB_setCellBalanceStatus(ic, cellsToDischarge, CELL_VMAX_REGEN);
+        cellsDischargingNow[ic] = cellsToDischarge;
+        debugUSB_setCellBalanceStatus(ic, cellsToDischarge, params_get(PARAM_CELL_VMAX_REGEN));
         LTC68042configure_setBalanceResistors((ic + FIRST_IC_ADDR), cellsToDischarge, LTC6804_DISCHARGE_TIMEOUT_02_SECONDS);
     }
     cellsAreBalancing = NO;
+    cellModel_isAnchorValid = NO; //cells might be driven or charged before balancing is allowed again
+    cellModel_isAnchorPending = NO;
+    cellBalance_history_requestSave(); //keyON can disable balancing, so MUST NOT block
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -97,18 +338,18 @@ uint8_t isBalancingAllowed(void)
 {
     //order is important
     //external checks
-    if (key_getSampledState()               == KEYSTATE_ON            ) { return NO__KEY_IS_ON;               }
+    if (key_getSampledState()               == KEYSTATE_ON                                ) { return NO__KEY_IS_ON;               }
 #ifdef ONLY_BALANCE_CELLS_WHEN_GRID_CHARGER_PLUGGED_IN
-    if (gpio_isGridChargerPluggedInNow()    == NO                     ) { return NO__CHARGER_UNPLUGGED;       }
+    if (gpio_isGridChargerPluggedInNow()    == NO                                         ) { return NO__CHARGER_UNPLUGGED;       }
 #else
-    if ((gpio_isGridChargerPluggedInNow()   == NO                  ) &&
-        (SoC_getBatteryStateNow_percent()    < CELL_BALANCE_MIN_SoC)  ) { return NO__SoC_TOO_LOW;             }
+    if ((gpio_isGridChargerPluggedInNow()   == NO                                      ) &&
+        (SoC_getBatteryStateNow_percent()    < params_get(PARAM_CELL_BALANCE_MIN_SoC)  )  ) { return NO__SoC_TOO_LOW;             }
 #endif
     //cell voltage checks
-    if (LTC68042result_hiCellVoltage_get()   > CELL_VMAX_REGEN        ) { return NO__ATLEASTONECELL_TOO_HIGH; }
-    if (LTC68042result_loCellVoltage_get()   < CELL_VMIN_GRIDCHARGER  ) { return NO__ATLEASTONECELL_TOO_LOW;  }
+    if (LTC68042result_hiCellVoltage_get()   > params_get(PARAM_CELL_VMAX_REGEN)          ) { return NO__ATLEASTONECELL_TOO_HIGH; }
+    if (LTC68042result_loCellVoltage_get()   < params_get(PARAM_CELL_VMIN_GRIDCHARGER)    ) { return NO__ATLEASTONECELL_TOO_LOW;  }
     //thermal checks
-    if (temperature_battery_getLatest()      > CELL_BALANCE_MAX_TEMP_C) { return NO__BATTERY_IS_HOT;          }
+    if (temperature_battery_getLatest()      > (int16_t)params_get(PARAM_CELL_BALANCE_MAX_TEMP_C)) { return NO__BATTERY_IS_HOT;          } //signed compare (below 0 degC isn't hot)
     
     return YES__BALANCING_ALLOWED;
 }
@@ -128,6 +369,8 @@ void cellBalance_handler(void)
     else if (isBalancingAllowed_previous == YES__BALANCING_ALLOWED) { disableDischargeResistors(); }
     
     isBalancingAllowed_previous = isBalancingAllowed_now;
+
+    cellBalance_history_saveNextCells();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -9,7 +9,27 @@
 
 	#define YES__BALANCING_ALLOWED YES__CHARGING_ALLOWED //balancing code reusing grid charging constants
 
+    #define CELL_BALANCE_RESISTOR_OHMS 57 //estimated from RevC V&V (5AhG3 cells discharged ~400 mAh in six hours at 3.85 volts)
+
+    #define CELL_BALANCE_MAX_REFRESH_PERIOD_ms 2000 //LTC6804 watchdog turns discharge resistors off after ~1.8 seconds
+    #define CELL_BALANCE_REANCHOR_PERIOD_ms (60 * 60000) //per-cell SoC is periodically re-estimated from cell voltage
+    #define CELL_BALANCE_ANCHOR_REST_ms     (     60000) //discharge resistors sag cell voltage, so they're off this long before re-estimating
+
+    //mA = counts / (10 * ohms) //stored as Q16 reciprocal (rounded), so no divide is needed
+    #define CELL_BALANCE_mA_PER_COUNT_Q16 ((65536UL + (5 * CELL_BALANCE_RESISTOR_OHMS)) / (10 * CELL_BALANCE_RESISTOR_OHMS))
+
+    #define CELL_BALANCE_NOMINAL_CURRENT_mA (37000 / (10 * CELL_BALANCE_RESISTOR_OHMS)) //3.7 volt cell
+
+    #define BALANCE_HISTORY_SAVE_PERIOD_ms (60 * 60000) //max time between EEPROM writes while balancing
+    #define BALANCE_HISTORY_MAX_MINUTES    0xFFFE //0xFFFF is erased EEPROM
+    #define BALANCE_HISTORY_CELLS_SAVED_PER_LOOP 4 //up to 8 bytes queued per loop (only when EEPROM queue is empty)
+
     bool cellBalance_areCellsBalancing(void);
+    bool cellBalance_isBalancingPending(void); //YES while resistors are off so cells can rest before re-anchoring
+
+    void cellBalance_history_save(void); //blocks //only call before LiBCM turns off
+    void cellBalance_history_reset(void);
+    void cellBalance_history_print(void);
 
     void cellBalance_handler(void);
 
@@ -55,6 +55,42 @@
 
         #define PIN_SPI_CS SS
 
+        //port & bit for pins accessed with gpio_fastWrite()/gpio_fastRead()/gpio_fastToggle() (see gpio.h)
+        //MUST match Arduino pin number above (gpio_verifyFastPins() checks each pin at boot)
+        //MUST match Arduino Mega2560 pin numbers above
+        #define PIN_LED1_PORT            K //A12
+        #define PIN_LED1_BIT             4
+        #define PIN_LED2_PORT            K //A13
+        #define PIN_LED2_BIT             5
+        #define PIN_LED3_PORT            L //D46
+        #define PIN_LED3_BIT             3
+        #define PIN_LED4_PORT            L //D48
+        #define PIN_LED4_BIT             1
+        #define PIN_SPI_CS_PORT          B //D53
+        #define PIN_SPI_CS_BIT           0
+        #define PIN_METSCI_DE_PORT       E //D2
+        #define PIN_METSCI_DE_BIT        4
+        #define PIN_METSCI_REn_PORT      E //D3
+        #define PIN_METSCI_REn_BIT       5
+        #define PIN_BATTSCI_DE_PORT      G //D41
+        #define PIN_BATTSCI_DE_BIT       0
+        #define PIN_BATTSCI_REn_PORT     G //D40
+        #define PIN_BATTSCI_REn_BIT      1
+        #define PIN_IGNITION_SENSE_PORT  B //D13
+        #define PIN_IGNITION_SENSE_BIT   7
+        #define PIN_SENSOR_EN_PORT       H //D6
+        #define PIN_SENSOR_EN_BIT        3
+        #define PIN_FANOEM_LOW_PORT      F //A7
+        #define PIN_FANOEM_LOW_BIT       7
+        #define PIN_FANOEM_HI_PORT       K //A8
+        #define PIN_FANOEM_HI_BIT        0
+        #define PIN_GRID_SENSE_PORT      H //D9
+        #define PIN_GRID_SENSE_BIT       6
+        #define PIN_GRID_PWM_PORT        H //D8
+        #define PIN_GRID_PWM_BIT         5
+        #define PIN_GRID_EN_PORT         B //D10
+        #define PIN_GRID_EN_BIT          4
+
         //Serial3
         #define METSCI_TX 14
         #define METSCI_RX 15
@@ -77,10 +113,14 @@
             #endif
             #define PIN_ABSTRACTED_GRID_CURRENT PIN_GPIO3
             #define PIN_ABSTRACTED_GRID_EN      PIN_GRID_PWM
+            #define PIN_ABSTRACTED_GRID_EN_PORT PIN_GRID_PWM_PORT
+            #define PIN_ABSTRACTED_GRID_EN_BIT  PIN_GRID_PWM_BIT
             #define PIN_ABSTRACTED_GRID_VOLTAGE PIN_GPIO2
         #elif defined GRIDCHARGER_IS_NOT_1500W
             #define PIN_ABSTRACTED_GRID_CURRENT PIN_GRID_PWM
             #define PIN_ABSTRACTED_GRID_EN      PIN_GRID_EN
+            #define PIN_ABSTRACTED_GRID_EN_PORT PIN_GRID_EN_PORT
+            #define PIN_ABSTRACTED_GRID_EN_BIT  PIN_GRID_EN_BIT
             //these chargers don't support voltage control
         #else
             #error (Grid charger type not specified in config.h)
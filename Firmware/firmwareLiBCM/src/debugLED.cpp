@@ -10,10 +10,10 @@ void debugLED(uint8_t LED_number, bool illuminated)
     #ifdef LED_DEBUG
         switch (LED_number)
         {
-            case 1: digitalWrite(PIN_LED1,illuminated); break;
-            case 2: digitalWrite(PIN_LED2,illuminated); break;
-            case 3: digitalWrite(PIN_LED3,illuminated); break;
-            case 4: digitalWrite(PIN_LED4,illuminated); break;
+            case 1: gpio_fastWrite(PIN_LED1, illuminated); break;
+            case 2: gpio_fastWrite(PIN_LED2, illuminated); break;
+            case 3: gpio_fastWrite(PIN_LED3, illuminated); break;
+            case 4: gpio_fastWrite(PIN_LED4, illuminated); break;
         }
     #else
         LED_number  +=0; //prevent "unused parameter" compiler warning
@@ -28,10 +28,10 @@ void LED(uint8_t LED_number, bool illuminated)
     #ifdef LED_NORMAL
         switch (LED_number)
         {
-            case 1: digitalWrite(PIN_LED1,illuminated); break;
-            case 2: digitalWrite(PIN_LED2,illuminated); break;
-            case 3: digitalWrite(PIN_LED3,illuminated); break;
-            case 4: digitalWrite(PIN_LED4,illuminated); break;
+            case 1: gpio_fastWrite(PIN_LED1, illuminated); break;
+            case 2: gpio_fastWrite(PIN_LED2, illuminated); break;
+            case 3: gpio_fastWrite(PIN_LED3, illuminated); break;
+            case 4: gpio_fastWrite(PIN_LED4, illuminated); break;
         }
     #else
         LED_number  +=0; //prevent "unused parameter" compiler warning
@@ -48,7 +48,7 @@ void blinkLED1()
         if ((uint32_t)(millis() - previousMillis) >= 100)
         {
             previousMillis = millis();  //JTS2doLater: Handle millis() overflow (~50 days)
-            digitalWrite(PIN_LED1, !digitalRead(PIN_LED1) );
+            gpio_fastToggle(PIN_LED1);
         }
     #endif  
 }
@@ -62,7 +62,7 @@ void blinkLED2()
         if ((uint32_t)(millis() - previousMillis) >= 100)
         {
             previousMillis = millis();
-            digitalWrite(PIN_LED2, !digitalRead(PIN_LED2) );
+            gpio_fastToggle(PIN_LED2);
         }
     #endif
 }
@@ -76,7 +76,7 @@ void blinkLED3()
         if ((uint32_t)(millis() - previousMillis) >= 100)
         {
             previousMillis = millis();
-            digitalWrite(PIN_LED3, !digitalRead(PIN_LED3) );
+            gpio_fastToggle(PIN_LED3);
         }
     #endif
 }
@@ -90,7 +90,7 @@ void blinkLED4()
         if ((uint32_t)(millis() - previousMillis) >= 100)
         {
             previousMillis = millis();
-            digitalWrite(PIN_LED4, !digitalRead(PIN_LED4) );
+            gpio_fastToggle(PIN_LED4);
         }
     #endif
 }
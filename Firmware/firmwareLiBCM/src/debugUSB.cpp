@@ -38,11 +38,11 @@ void debugUSB_printOneICsCellVoltages(uint8_t icToPrint, uint8_t decimalPlaces)
         //puts QTY64 bytes into the USB serial buffer, which can take up to QTY64 bytes
         //Adding any more characters to this string will prevent Serial.print from returning (until the buffer isn't full)
         Serial.print(F("\nIC"));
-        Serial.print(String(icToPrint));
+        Serial.print(icToPrint);
         for (int cellToPrint = 0; cellToPrint < CELLS_PER_IC; cellToPrint++)
         {
             Serial.print(',');
-            Serial.print( String( LTC68042result_specificCellVoltage_get(icToPrint,cellToPrint) * 0.0001, decimalPlaces) );
+            printFormat_fixedPoint(Serial, LTC68042result_specificCellVoltage_get(icToPrint,cellToPrint), 4, decimalPlaces);
         }
     }
 }
@@ -79,13 +79,13 @@ void debugUSB_printCellBalanceStatus(void)
     if (anyCellsBalancing == YES)
     {
         Serial.print(F("\nDischarging cells above "));
-        Serial.print(cellBalanceThreshold*0.0001,4);
+        printFormat_fixedPoint(Serial, cellBalanceThreshold, 4, 4);
         Serial.print(F(" V (0x): "));
 
         //print discharge resistor bitmap status
         for (uint8_t ii = 0; ii < TOTAL_IC; ii++)
         {
-            Serial.print(String(cellBalanceBitmaps[ii], HEX));
+            printFormat_hex(Serial, cellBalanceBitmaps[ii], 1);
             Serial.print(',');
         }
     }
@@ -101,7 +101,7 @@ void debugUSB_printCellBalanceStatus(void)
 void debugUSB_displayUptime_seconds(void)
 {
     Serial.print(F("\nUptime(s): "));
-    Serial.print( String(millis() * 0.001) );
+    printFormat_fixedPointUnsigned(Serial, millis(), 3, 2); //millis() exceeds int32 after ~24.8 days
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -136,23 +136,23 @@ void debugUSB_printData_power(void)
     //               ***************************************************************
     //Serial.print(F("\n140,100,A, 170,156,V, 3.79,3.77,V, 34567,mAh, 28.5,kW, 23,C"  )); //use comma for easy parsing
     Serial.print(F("\n"                                                             ));
-    Serial.print(String( adc_getLatestBatteryCurrent_amps()                         ));
+    Serial.print(        adc_getLatestBatteryCurrent_amps()                          );
     Serial.print(F(     ","                                                         ));
-    Serial.print(String( adc_getLatestSpoofedCurrent_amps()                         ));
+    Serial.print(        adc_getLatestSpoofedCurrent_amps()                          );
     Serial.print(F(         ",A, "                                                  ));
-    Serial.print(String( LTC68042result_packVoltage_get()                           ));
+    Serial.print(        LTC68042result_packVoltage_get()                            );
     Serial.print(F(                ","                                              ));
-    Serial.print(String( vPackSpoof_getSpoofedPackVoltage()                         ));
+    Serial.print(        vPackSpoof_getSpoofedPackVoltage()                          );
     Serial.print(F(                    ",V, "                                       ));
-    Serial.print(String( (LTC68042result_hiCellVoltage_get() * 0.0001), 3           ));
+    printFormat_fixedPoint(Serial, LTC68042result_hiCellVoltage_get(), 4, 3          );
     Serial.print(F(                            ","                                  ));
-    Serial.print(String( (LTC68042result_loCellVoltage_get() * 0.0001), 3           ));
+    printFormat_fixedPoint(Serial, LTC68042result_loCellVoltage_get(), 4, 3          );
     Serial.print(F(                                 ",V, "                          ));
-    Serial.print(String( SoC_getBatteryStateNow_mAh()                               ));
+    Serial.print(        SoC_getBatteryStateNow_mAh()                                );
     Serial.print(F(                                          ",mAh, "               ));
-    Serial.print(String( (LTC68042result_packVoltage_get() * adc_getLatestBatteryCurrent_amps() * 0.001), 1 ));
+    printFormat_fixedPoint(Serial, (int32_t)LTC68042result_packVoltage_get() * adc_getLatestBatteryCurrent_amps(), 3, 1); //watts -> kW
     Serial.print(F(                                                    ",kW, "      ));
-    Serial.print(String( temperature_battery_getLatest()                            ));
+    Serial.print(        (int16_t)temperature_battery_getLatest()                    );
     Serial.print(F(                                                           ",C " ));
 
     transmitStatus = NOT_TRANSMITTING_LARGE_MESSAGE;
@@ -163,7 +163,7 @@ void debugUSB_printData_power(void)
 void debugUSB_printData_BATTMETSCI(void)
 {
     transmitStatus = NOT_TRANSMITTING_LARGE_MESSAGE;
-    //BATTSCI and METSCI are printed per-byte within functions METSCI_readByte() and BATTSCI_writeByte()
+    //BATTSCI is printed per-frame within function BATTSCI_sendFrames() //METSCI is printed per-frame within function METSCI_processLatestFrame()
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -173,11 +173,11 @@ void debugUSB_printData_cellVoltages(void)
     static uint8_t icToPrint = 0; //first IC's data is stored in the 0th array element, regardless of the first IC's actual address (e.g. 0x2),
 
     Serial.print(F("\nIC"));
-    Serial.print(String(icToPrint));
+    Serial.print(icToPrint);
     for (uint8_t cellToPrint = 0; cellToPrint < CELLS_PER_IC; cellToPrint++)
     {
         Serial.print(',');
-        Serial.print( String( LTC68042result_specificCellVoltage_get(icToPrint,cellToPrint) * 0.0001, FOUR_DECIMAL_PLACES) );
+        printFormat_fixedPoint(Serial, LTC68042result_specificCellVoltage_get(icToPrint,cellToPrint), 4, FOUR_DECIMAL_PLACES);
     }
 
     if (++icToPrint < TOTAL_IC) { transmitStatus = TRANSMITTING_LARGE_MESSAGE; }
@@ -189,15 +189,15 @@ void debugUSB_printData_cellVoltages(void)
 void debugUSB_printData_temperatures(void)
 {
     Serial.print(F("\nT_batt:"));
-    Serial.print(String(temperature_battery_getLatest()));
+    Serial.print((int16_t)temperature_battery_getLatest());
     Serial.print(F(", T_in:"));
-    Serial.print(String(temperature_intake_getLatest()));
+    Serial.print((int16_t)temperature_intake_getLatest());
     Serial.print(F(", T_out:"));
-    Serial.print(String(temperature_exhaust_getLatest()));
+    Serial.print((int16_t)temperature_exhaust_getLatest());
     Serial.print(F(", T_charger:"));
-    Serial.print(String(temperature_gridCharger_getLatest()));
+    Serial.print((int16_t)temperature_gridCharger_getLatest());
     Serial.print(F(", T_bay:"));
-    Serial.print(String(temperature_ambient_getLatest()));
+    Serial.print((int16_t)temperature_ambient_getLatest());
     Serial.print('C');
 }
 
@@ -229,6 +229,18 @@ void debugUSB_printLatestData(void)
     //this will overflow serial transmit buffer if too much data transmitted //necessary to capture all debug data, even though timing may exceed loopPeriod_ms
     if (debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_DEBUG) { debugUSB_printData_debug(); }
 
+    //binary records are only sent if they fit in the serial transmit buffer
+    else if (debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BINARY)
+    {
+        if ((uint32_t)(millis() - previousMillis) >= debugUSB_dataUpdatePeriod_ms_get())
+        {
+            previousMillis = millis();
+            telemetry_startNewSampleSet();
+        }
+
+        telemetry_sendPendingRecords();
+    }
+
     //print message if it's time and there's room in the serial transmit buffer
     else if ( ( ((uint32_t)(millis() - previousMillis) >= debugUSB_dataUpdatePeriod_ms_get()) || (transmitStatus == TRANSMITTING_LARGE_MESSAGE) ) &&
         (Serial.availableForWrite() > 62) )
@@ -279,15 +291,14 @@ void debugUSB_printConfigParameters(void)
         Serial.print(F("/60S"));
     #endif
 
-    #ifdef        VOLTAGE_SPOOFING_DISABLE
-        Serial.print(F("/Vs=off"));
-    #elif defined VOLTAGE_SPOOFING_ASSIST_ONLY_VARIABLE
-        Serial.print(F("/Vs=ast"));
-    #elif defined VOLTAGE_SPOOFING_ASSIST_ONLY_BINARY
-        Serial.print(F("/Vs=bin"));
-    #elif defined VOLTAGE_SPOOFING_ASSIST_AND_REGEN
-        Serial.print(F("/Vs=all"));
-    #endif
+    switch (params_get(PARAM_VSPOOF_MODE))
+    {
+        case VSPOOF_MODE_DISABLE:              Serial.print(F("/Vs=off")); break;
+        case VSPOOF_MODE_ASSIST_ONLY_VARIABLE: Serial.print(F("/Vs=ast")); break;
+        case VSPOOF_MODE_ASSIST_ONLY_BINARY:   Serial.print(F("/Vs=bin")); break;
+        case VSPOOF_MODE_ASSIST_AND_REGEN:     Serial.print(F("/Vs=all")); break;
+        case VSPOOF_MODE_LINEAR:               Serial.print(F("/Vs=lin")); break;
+    }
 
     Serial.print(F("/Heat:"));
     if (heater_isConnected() == HEATER_NOT_CONNECTED) { Serial.print('N'); }
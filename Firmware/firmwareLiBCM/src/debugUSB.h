@@ -34,6 +34,7 @@
     #define DEBUGUSB_STREAM_TEMP       0x44
     #define DEBUGUSB_STREAM_DEBUG      0x55
     #define DEBUGUSB_STREAM_NONE       0x66
+    #define DEBUGUSB_STREAM_BINARY     0x77 //see telemetry.h
 
     #define TRANSMITTING_LARGE_MESSAGE     0x66
     #define NOT_TRANSMITTING_LARGE_MESSAGE 0x55
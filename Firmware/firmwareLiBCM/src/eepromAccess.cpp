@@ -1,17 +1,17 @@
 //JTS2doLater: eeprom.c isn't wrapped into MVP yet 
 
-#include <EEPROM.h>
 #include "libcm.h"
 
 //atmega2560 has 4kB EEPROM
 //eeprom  read halts CPU for QTY4 cycles
 //eeprom write halts CPU for QTY2 cycles and takes ~3.3 ms to complete
+//writes are queued, then the EEPROM ready ISR writes them in the background (see eeprom_writeByte())
 
 //JTS2doLater: does Arduino implement 2560 brownout detector?
 
 //store the date and time customer compiled the source code in program memory
-const uint8_t COMPILE_DATE_PROGRAM[BYTES_IN_DATE] = __DATE__; //Format: 'Mmm DD YYYY' //Ex: 'Jan 23 2022' //'Mar  5 2022'
-const uint8_t COMPILE_TIME_PROGRAM[BYTES_IN_TIME] = __TIME__; //Format: 'HH:MM:SS'    //Ex: '16:30:31'
+const uint8_t COMPILE_DATE_PROGRAM[BYTES_IN_DATE] PROGMEM = __DATE__; //Format: 'Mmm DD YYYY' //Ex: 'Jan 23 2022' //'Mar  5 2022'
+const uint8_t COMPILE_TIME_PROGRAM[BYTES_IN_TIME] PROGMEM = __TIME__; //Format: 'HH:MM:SS'    //Ex: '16:30:31'
 
 const uint16_t EEPROM_LAST_USABLE_ADDRESS         = 0xF9F; //atmega2560 has 4kB EEPROM
 
@@ -24,6 +24,15 @@ const uint16_t EEPROM_ADDRESS_BATTSCI_ASSIST      = 0x010; //EEPROM range is 0x0
 const uint16_t EEPROM_ADDRESS_KEYON_DELAY         = 0x011; //EEPROM range is 0x011:0x011 ( 1B)
 const uint16_t EEPROM_ADDRESS_unused              = 0x012; //EEPROM range is 0x012:0x012 ( 1B)
 const uint16_t EEPROM_ADDRESS_COMPILE_TIME        = 0x013; //EEPROM range is 0x013:0x01B ( 9B)
+const uint16_t EEPROM_ADDRESS_LEARNED_CAPACITY    = 0x01C; //EEPROM range is 0x01C:0x01D ( 2B)
+const uint16_t EEPROM_ADDRESS_SoC_SNAPSHOT_RING   = 0x020; //EEPROM range is 0x020:0x11F (256B) //see eeprom_SoCsnapshot_save()
+const uint16_t EEPROM_ADDRESS_BALANCE_HISTORY     = 0x120; //EEPROM range is 0x120:0x197 (120B when 60S) //minutes each cell has discharged
+const uint16_t EEPROM_ADDRESS_BUS_STATS           = 0x198; //EEPROM range is 0x198:0x1D7 ( 64B) //serial bus stats from latest drive
+const uint16_t EEPROM_ADDRESS_BATT_HISTORY_MERGED = 0x1D8; //EEPROM range is 0x1D8:0x1DA ( 3B) //newest journal sequence added to battery history table
+const uint16_t EEPROM_ADDRESS_BATT_JOURNAL        = 0x1E0; //EEPROM range is 0x1E0:0x2DF (256B) //see eeprom_batteryHistory_appendHours()
+const uint16_t EEPROM_ADDRESS_PARAMS              = 0x2E0; //EEPROM range is 0x2E0:0x33F ( 96B) //runtime parameters (see params.cpp)
+const uint16_t EEPROM_ADDRESS_FLIGHT_RECORDER     = 0x340; //EEPROM range is 0x340:0x74F (1040B) //latest flight recorder capture (see flightRecorder.cpp)
+const uint16_t EEPROM_ADDRESS_RESET_HISTORY      = 0x750; //EEPROM range is 0x750:0x7CF (128B) //see eeprom_resetHistory_save()
 //this EEPROM space still available
 const uint16_t EEPROM_ADDRESS_BATT_HISTORY = EEPROM_LAST_USABLE_ADDRESS - NUM_BYTES_BATTERY_HISTORY; //stored last
 const uint16_t EEPROM_ADDRESS_BATT_HISTORY_UNINITIALIZED = EEPROM_ADDRESS_BATT_HISTORY - 1; //0xFF if updating from old version
@@ -32,13 +41,211 @@ const uint16_t EEPROM_ADDRESS_BATT_HISTORY_UNINITIALIZED = EEPROM_ADDRESS_BATT_H
 uint8_t compileDateEEPROM[BYTES_IN_DATE] = {}; //JTS2doLater: Move these into single function (to save RAM)
 uint8_t compileTimeEEPROM[BYTES_IN_TIME] = {};
 
+//values read every loop are cached in RAM, so they're never blocked by an EEPROM write in progress
+uint8_t  firmwareStatus = FIRMWARE_UNEXPIRED;
+uint16_t uptimeStoredInEEPROM_hours = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//EEPROM write queue
+//previously each write busy-waited ~3.3 ms for the previous write to finish (e.g. SoC snapshot blocked loop for ~27 ms)
+//now each write is added to this queue, then EE_READY ISR writes the oldest byte each time EEPROM finishes the previous write
+// -a write to an address already in the queue replaces the queued value (coalescing)
+// -writes are skipped if EEPROM already contains the value (same as EEPROM.update())
+// -eeprom_readByte() returns the queued value if that address hasn't been written yet
+//the queued byte being written (eeprom_isWriting == YES) stays in the queue until EEPROM finishes writing it
+
+struct eepromWrite
+{
+    uint16_t address;
+    uint8_t data;
+};
+
+eepromWrite eeprom_queue[EEPROM_QUEUE_SIZE];
+volatile uint8_t eeprom_queue_head = 0; //next write added here
+volatile uint8_t eeprom_queue_tail = 0; //oldest write (being written if eeprom_isWriting == YES)
+volatile bool    eeprom_isWriting = NO;
+
+volatile uint16_t eeprom_bytesWritten = 0; //since boot
+volatile uint16_t eeprom_bytesSkipped = 0; //EEPROM already contained this value
+uint16_t eeprom_bytesCoalesced = 0; //queued value replaced before it was written
+uint8_t  eeprom_queueHighWater = 0;
+uint32_t eeprom_blockedTime_us = 0; //waiting for queue space, reading EEPROM, or waiting for queue to empty
+
+uint16_t eeprom_bytesWritten_get(void)   { noInterrupts(); uint16_t count = eeprom_bytesWritten; interrupts(); return count; }
+uint16_t eeprom_bytesSkipped_get(void)   { noInterrupts(); uint16_t count = eeprom_bytesSkipped; interrupts(); return count; }
+uint16_t eeprom_bytesCoalesced_get(void) { return eeprom_bytesCoalesced; }
+uint8_t  eeprom_queueHighWater_get(void) { return eeprom_queueHighWater; }
+uint32_t eeprom_blockedTime_us_get(void) { return eeprom_blockedTime_us; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST be called with interrupts disabled //EEPE must be clear
+uint8_t eeprom_readHardware(uint16_t address)
+{
+    EEAR = address;
+    EECR |= (1 << EERE);
+    return EEDR;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+ISR(EE_READY_vect)
+{
+    if (eeprom_isWriting == YES)
+    {
+        //previous write finished
+        eeprom_queue_tail = (eeprom_queue_tail + 1) & (EEPROM_QUEUE_SIZE - 1);
+        eeprom_isWriting = NO;
+        if (eeprom_bytesWritten < 0xFFFF) { eeprom_bytesWritten++; }
+    }
+
+    while (eeprom_queue_tail != eeprom_queue_head)
+    {
+        eepromWrite *nextWrite = &eeprom_queue[eeprom_queue_tail];
+
+        if (eeprom_readHardware(nextWrite->address) == nextWrite->data)
+        {
+            //EEPROM already contains this value
+            eeprom_queue_tail = (eeprom_queue_tail + 1) & (EEPROM_QUEUE_SIZE - 1);
+            if (eeprom_bytesSkipped < 0xFFFF) { eeprom_bytesSkipped++; }
+        }
+        else
+        {
+            EEDR = nextWrite->data; //EEAR already set
+            EECR = (1 << EERIE) | (1 << EEMPE); //erase & write (EEPMn = 0)
+            EECR |= (1 << EEPE); //MUST occur within 4 cycles of setting EEMPE
+            eeprom_isWriting = YES;
+            return;
+        }
+    }
+
+    EECR &= ~(1 << EERIE); //queue empty
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void eeprom_logBlockedTime(uint32_t waitStart_us) { eeprom_blockedTime_us += micros() - waitStart_us; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns the queued value (if 'address' hasn't been written yet), else the value stored in EEPROM
+//only waits if EEPROM is writing a different address (up to ~3.3 ms)
+//MUST NOT be called with interrupts disabled
+uint8_t eeprom_readByte(uint16_t address)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    //search newest to oldest
+    for (uint8_t index = eeprom_queue_head; index != eeprom_queue_tail; )
+    {
+        index = (index - 1) & (EEPROM_QUEUE_SIZE - 1);
+        if (eeprom_queue[index].address == address) { uint8_t data = eeprom_queue[index].data; SREG = oldSREG; return data; }
+    }
+
+    if (EECR & (1 << EEPE))
+    {
+        //EEPROM is writing another address
+        uint32_t waitStart_us = micros();
+        EECR &= ~(1 << EERIE); //prevent ISR from starting the next write
+        SREG = oldSREG;
+        while (EECR & (1 << EEPE)) { ; } //other interrupts still run while waiting
+        noInterrupts();
+        eeprom_logBlockedTime(waitStart_us);
+    }
+
+    uint8_t data = eeprom_readHardware(address);
+
+    if (eeprom_queue_tail != eeprom_queue_head) { EECR |= (1 << EERIE); } //ISR finishes previous write, then starts next write
+
+    SREG = oldSREG;
+
+    return data;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//queues 'data' //waits if queue is full
+//MUST NOT be called with interrupts disabled
+void eeprom_writeByte(uint16_t address, uint8_t data)
+{
+    noInterrupts();
+
+    //coalesce with queued write to same address (unless EEPROM is already writing it)
+    uint8_t oldestUnwritten = eeprom_queue_tail;
+    if (eeprom_isWriting == YES) { oldestUnwritten = (oldestUnwritten + 1) & (EEPROM_QUEUE_SIZE - 1); }
+
+    for (uint8_t index = oldestUnwritten; index != eeprom_queue_head; index = (index + 1) & (EEPROM_QUEUE_SIZE - 1))
+    {
+        if (eeprom_queue[index].address == address)
+        {
+            eeprom_queue[index].data = data;
+            eeprom_bytesCoalesced++;
+            interrupts();
+            return;
+        }
+    }
+
+    //skip unchanged value (if it can be read without waiting)
+    if ((eeprom_queue_tail == eeprom_queue_head) && !(EECR & (1 << EEPE)) && (eeprom_readHardware(address) == data))
+    {
+        if (eeprom_bytesSkipped < 0xFFFF) { eeprom_bytesSkipped++; }
+        interrupts();
+        return;
+    }
+
+    uint8_t nextHead = (eeprom_queue_head + 1) & (EEPROM_QUEUE_SIZE - 1);
+    if (nextHead == eeprom_queue_tail)
+    {
+        //queue full
+        uint32_t waitStart_us = micros();
+        interrupts();
+        while (nextHead == eeprom_queue_tail) { ; } //ISR removes oldest write within ~3.3 ms
+        noInterrupts();
+        eeprom_logBlockedTime(waitStart_us);
+    }
+
+    eeprom_queue[eeprom_queue_head].address = address;
+    eeprom_queue[eeprom_queue_head].data = data;
+    eeprom_queue_head = nextHead;
+
+    uint8_t bytesQueued = (eeprom_queue_head - eeprom_queue_tail) & (EEPROM_QUEUE_SIZE - 1);
+    if (bytesQueued > eeprom_queueHighWater) { eeprom_queueHighWater = bytesQueued; }
+
+    EECR |= (1 << EERIE); //ISR fires once EEPROM is ready
+
+    interrupts();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool eeprom_isIdle(void)
+{
+    noInterrupts();
+    bool isIdle = ((eeprom_queue_tail == eeprom_queue_head) && !(EECR & (1 << EEPE)));
+    interrupts();
+
+    return isIdle;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call before LiBCM turns off //takes up to ~110 ms (full queue)
+void eeprom_waitUntilIdle(void)
+{
+    uint32_t waitStart_us = micros();
+    while (eeprom_isIdle() == NO) { ; }
+    eeprom_logBlockedTime(waitStart_us);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 uint16_t readFromEEPROM_uint16(uint16_t startAddress)
 {
     uint16_t valueFromEEPROM_uint16 = 0;
-    valueFromEEPROM_uint16 =  ( EEPROM.read(startAddress    ) << 8 ); //retrieve upper byte
-    valueFromEEPROM_uint16 += ( EEPROM.read(startAddress + 1)      ); //retrieve lower byte
+    valueFromEEPROM_uint16 =  ( eeprom_readByte(startAddress    ) << 8 ); //retrieve upper byte
+    valueFromEEPROM_uint16 += ( eeprom_readByte(startAddress + 1)      ); //retrieve lower byte
 
     return valueFromEEPROM_uint16;
 }
@@ -47,8 +254,8 @@ uint16_t readFromEEPROM_uint16(uint16_t startAddress)
 
 void writeToEEPROM_uint16(uint16_t startAddress, uint16_t value)
 {
-    EEPROM.update( startAddress    , highByte(value) );
-    EEPROM.update( startAddress + 1,  lowByte(value) );
+    eeprom_writeByte( startAddress    , highByte(value) );
+    eeprom_writeByte( startAddress + 1,  lowByte(value) );
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -56,8 +263,8 @@ void writeToEEPROM_uint16(uint16_t startAddress, uint16_t value)
 //copy compile date and time into RAM (stored in array compileDateEEPROM[]) //Example: "Jan 23 2022"
 void compileTimestamp_loadFromEEPROM(void)
 {
-    for (int ii = 0; ii < BYTES_IN_DATE; ii++) { compileDateEEPROM[ii] = EEPROM.read(ii + EEPROM_ADDRESS_COMPILE_DATE); }  
-    for (int ii = 0; ii < BYTES_IN_TIME; ii++) { compileTimeEEPROM[ii] = EEPROM.read(ii + EEPROM_ADDRESS_COMPILE_TIME); }  
+    for (int ii = 0; ii < BYTES_IN_DATE; ii++) { compileDateEEPROM[ii] = eeprom_readByte(ii + EEPROM_ADDRESS_COMPILE_DATE); }  
+    for (int ii = 0; ii < BYTES_IN_TIME; ii++) { compileTimeEEPROM[ii] = eeprom_readByte(ii + EEPROM_ADDRESS_COMPILE_TIME); }  
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -66,8 +273,8 @@ void compileTimestamp_loadFromEEPROM(void)
 //Limit calls to this function (EEPROM has limited write lifetime)
 void compileTimestamp_writeToEEPROM(void)
 {
-    for (int ii = 0; ii < BYTES_IN_DATE; ii++) { EEPROM.update( (ii + EEPROM_ADDRESS_COMPILE_DATE), COMPILE_DATE_PROGRAM[ii] ); }
-    for (int ii = 0; ii < BYTES_IN_TIME; ii++) { EEPROM.update( (ii + EEPROM_ADDRESS_COMPILE_TIME), COMPILE_TIME_PROGRAM[ii] ); }
+    for (int ii = 0; ii < BYTES_IN_DATE; ii++) { eeprom_writeByte( (ii + EEPROM_ADDRESS_COMPILE_DATE), pgm_read_byte(&COMPILE_DATE_PROGRAM[ii]) ); }
+    for (int ii = 0; ii < BYTES_IN_TIME; ii++) { eeprom_writeByte( (ii + EEPROM_ADDRESS_COMPILE_TIME), pgm_read_byte(&COMPILE_TIME_PROGRAM[ii]) ); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -82,12 +289,12 @@ bool wasFirmwareJustUpdated(void)
 
     for (uint8_t ii = 0; ii < BYTES_IN_DATE; ii++)
     {
-        if (compileDateEEPROM[ii] != COMPILE_DATE_PROGRAM[ii]) { areDatesIdentical = false; }
+        if (compileDateEEPROM[ii] != pgm_read_byte(&COMPILE_DATE_PROGRAM[ii])) { areDatesIdentical = false; }
     }
 
     for (uint8_t ii = 0; ii < BYTES_IN_TIME; ii++)
     {
-        if (compileTimeEEPROM[ii] != COMPILE_TIME_PROGRAM[ii]) { areDatesIdentical = false; }
+        if (compileTimeEEPROM[ii] != pgm_read_byte(&COMPILE_TIME_PROGRAM[ii])) { areDatesIdentical = false; }
     }
   
     if (areDatesIdentical == true) { return false; } //firmware NOT updated
@@ -96,10 +303,7 @@ bool wasFirmwareJustUpdated(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint16_t eeprom_uptimeStoredInEEPROM_hours_get(void)
-{
-    return readFromEEPROM_uint16(EEPROM_ADDRESS_HOURS_SINCE_UPDATE);
-}
+uint16_t eeprom_uptimeStoredInEEPROM_hours_get(void) { return uptimeStoredInEEPROM_hours; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -107,23 +311,34 @@ uint16_t eeprom_uptimeStoredInEEPROM_hours_get(void)
 //Limit calls to this function (EEPROM has limited write lifetime)
 void uptimeStoredInEEPROM_hours_set(uint16_t hourCount)
 {
+    uptimeStoredInEEPROM_hours = hourCount;
     writeToEEPROM_uint16(EEPROM_ADDRESS_HOURS_SINCE_UPDATE, hourCount);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //JTS2doNext: only read eeprom status once per keyOn event (so it won't expire while car is running`)
-//Takes 4 clock cycles.  EEPROM read limit: infinite
-uint8_t eeprom_expirationStatus_get(void)
-{ 
-    //structured this way to prevent EEPROM read/write failures from disabling LiBCM
-    if ((EEPROM.read(EEPROM_ADDRESS_FIRMWARE_STATUS)) == FIRMWARE_EXPIRED) { return FIRMWARE_EXPIRED;   }
-    else                                                                   { return FIRMWARE_UNEXPIRED; }          
+//called every loop, so status is cached in RAM (see eeprom_begin())
+uint8_t eeprom_expirationStatus_get(void) { return firmwareStatus; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void EEPROM_expirationStatus_set(uint8_t newFirmwareStatus)
+{
+    firmwareStatus = newFirmwareStatus;
+    eeprom_writeByte(EEPROM_ADDRESS_FIRMWARE_STATUS, newFirmwareStatus);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void EEPROM_expirationStatus_set(uint8_t newFirmwareStatus) { EEPROM.update(EEPROM_ADDRESS_FIRMWARE_STATUS, newFirmwareStatus); }
+void eeprom_loadCachedValues(void)
+{
+    //structured this way to prevent EEPROM read/write failures from disabling LiBCM
+    if (eeprom_readByte(EEPROM_ADDRESS_FIRMWARE_STATUS) == FIRMWARE_EXPIRED) { firmwareStatus = FIRMWARE_EXPIRED;   }
+    else                                                                     { firmwareStatus = FIRMWARE_UNEXPIRED; }
+
+    uptimeStoredInEEPROM_hours = readFromEEPROM_uint16(EEPROM_ADDRESS_HOURS_SINCE_UPDATE);
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -177,16 +392,301 @@ void eeprom_checkForExpiredFirmware(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t eeprom_hasLibcmDisabledAssist_get(void) { return EEPROM.read(EEPROM_ADDRESS_BATTSCI_ASSIST); }
-void    eeprom_hasLibcmDisabledAssist_set(uint8_t wasAssistLimited) { EEPROM.update(EEPROM_ADDRESS_BATTSCI_ASSIST, wasAssistLimited); }
+uint8_t eeprom_hasLibcmDisabledAssist_get(void) { return eeprom_readByte(EEPROM_ADDRESS_BATTSCI_ASSIST); }
+void    eeprom_hasLibcmDisabledAssist_set(uint8_t wasAssistLimited) { eeprom_writeByte(EEPROM_ADDRESS_BATTSCI_ASSIST, wasAssistLimited); }
+
+uint8_t eeprom_hasLibcmDisabledRegen_get(void) { return eeprom_readByte(EEPROM_ADDRESS_BATTSCI_REGEN); }
+void    eeprom_hasLibcmDisabledRegen_set(uint8_t wasRegenLimited) { eeprom_writeByte(EEPROM_ADDRESS_BATTSCI_REGEN, wasRegenLimited); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t eeprom_hasLibcmDisabledRegen_get(void) { return EEPROM.read(EEPROM_ADDRESS_BATTSCI_REGEN); }
-void    eeprom_hasLibcmDisabledRegen_set(uint8_t wasRegenLimited) { EEPROM.update(EEPROM_ADDRESS_BATTSCI_REGEN, wasRegenLimited); }
+uint8_t eeprom_delayKeyON_ms_get(void) { return eeprom_readByte(EEPROM_ADDRESS_KEYON_DELAY); }
+void    eeprom_delayKeyON_ms_set(uint8_t delay_ms) { eeprom_writeByte(EEPROM_ADDRESS_KEYON_DELAY, delay_ms); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t eeprom_delayKeyON_ms_get(void) { return EEPROM.read(EEPROM_ADDRESS_KEYON_DELAY); }
-void    eeprom_delayKeyON_ms_set(uint8_t delay_ms) { EEPROM.update(EEPROM_ADDRESS_KEYON_DELAY, delay_ms); }
+uint16_t eeprom_learnedCapacity_mAh_get(void) { return readFromEEPROM_uint16(EEPROM_ADDRESS_LEARNED_CAPACITY); }
+void     eeprom_learnedCapacity_mAh_set(uint16_t capacity_mAh) { writeToEEPROM_uint16(EEPROM_ADDRESS_LEARNED_CAPACITY, capacity_mAh); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//CRC-8 (polynomial 0x07)
+uint8_t eeprom_calculateCRC8(const uint8_t data[], uint8_t numBytes)
+{
+    uint8_t crc = 0;
+
+    for (uint8_t ii = 0; ii < numBytes; ii++)
+    {
+        crc ^= data[ii];
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            if (crc & 0x80) { crc = (crc << 1) ^ 0x07; }
+            else            { crc = (crc << 1);        }
+        }
+    }
+
+    return crc;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//SoC snapshot ring
+//each save is written to the next record, which spreads EEPROM wear across all records
+//the newest record is the valid record with the largest sequence number
+//record format (8B): sequence(2B), packCharge_mAh(2B), uptime_hours(2B), version(1B), CRC8(1B)
+
+uint8_t  snapshot_newestRecord = SoC_SNAPSHOT_NUM_RECORDS - 1; //first save goes to record 0 if ring is empty
+uint16_t snapshot_newestSequence = 0; //total saves since EEPROM was erased
+uint16_t snapshot_savesSinceBoot = 0;
+
+uint16_t eeprom_SoCsnapshot_savesSinceBoot_get(void) { return snapshot_savesSinceBoot; }
+uint16_t eeprom_SoCsnapshot_savesTotal_get(void)     { return snapshot_newestSequence; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns YES if record is valid
+bool SoCsnapshot_readRecord(uint8_t recordIndex, uint8_t record[])
+{
+    uint16_t address = EEPROM_ADDRESS_SoC_SNAPSHOT_RING + (recordIndex * SoC_SNAPSHOT_RECORD_BYTES);
+
+    for (uint8_t ii = 0; ii < SoC_SNAPSHOT_RECORD_BYTES; ii++) { record[ii] = eeprom_readByte(address + ii); }
+
+    if ( (record[6] == SoC_SNAPSHOT_RECORD_VERSION) &&
+         (record[7] == eeprom_calculateCRC8(record, SoC_SNAPSHOT_RECORD_BYTES - 1)) ) { return YES; }
+    else                                                                                { return NO;  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call once at boot (finds where the next snapshot is saved)
+//returns YES if a valid snapshot exists
+bool eeprom_SoCsnapshot_findNewest(uint16_t *packCharge_mAh, uint16_t *uptime_hours)
+{
+    bool isValidRecordFound = NO;
+    uint8_t record[SoC_SNAPSHOT_RECORD_BYTES];
+
+    for (uint8_t ii = 0; ii < SoC_SNAPSHOT_NUM_RECORDS; ii++)
+    {
+        if (SoCsnapshot_readRecord(ii, record) == YES)
+        {
+            uint16_t sequence = (record[0] << 8) + record[1];
+
+            //signed difference handles sequence rollover
+            if ((isValidRecordFound == NO) || ((int16_t)(sequence - snapshot_newestSequence) > 0))
+            {
+                isValidRecordFound = YES;
+                snapshot_newestSequence = sequence;
+                snapshot_newestRecord = ii;
+                *packCharge_mAh = (record[2] << 8) + record[3];
+                *uptime_hours   = (record[4] << 8) + record[5];
+            }
+        }
+    }
+
+    return isValidRecordFound;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//queues 8 bytes (returns immediately; EE_READY ISR writes them in the background)
+void eeprom_SoCsnapshot_save(uint16_t packCharge_mAh, uint16_t uptime_hours)
+{
+    if (++snapshot_newestRecord >= SoC_SNAPSHOT_NUM_RECORDS) { snapshot_newestRecord = 0; }
+    snapshot_newestSequence++;
+
+    uint8_t record[SoC_SNAPSHOT_RECORD_BYTES];
+    record[0] = highByte(snapshot_newestSequence);
+    record[1] =  lowByte(snapshot_newestSequence);
+    record[2] = highByte(packCharge_mAh);
+    record[3] =  lowByte(packCharge_mAh);
+    record[4] = highByte(uptime_hours);
+    record[5] =  lowByte(uptime_hours);
+    record[6] = SoC_SNAPSHOT_RECORD_VERSION;
+    record[7] = eeprom_calculateCRC8(record, SoC_SNAPSHOT_RECORD_BYTES - 1);
+
+    //CRC is written last, so a partially written record is invalid (e.g. if LiBCM turns off mid-write)
+    uint16_t address = EEPROM_ADDRESS_SoC_SNAPSHOT_RING + (snapshot_newestRecord * SoC_SNAPSHOT_RECORD_BYTES);
+    for (uint8_t ii = 0; ii < SoC_SNAPSHOT_RECORD_BYTES; ii++) { eeprom_writeByte(address + ii, record[ii]); }
+
+    snapshot_savesSinceBoot++;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//balance history stores one uint16 per cell
+uint16_t convert_cellNumberToBalanceHistoryAddress(uint8_t ic, uint8_t cell)
+{
+    return EEPROM_ADDRESS_BALANCE_HISTORY + (((ic * CELLS_PER_IC) + cell) * 2);
+}
+
+uint16_t eeprom_balanceHistory_minutes_get(uint8_t ic, uint8_t cell) { return readFromEEPROM_uint16(convert_cellNumberToBalanceHistoryAddress(ic, cell)); }
+void     eeprom_balanceHistory_minutes_set(uint8_t ic, uint8_t cell, uint16_t minutes) { writeToEEPROM_uint16(convert_cellNumberToBalanceHistoryAddress(ic, cell), minutes); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void eeprom_balanceHistory_reset(void)
+{
+    for (uint8_t ic = 0; ic < TOTAL_IC; ic++)
+    {
+        for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++) { eeprom_balanceHistory_minutes_set(ic, cell, 0); }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//CRC byte is stored after data
+void eeprom_busStats_save(const uint8_t data[], uint8_t numBytes)
+{
+    if (numBytes > EEPROM_BUS_STATS_MAX_BYTES) { return; }
+
+    for (uint8_t ii = 0; ii < numBytes; ii++) { eeprom_writeByte(EEPROM_ADDRESS_BUS_STATS + ii, data[ii]); }
+    eeprom_writeByte(EEPROM_ADDRESS_BUS_STATS + numBytes, eeprom_calculateCRC8(data, numBytes));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns NO if stats were never saved (or are corrupted)
+bool eeprom_busStats_load(uint8_t data[], uint8_t numBytes)
+{
+    if (numBytes > EEPROM_BUS_STATS_MAX_BYTES) { return NO; }
+
+    for (uint8_t ii = 0; ii < numBytes; ii++) { data[ii] = eeprom_readByte(EEPROM_ADDRESS_BUS_STATS + ii); }
+
+    return (eeprom_readByte(EEPROM_ADDRESS_BUS_STATS + numBytes) == eeprom_calculateCRC8(data, numBytes));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//CRC byte is stored after data
+void eeprom_params_save(const uint8_t data[], uint8_t numBytes)
+{
+    if (numBytes > EEPROM_PARAMS_MAX_BYTES) { return; }
+
+    for (uint8_t ii = 0; ii < numBytes; ii++) { eeprom_writeByte(EEPROM_ADDRESS_PARAMS + ii, data[ii]); }
+    eeprom_writeByte(EEPROM_ADDRESS_PARAMS + numBytes, eeprom_calculateCRC8(data, numBytes));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns NO if parameters were never saved (or are corrupted)
+bool eeprom_params_load(uint8_t data[], uint8_t numBytes)
+{
+    if (numBytes > EEPROM_PARAMS_MAX_BYTES) { return NO; }
+
+    for (uint8_t ii = 0; ii < numBytes; ii++) { data[ii] = eeprom_readByte(EEPROM_ADDRESS_PARAMS + ii); }
+
+    return (eeprom_readByte(EEPROM_ADDRESS_PARAMS + numBytes) == eeprom_calculateCRC8(data, numBytes));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//capture is written a few bytes at a time (see flightRecorder_handler())
+void eeprom_flightRecorder_writeByte(uint16_t offset, uint8_t data)
+{
+    if (offset < EEPROM_FLIGHTREC_MAX_BYTES) { eeprom_writeByte(EEPROM_ADDRESS_FLIGHT_RECORDER + offset, data); }
+}
+
+uint8_t eeprom_flightRecorder_readByte(uint16_t offset)
+{
+    if (offset < EEPROM_FLIGHTREC_MAX_BYTES) { return eeprom_readByte(EEPROM_ADDRESS_FLIGHT_RECORDER + offset); }
+    else                                     { return EEPROM_ADDRESS_FACTORY_DEFAULT_VALUE; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//reset history ring
+//same wear leveling scheme as SoC snapshot ring
+//record format (8B): sequence(2B), MCUSR(1B), task(1B), phase(1B), loopTime_ms(2B), CRC8(1B)
+
+uint8_t  resetHistory_newestRecord = RESET_HISTORY_NUM_RECORDS - 1; //first save goes to record 0 if ring is empty
+uint16_t resetHistory_newestSequence = 0; //total resets saved since EEPROM was erased
+
+uint16_t eeprom_resetHistory_total_get(void) { return resetHistory_newestSequence; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns YES if record is valid
+bool resetHistory_readRecord(uint8_t recordIndex, uint8_t record[])
+{
+    uint16_t address = EEPROM_ADDRESS_RESET_HISTORY + (recordIndex * RESET_HISTORY_RECORD_BYTES);
+
+    for (uint8_t ii = 0; ii < RESET_HISTORY_RECORD_BYTES; ii++) { record[ii] = eeprom_readByte(address + ii); }
+
+    return (record[7] == eeprom_calculateCRC8(record, RESET_HISTORY_RECORD_BYTES - 1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call once at boot (finds where the next reset is saved)
+void eeprom_resetHistory_begin(void)
+{
+    bool isValidRecordFound = NO;
+    uint8_t record[RESET_HISTORY_RECORD_BYTES];
+
+    for (uint8_t ii = 0; ii < RESET_HISTORY_NUM_RECORDS; ii++)
+    {
+        if (resetHistory_readRecord(ii, record) == YES)
+        {
+            uint16_t sequence = (record[0] << 8) + record[1];
+
+            //signed difference handles sequence rollover
+            if ((isValidRecordFound == NO) || ((int16_t)(sequence - resetHistory_newestSequence) > 0))
+            {
+                isValidRecordFound = YES;
+                resetHistory_newestSequence = sequence;
+                resetHistory_newestRecord = ii;
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void eeprom_resetHistory_save(uint8_t resetCause, uint8_t task, uint8_t phase, uint16_t loopTime_ms)
+{
+    if (++resetHistory_newestRecord >= RESET_HISTORY_NUM_RECORDS) { resetHistory_newestRecord = 0; }
+    resetHistory_newestSequence++;
+
+    uint8_t record[RESET_HISTORY_RECORD_BYTES];
+    record[0] = highByte(resetHistory_newestSequence);
+    record[1] =  lowByte(resetHistory_newestSequence);
+    record[2] = resetCause;
+    record[3] = task;
+    record[4] = phase;
+    record[5] = highByte(loopTime_ms);
+    record[6] =  lowByte(loopTime_ms);
+    record[7] = eeprom_calculateCRC8(record, RESET_HISTORY_RECORD_BYTES - 1);
+
+    //CRC is written last, so a partially written record is invalid
+    uint16_t address = EEPROM_ADDRESS_RESET_HISTORY + (resetHistory_newestRecord * RESET_HISTORY_RECORD_BYTES);
+    for (uint8_t ii = 0; ii < RESET_HISTORY_RECORD_BYTES; ii++) { eeprom_writeByte(address + ii, record[ii]); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//age '0' is the newest reset
+//returns NO if record doesn't exist (or is corrupted)
+bool eeprom_resetHistory_get(uint8_t age, uint16_t *sequence, uint8_t *resetCause, uint8_t *task, uint8_t *phase, uint16_t *loopTime_ms)
+{
+    if (age >= RESET_HISTORY_NUM_RECORDS) { return NO; }
+
+    uint8_t recordIndex = (resetHistory_newestRecord + RESET_HISTORY_NUM_RECORDS - age) % RESET_HISTORY_NUM_RECORDS;
+    uint8_t record[RESET_HISTORY_RECORD_BYTES];
+
+    if (resetHistory_readRecord(recordIndex, record) == NO) { return NO; }
+
+    *sequence    = (record[0] << 8) + record[1];
+    *resetCause  = record[2];
+    *task        = record[3];
+    *phase       = record[4];
+    *loopTime_ms = (record[5] << 8) + record[6];
+
+    //older records have smaller sequence numbers //otherwise the ring hasn't filled yet
+    if (*sequence != (uint16_t)(resetHistory_newestSequence - age)) { return NO; }
+
+    return YES;
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -212,6 +712,20 @@ void eeprom_verifyDataValid(void)
         Serial.print(F("\nRestoring EEPROM value: EEPROM_ADDRESS_KEYON_DELAY"));
         eeprom_delayKeyON_ms_set(0);
     }
+
+    //also catches battery type changes (e.g. 47Ah capacity stored, but 5AhG3 now selected)
+    if ( (eeprom_learnedCapacity_mAh_get() < SoC_CAPACITY_LEARNING_MIN_mAh) || (eeprom_learnedCapacity_mAh_get() > SoC_CAPACITY_LEARNING_MAX_mAh) )
+    {
+        Serial.print(F("\nRestoring EEPROM value: EEPROM_ADDRESS_LEARNED_CAPACITY"));
+        eeprom_learnedCapacity_mAh_set(STACK_mAh_NOM);
+    }
+
+    //erased EEPROM (e.g. first boot after update)
+    if (eeprom_balanceHistory_minutes_get(0, 0) == 0xFFFF)
+    {
+        Serial.print(F("\nRestoring EEPROM value: EEPROM_ADDRESS_BALANCE_HISTORY"));
+        eeprom_balanceHistory_reset();
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -242,13 +756,180 @@ uint16_t eeprom_batteryHistory_getValue(uint8_t indexTemperature, uint8_t indexS
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void eeprom_batteryHistory_incrementValue(uint8_t indexTemperature, uint8_t indexSoC)
+//Battery history journal
+//batteryHistory.cpp accumulates time in RAM, then appends whole hours to this journal (rather than the table)
+//each append is written to the next record, which spreads EEPROM wear across all records
+//pending records are added to the table when the journal fills up (or at keyOFF, see batteryHistory_save())...
+//so each table bin is written once per merge, rather than once per hour
+//record format (8B): sequence(2B), indexTemperature(1B), indexSoC(1B), hours(2B), version(1B), CRC8(1B)
+//a record is pending if it's valid and its sequence is newer than the merged sequence (stored with CRC8)
+
+uint8_t  batteryJournal_newestRecord = BATTERY_HISTORY_JOURNAL_NUM_RECORDS - 1; //first append goes to record 0 if journal is empty
+uint16_t batteryJournal_newestSequence = 0;
+uint16_t batteryJournal_mergedSequence = 0;
+uint8_t  batteryJournal_pendingRecords = 0;
+uint16_t batteryJournal_appendsSinceBoot = 0;
+
+uint8_t  eeprom_batteryHistory_journalPending_get(void)     { return batteryJournal_pendingRecords;   }
+uint16_t eeprom_batteryHistory_appendsSinceBoot_get(void)   { return batteryJournal_appendsSinceBoot; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns YES if record is valid
+bool batteryJournal_readRecord(uint8_t recordIndex, uint8_t record[])
 {
-    uint16_t address = convert_temperatureAndSoC_arrayIndexToEepromAddress(indexTemperature, indexSoC);
+    uint16_t address = EEPROM_ADDRESS_BATT_JOURNAL + (recordIndex * BATTERY_HISTORY_JOURNAL_RECORD_BYTES);
+
+    for (uint8_t ii = 0; ii < BATTERY_HISTORY_JOURNAL_RECORD_BYTES; ii++) { record[ii] = eeprom_readByte(address + ii); }
+
+    if ( (record[6] == BATTERY_HISTORY_JOURNAL_VERSION) &&
+         (record[7] == eeprom_calculateCRC8(record, BATTERY_HISTORY_JOURNAL_RECORD_BYTES - 1)) ) { return YES; }
+    else                                                                                         { return NO;  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool batteryJournal_isRecordPending(const uint8_t record[])
+{
+    uint16_t sequence = (record[0] << 8) + record[1];
+
+    return ((int16_t)(sequence - batteryJournal_mergedSequence) > 0); //signed difference handles sequence rollover
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns YES if this record hasn't been added to the table yet
+bool eeprom_batteryHistory_journalRecord_get(uint8_t recordIndex, uint8_t *indexTemperature, uint8_t *indexSoC, uint16_t *hours)
+{
+    uint8_t record[BATTERY_HISTORY_JOURNAL_RECORD_BYTES];
+
+    if (batteryJournal_readRecord(recordIndex, record) == NO) { return NO; }
+    if (batteryJournal_isRecordPending(record)        == NO) { return NO; }
+
+    *indexTemperature = record[2];
+    *indexSoC         = record[3];
+    *hours            = (record[4] << 8) + record[5];
+
+    return YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void batteryJournal_saveMergedSequence(void)
+{
+    uint8_t data[2] = { highByte(batteryJournal_mergedSequence), lowByte(batteryJournal_mergedSequence) };
+
+    eeprom_writeByte(EEPROM_ADDRESS_BATT_HISTORY_MERGED    , data[0]);
+    eeprom_writeByte(EEPROM_ADDRESS_BATT_HISTORY_MERGED + 1, data[1]);
+    eeprom_writeByte(EEPROM_ADDRESS_BATT_HISTORY_MERGED + 2, eeprom_calculateCRC8(data, 2));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call once at boot
+void eeprom_batteryHistory_journalBegin(void)
+{
+    bool isValidRecordFound = NO;
+    uint8_t record[BATTERY_HISTORY_JOURNAL_RECORD_BYTES];
 
-    uint16_t existingValue = readFromEEPROM_uint16(address);
+    for (uint8_t ii = 0; ii < BATTERY_HISTORY_JOURNAL_NUM_RECORDS; ii++)
+    {
+        if (batteryJournal_readRecord(ii, record) == YES)
+        {
+            uint16_t sequence = (record[0] << 8) + record[1];
+
+            if ((isValidRecordFound == NO) || ((int16_t)(sequence - batteryJournal_newestSequence) > 0))
+            {
+                isValidRecordFound = YES;
+                batteryJournal_newestSequence = sequence;
+                batteryJournal_newestRecord = ii;
+            }
+        }
+    }
+
+    uint8_t merged[3];
+    for (uint8_t ii = 0; ii < 3; ii++) { merged[ii] = eeprom_readByte(EEPROM_ADDRESS_BATT_HISTORY_MERGED + ii); }
+
+    if (merged[2] == eeprom_calculateCRC8(merged, 2)) { batteryJournal_mergedSequence = (merged[0] << 8) + merged[1]; }
+    else
+    {
+        //first boot with journal //anything already in the journal area isn't ours
+        batteryJournal_mergedSequence = batteryJournal_newestSequence;
+        batteryJournal_saveMergedSequence();
+    }
+
+    batteryJournal_pendingRecords = 0;
+    for (uint8_t ii = 0; ii < BATTERY_HISTORY_JOURNAL_NUM_RECORDS; ii++)
+    {
+        if ((batteryJournal_readRecord(ii, record) == YES) && (batteryJournal_isRecordPending(record) == YES)) { batteryJournal_pendingRecords++; }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//adds all pending journal records to the table
+//takes ~3.3 ms per changed table byte (typically one byte per pending record)
+//if LiBCM turns off mid-merge, the merged sequence isn't updated, so this merge is repeated at next boot (double counting some hours)
+void eeprom_batteryHistory_mergeJournal(void)
+{
+    uint8_t indexTemperature = 0;
+    uint8_t indexSoC = 0;
+    uint16_t hours = 0;
+
+    for (uint8_t ii = 0; ii < BATTERY_HISTORY_JOURNAL_NUM_RECORDS; ii++)
+    {
+        if (eeprom_batteryHistory_journalRecord_get(ii, &indexTemperature, &indexSoC, &hours) == YES)
+        {
+            uint16_t address = convert_temperatureAndSoC_arrayIndexToEepromAddress(indexTemperature, indexSoC);
+            uint16_t existingValue = readFromEEPROM_uint16(address);
+
+            if (existingValue != 0xFFFF)
+            {
+                if (existingValue > (BATTERY_HISTORY_MAX_HOURS - hours)) { existingValue = BATTERY_HISTORY_MAX_HOURS; }
+                else                                                     { existingValue += hours;                    }
+
+                writeToEEPROM_uint16(address, existingValue);
+            }
+        }
+    }
+
+    batteryJournal_mergedSequence = batteryJournal_newestSequence;
+    batteryJournal_saveMergedSequence();
+    batteryJournal_pendingRecords = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
 
-    if (existingValue != 0xFFFF) { writeToEEPROM_uint16(address, existingValue + 1); }
+//queues 8 bytes //plus a merge each time the journal fills up (can wait for queue space)
+void eeprom_batteryHistory_appendHours(uint8_t indexTemperature, uint8_t indexSoC, uint16_t hours)
+{
+    uint8_t nextRecord = batteryJournal_newestRecord + 1;
+    if (nextRecord >= BATTERY_HISTORY_JOURNAL_NUM_RECORDS) { nextRecord = 0; }
+
+    uint8_t record[BATTERY_HISTORY_JOURNAL_RECORD_BYTES];
+    if ((batteryJournal_readRecord(nextRecord, record) == YES) && (batteryJournal_isRecordPending(record) == YES))
+    {
+        eeprom_batteryHistory_mergeJournal(); //journal is full
+    }
+
+    batteryJournal_newestRecord = nextRecord;
+    batteryJournal_newestSequence++;
+
+    record[0] = highByte(batteryJournal_newestSequence);
+    record[1] =  lowByte(batteryJournal_newestSequence);
+    record[2] = indexTemperature;
+    record[3] = indexSoC;
+    record[4] = highByte(hours);
+    record[5] =  lowByte(hours);
+    record[6] = BATTERY_HISTORY_JOURNAL_VERSION;
+    record[7] = eeprom_calculateCRC8(record, BATTERY_HISTORY_JOURNAL_RECORD_BYTES - 1);
+
+    //CRC is written last, so a partially written record is invalid (e.g. if LiBCM turns off mid-write)
+    uint16_t address = EEPROM_ADDRESS_BATT_JOURNAL + (batteryJournal_newestRecord * BATTERY_HISTORY_JOURNAL_RECORD_BYTES);
+    for (uint8_t ii = 0; ii < BATTERY_HISTORY_JOURNAL_RECORD_BYTES; ii++) { eeprom_writeByte(address + ii, record[ii]); }
+
+    batteryJournal_pendingRecords++;
+    batteryJournal_appendsSinceBoot++;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -262,7 +943,7 @@ void eeprom_batteryHistory_reset(void)
 
     for (uint16_t address=minAddress; address<=maxAddress; address++)
     {
-        EEPROM.update(address, EEPROM_ADDRESS_FORMATTED_VALUE);
+        eeprom_writeByte(address, EEPROM_ADDRESS_FORMATTED_VALUE);
     
         Serial.print('.');
 
@@ -273,6 +954,11 @@ void eeprom_batteryHistory_reset(void)
         }
     }
 
+    //discard pending journal records
+    batteryJournal_mergedSequence = batteryJournal_newestSequence;
+    batteryJournal_saveMergedSequence();
+    batteryJournal_pendingRecords = 0;
+
     Serial.print(F("\nDone"));
 }
 
@@ -287,7 +973,7 @@ void eeprom_resetAll(void)
 
     for (uint16_t address=minAddress; address<=maxAddress; address++)
     {
-        EEPROM.update(address, EEPROM_ADDRESS_FACTORY_DEFAULT_VALUE);
+        eeprom_writeByte(address, EEPROM_ADDRESS_FACTORY_DEFAULT_VALUE);
     
         Serial.print('.');
 
@@ -298,6 +984,7 @@ void eeprom_resetAll(void)
         }
     }
 
+    eeprom_waitUntilIdle();
     Serial.print(F("\nDone. Rebooting."));
     while (1) { ; } //wait for watchdog reboot
 }
@@ -321,13 +1008,16 @@ void eeprom_resetAll_userConfirm(void)
 
 void eeprom_begin(void)
 {
+    eeprom_loadCachedValues();
     eeprom_verifyDataValid();
+    eeprom_batteryHistory_journalBegin(); //MUST run before eeprom_batteryHistory_reset()
+    eeprom_resetHistory_begin();
 
-    if (EEPROM.read(EEPROM_ADDRESS_BATT_HISTORY_UNINITIALIZED) == EEPROM_ADDRESS_FACTORY_DEFAULT_VALUE)
+    if (eeprom_readByte(EEPROM_ADDRESS_BATT_HISTORY_UNINITIALIZED) == EEPROM_ADDRESS_FACTORY_DEFAULT_VALUE)
     {
         eeprom_batteryHistory_reset();
 
-        EEPROM.update(EEPROM_ADDRESS_BATT_HISTORY_UNINITIALIZED, EEPROM_ADDRESS_FORMATTED_VALUE);
+        eeprom_writeByte(EEPROM_ADDRESS_BATT_HISTORY_UNINITIALIZED, EEPROM_ADDRESS_FORMATTED_VALUE);
     }
 }
 
@@ -17,6 +17,24 @@
     #define REQUIRED_FIRMWARE_UPDATE_PERIOD_DAYS 40
     #define REQUIRED_FIRMWARE_UPDATE_PERIOD_HOURS (REQUIRED_FIRMWARE_UPDATE_PERIOD_DAYS * 24)
 
+    #define SoC_SNAPSHOT_NUM_RECORDS    32 //EEPROM wear is spread across all records
+    #define SoC_SNAPSHOT_RECORD_BYTES    8
+    #define SoC_SNAPSHOT_RECORD_VERSION 0x01 //change if record format changes
+
+    #define EEPROM_BUS_STATS_MAX_BYTES 63 //plus one CRC byte
+    #define EEPROM_PARAMS_MAX_BYTES    95 //plus one CRC byte
+    #define EEPROM_FLIGHTREC_MAX_BYTES 1040
+
+    #define RESET_HISTORY_NUM_RECORDS  16
+    #define RESET_HISTORY_RECORD_BYTES  8
+
+    #define EEPROM_QUEUE_SIZE 32 //must be a power of 2 //bytes waiting to be written
+
+    #define BATTERY_HISTORY_JOURNAL_NUM_RECORDS  32
+    #define BATTERY_HISTORY_JOURNAL_RECORD_BYTES  8
+    #define BATTERY_HISTORY_JOURNAL_VERSION    0x01 //change if record format changes
+    #define BATTERY_HISTORY_MAX_HOURS        0xFFFE //0xFFFF is erased EEPROM
+
     #define FIRMWARE_EXPIRED   0b10101010 //alternating bit pattern for EEPROM read/write integrity
     #define FIRMWARE_UNEXPIRED 0b01010101
 
@@ -35,6 +53,34 @@
     uint8_t eeprom_delayKeyON_ms_get(void);
     void    eeprom_delayKeyON_ms_set(uint8_t);
 
+    uint16_t eeprom_learnedCapacity_mAh_get(void);
+    void     eeprom_learnedCapacity_mAh_set(uint16_t);
+
+    uint8_t eeprom_calculateCRC8(const uint8_t data[], uint8_t numBytes);
+
+    bool eeprom_SoCsnapshot_findNewest(uint16_t *packCharge_mAh, uint16_t *uptime_hours);
+    void eeprom_SoCsnapshot_save(uint16_t packCharge_mAh, uint16_t uptime_hours);
+    uint16_t eeprom_SoCsnapshot_savesSinceBoot_get(void);
+    uint16_t eeprom_SoCsnapshot_savesTotal_get(void);
+
+    uint16_t eeprom_balanceHistory_minutes_get(uint8_t ic, uint8_t cell);
+    void     eeprom_balanceHistory_minutes_set(uint8_t ic, uint8_t cell, uint16_t minutes);
+    void     eeprom_balanceHistory_reset(void);
+
+    void eeprom_busStats_save(const uint8_t data[], uint8_t numBytes);
+    bool eeprom_busStats_load(uint8_t data[], uint8_t numBytes);
+
+    void eeprom_params_save(const uint8_t data[], uint8_t numBytes);
+    bool eeprom_params_load(uint8_t data[], uint8_t numBytes);
+
+    void    eeprom_flightRecorder_writeByte(uint16_t offset, uint8_t data);
+    uint8_t eeprom_flightRecorder_readByte(uint16_t offset);
+
+    void     eeprom_resetHistory_begin(void);
+    void     eeprom_resetHistory_save(uint8_t resetCause, uint8_t task, uint8_t phase, uint16_t loopTime_ms);
+    bool     eeprom_resetHistory_get(uint8_t age, uint16_t *sequence, uint8_t *resetCause, uint8_t *task, uint8_t *phase, uint16_t *loopTime_ms);
+    uint16_t eeprom_resetHistory_total_get(void);
+
     void eeprom_resetDebugValues(void);
 
     void eeprom_verifyDataValid(void);
@@ -44,7 +90,12 @@
     void eeprom_resetAll(void);
     void eeprom_resetAll_userConfirm(void);
 
-    void eeprom_batteryHistory_incrementValue(uint8_t indexTemperature, uint8_t indexSoC);
+    void     eeprom_batteryHistory_journalBegin(void);
+    void     eeprom_batteryHistory_appendHours(uint8_t indexTemperature, uint8_t indexSoC, uint16_t hours);
+    void     eeprom_batteryHistory_mergeJournal(void);
+    bool     eeprom_batteryHistory_journalRecord_get(uint8_t recordIndex, uint8_t *indexTemperature, uint8_t *indexSoC, uint16_t *hours);
+    uint8_t  eeprom_batteryHistory_journalPending_get(void);
+    uint16_t eeprom_batteryHistory_appendsSinceBoot_get(void);
 
     uint16_t eeprom_batteryHistory_getValue(uint8_t indexTemperature, uint8_t indexSoC);
 
@@ -52,4 +103,16 @@
 
     void writeToEEPROM_uint16(uint16_t startAddress, uint16_t value);
 
+    uint8_t eeprom_readByte(uint16_t address);
+    void    eeprom_writeByte(uint16_t address, uint8_t data); //queued //EEPROM ready ISR writes it later
+
+    bool eeprom_isIdle(void);
+    void eeprom_waitUntilIdle(void); //MUST call before LiBCM turns off
+
+    uint16_t eeprom_bytesWritten_get(void);
+    uint16_t eeprom_bytesSkipped_get(void);
+    uint16_t eeprom_bytesCoalesced_get(void);
+    uint8_t  eeprom_queueHighWater_get(void);
+    uint32_t eeprom_blockedTime_us_get(void); //total time spent waiting on EEPROM since boot
+
 #endif
@@ -0,0 +1,118 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//deferred event logger
+//Time critical code (including ISRs) logs events in constant time, instead of printing text directly to USB.
+//eventLog_handler() prints logged events later, but only when the USB transmit buffer has room (never blocks).
+//If the queue is full, new events are dropped (and counted).
+
+#include "libcm.h"
+
+struct eventTypes
+{
+    uint8_t  eventID;
+    uint16_t arg;
+    uint32_t timestamp_ms;
+};
+
+volatile eventTypes eventQueue[EVENTLOG_QUEUE_SIZE];
+volatile uint8_t eventQueue_head = 0; //next event written here
+volatile uint8_t eventQueue_tail = 0; //next event printed from here
+
+volatile uint16_t eventsDropped = 0; //since last printed
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//can be called from ISR
+void eventLog_log(uint8_t eventID, uint16_t arg)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    uint8_t nextHead = (eventQueue_head + 1) & (EVENTLOG_QUEUE_SIZE - 1);
+
+    if (nextHead == eventQueue_tail)
+    {
+        //queue is full
+        if (eventsDropped < 0xFFFF) { eventsDropped++; }
+    }
+    else
+    {
+        eventQueue[eventQueue_head].eventID = eventID;
+        eventQueue[eventQueue_head].arg = arg;
+        eventQueue[eventQueue_head].timestamp_ms = millis();
+        eventQueue_head = nextHead;
+    }
+
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void eventLog_printLTC6804register(uint16_t arg)
+{
+    Serial.print(F(" IC"));
+    Serial.print(highByte(arg), DEC);
+    Serial.print(F(" CVR"));
+    Serial.print((char)lowByte(arg));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void eventLog_printEvent(uint8_t eventID, uint16_t arg, uint32_t timestamp_ms)
+{
+    if (eventID == EVENT_LOOP_OVERRUN) { Serial.print('*'); return; } //occurs often, so keep it short
+
+    Serial.print('\n');
+    Serial.print(timestamp_ms, DEC);
+    Serial.print(F(": "));
+
+    switch (eventID)
+    {
+        case EVENT_GRIDCHARGER_ENABLED:   Serial.print(F("Charging")); break;
+        case EVENT_GRIDCHARGER_DISABLED:  Serial.print(F("Charger disabled: ")); gridCharger_printDisableReason((uint8_t)arg); break;
+        case EVENT_METSCI_CHECKSUM_ERROR: Serial.print(F("METSCI Bad Checksum: ")); Serial.print(arg, HEX); break;
+        case EVENT_METSCI_UNKNOWN_PACKET: Serial.print(F("Unknown METSCI packet type: ")); Serial.print(highByte(arg), HEX);
+                                          Serial.print(F(", value: ")); Serial.print(lowByte(arg), HEX); break;
+        case EVENT_METSCI_RESYNC:         Serial.print(F("METSCI buffer sync")); break;
+        case EVENT_LTC6804_PEC_ERROR:     Serial.print(F("isoSPI PEC error:")); eventLog_printLTC6804register(arg); break;
+        case EVENT_LTC6804_READ_FAILED:   Serial.print(F("isoSPI read failed:")); eventLog_printLTC6804register(arg); break;
+        case EVENT_FLIGHTREC_TRIGGERED:   Serial.print(F("Flight recorder triggered: ")); flightRecorder_printTriggerName((uint8_t)arg); break;
+        case EVENT_FLIGHTREC_SAVED:       Serial.print(F("Flight recorder saved ('$FREC' to print)")); break;
+        case EVENT_RAM_MARGIN_LOW:        Serial.print(F("Low RAM! Stack to heap margin (B): ")); Serial.print(arg, DEC); break;
+        default:                          Serial.print(F("Unknown event ")); Serial.print(eventID, DEC);
+                                          Serial.print(F(", arg: ")); Serial.print(arg, DEC); break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//low priority //prints logged events while USB transmit buffer has room
+void eventLog_handler(void)
+{
+    while (Serial.availableForWrite() > EVENTLOG_MAX_MESSAGE_BYTES)
+    {
+        noInterrupts();
+        uint16_t numDropped = eventsDropped;
+        eventsDropped = 0;
+        interrupts();
+
+        if (numDropped > 0)
+        {
+            Serial.print(F("\nEvents dropped: "));
+            Serial.print(numDropped, DEC);
+            continue; //verify USB buffer still has room
+        }
+
+        if (eventQueue_tail == eventQueue_head) { break; } //queue is empty
+
+        uint8_t  eventID      = eventQueue[eventQueue_tail].eventID;
+        uint16_t arg          = eventQueue[eventQueue_tail].arg;
+        uint32_t timestamp_ms = eventQueue[eventQueue_tail].timestamp_ms;
+        eventQueue_tail = (eventQueue_tail + 1) & (EVENTLOG_QUEUE_SIZE - 1); //single byte write is atomic
+
+        eventLog_printEvent(eventID, arg, timestamp_ms);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
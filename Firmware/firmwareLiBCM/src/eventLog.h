@@ -0,0 +1,30 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef eventlog_h
+    #define eventlog_h
+
+    #define EVENTLOG_QUEUE_SIZE 16 //MUST be a power of two //7 bytes RAM per event
+
+    //max characters printed per event //MUST be less than 63 (USB transmit buffer) //update if a longer event message is added
+    //longest: EVENT_FLIGHTREC_TRIGGERED: '\n' + 10 digit timestamp + ": " + "Flight recorder triggered: " + "watchdog near miss"
+    #define EVENTLOG_MAX_MESSAGE_BYTES 58
+
+    //event IDs //arg meaning is listed after each event
+    #define EVENT_LOOP_OVERRUN          1 //loop time beyond period (ms)
+    #define EVENT_GRIDCHARGER_ENABLED   2 //arg unused
+    #define EVENT_GRIDCHARGER_DISABLED  3 //reason (see gridCharger.h)
+    #define EVENT_METSCI_CHECKSUM_ERROR 4 //packet type
+    #define EVENT_METSCI_UNKNOWN_PACKET 5 //(packet type << 8) | data
+    #define EVENT_METSCI_RESYNC         6 //arg unused
+    #define EVENT_LTC6804_PEC_ERROR     7 //(IC address << 8) | cell voltage register ('A' to 'D')
+    #define EVENT_LTC6804_READ_FAILED   8 //(IC address << 8) | cell voltage register ('A' to 'D')
+    #define EVENT_FLIGHTREC_TRIGGERED   9 //trigger ID (see flightRecorder.h)
+    #define EVENT_FLIGHTREC_SAVED      10 //number of blocks saved
+    #define EVENT_RAM_MARGIN_LOW       11 //bytes between heap and stack low water mark
+
+    void eventLog_log(uint8_t eventID, uint16_t arg);
+
+    void eventLog_handler(void);
+
+#endif
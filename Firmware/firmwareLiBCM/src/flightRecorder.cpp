@@ -0,0 +1,479 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//pre-trigger flight recorder
+//while keyON, the latest few seconds of high rate signals are stored in a RAM ring buffer (see FLIGHTREC_LOOPS_PER_SAMPLE)
+//triggers are checked every loop
+//when a fault occurs (see FLIGHTREC_TRIGGER_xxx), the ring is frozen, then copied to EEPROM a few bytes per loop
+//'$FREC' prints the saved capture, so we can see what happened in the seconds before LiBCM disabled assist/regen, etc.
+//samples are printed a few per loop (only while the USB transmit buffer has room), so printing never stalls the loop
+//only one capture is saved per keyON (the first fault is usually the root cause)
+
+#include "libcm.h"
+
+struct flightRecorderSample
+{
+    int16_t  current_amps;
+    uint16_t hiCell_counts;
+    uint16_t loCell_counts;
+    uint16_t SoC_deciPercent; //sent to MCM on BATTSCI
+    uint8_t  packVoltage;
+    uint8_t  spoofedVoltage;
+    uint8_t  METSCI_E6;       //assist/regen level
+    uint8_t  METSCI_B4;
+}; //12B
+
+struct flightRecorderBlock
+{
+    uint32_t timestamp_ms; //when keyframe was sampled
+    uint8_t  numSamples;   //including keyframe
+    uint8_t  numBytes;     //delta encoded bytes used in data[]
+    flightRecorderSample keyframe;
+    uint8_t  data[FLIGHTREC_BLOCK_DATA_BYTES];
+}; //64B
+
+//EEPROM capture: blocks (oldest first), then header
+//header is written last, so a partially saved capture is never printed
+struct flightRecorderHeader
+{
+    uint8_t  version;
+    uint8_t  triggerID;
+    uint16_t triggerArg;
+    uint32_t trigger_ms;
+    uint16_t samplePeriod_ms;
+    uint8_t  numBlocks;
+    uint8_t  crc;          //all previous header bytes
+};
+
+#define FLIGHTREC_HEADER_OFFSET (FLIGHTREC_NUM_BLOCKS * sizeof(flightRecorderBlock))
+
+flightRecorderBlock  flightRecorder_blocks[FLIGHTREC_NUM_BLOCKS];
+flightRecorderSample flightRecorder_decoded; //what '$FREC' will reconstruct from the newest sample
+flightRecorderHeader flightRecorder_header;  //describes the frozen ring
+
+uint8_t flightRecorder_newestBlock = FLIGHTREC_NUM_BLOCKS - 1;
+uint8_t flightRecorder_blocksUsed = 0;
+uint8_t flightRecorder_state = FLIGHTREC_STATE_IDLE;
+
+uint8_t  flightRecorder_saveFirstBlock = 0; //oldest block in frozen ring
+uint16_t flightRecorder_saveOffset = 0;     //next EEPROM byte to write
+
+bool flightRecorder_wasCellLimitHit = NO;
+
+//'$FREC' print progress //samples are decoded directly from EEPROM
+#define FLIGHTREC_PRINT_IDLE 0xFF
+uint8_t  flightRecorder_printBlock = FLIGHTREC_PRINT_IDLE; //EEPROM block being printed
+uint8_t  flightRecorder_printNumBlocks = 0;
+uint16_t flightRecorder_printSamplePeriod_ms = 0;
+uint8_t  flightRecorder_printSampleIndex = 0; //'0' is keyframe
+uint8_t  flightRecorder_printDataIndex = 0;   //next delta encoded byte
+uint32_t flightRecorder_printTimestamp_ms = 0;
+flightRecorderSample flightRecorder_printed;  //latest printed sample (next delta is applied to it)
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+int8_t flightRecorder_clamp(int32_t value, int8_t limit)
+{
+    if      (value >  limit) { return  limit;         }
+    else if (value < -limit) { return -limit;         }
+    else                     { return (int8_t)value;  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_getLatestSample(flightRecorderSample *sample)
+{
+    sample->current_amps    = adc_getLatestBatteryCurrent_amps();
+    sample->hiCell_counts   = LTC68042result_hiCellVoltage_get();
+    sample->loCell_counts   = LTC68042result_loCellVoltage_get();
+    sample->SoC_deciPercent = BATTSCI_SoC_deciPercent_get();
+    sample->packVoltage     = LTC68042result_packVoltage_get();
+    sample->spoofedVoltage  = vPackSpoof_getSpoofedPackVoltage();
+    uint8_t METSCI_B3, METSCI_E1; //unused
+    METSCI_getLatestPackets(&sample->METSCI_E6, &METSCI_B3, &sample->METSCI_B4, &METSCI_E1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_startNewBlock(const flightRecorderSample *sample)
+{
+    if (++flightRecorder_newestBlock >= FLIGHTREC_NUM_BLOCKS) { flightRecorder_newestBlock = 0; } //overwrites oldest block
+    if (flightRecorder_blocksUsed < FLIGHTREC_NUM_BLOCKS) { flightRecorder_blocksUsed++; }
+
+    flightRecorderBlock *block = &flightRecorder_blocks[flightRecorder_newestBlock];
+    block->timestamp_ms = millis();
+    block->numSamples = 1;
+    block->numBytes = 0;
+    block->keyframe = *sample;
+
+    flightRecorder_decoded = *sample;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//each delta is relative to the previously decoded value (not the previous actual value)
+//so if a delta is clamped, the remaining error is carried into the next sample (instead of accumulating)
+void flightRecorder_appendSample(const flightRecorderSample *sample)
+{
+    flightRecorderBlock *block = &flightRecorder_blocks[flightRecorder_newestBlock];
+
+    if ( (flightRecorder_blocksUsed == 0                                             ) ||
+         ((FLIGHTREC_BLOCK_DATA_BYTES - block->numBytes) < FLIGHTREC_MAX_SAMPLE_BYTES) || //block is full
+         (block->numSamples == 0xFF                                                  )  )
+    {
+        flightRecorder_startNewBlock(sample);
+        return;
+    }
+
+    flightRecorderSample *decoded = &flightRecorder_decoded;
+    uint8_t encoded[FLIGHTREC_MAX_SAMPLE_BYTES];
+    uint8_t numBytes = 1; //Byte0 is always sent
+    uint8_t flags = 0;
+
+    //battery current
+    int16_t currentDelta = sample->current_amps - decoded->current_amps;
+    if ((currentDelta > FLIGHTREC_CURRENT_ESCAPE) && (currentDelta < -FLIGHTREC_CURRENT_ESCAPE)) { encoded[0] = ((uint8_t)currentDelta << 4); }
+    else
+    {
+        currentDelta = flightRecorder_clamp(currentDelta, 127);
+        encoded[0] = ((FLIGHTREC_CURRENT_ESCAPE & 0x0F) << 4);
+        encoded[numBytes++] = (uint8_t)currentDelta;
+    }
+    decoded->current_amps += currentDelta;
+
+    //hi & lo cell voltage
+    int8_t hiCellDelta = flightRecorder_clamp(((int32_t)sample->hiCell_counts - decoded->hiCell_counts) / FLIGHTREC_CELL_COUNTS_PER_LSB, 127);
+    int8_t loCellDelta = flightRecorder_clamp(((int32_t)sample->loCell_counts - decoded->loCell_counts) / FLIGHTREC_CELL_COUNTS_PER_LSB, 127);
+    if ((hiCellDelta != 0) || (loCellDelta != 0))
+    {
+        flags |= FLIGHTREC_FLAG_CELLS;
+        encoded[numBytes++] = (uint8_t)hiCellDelta;
+        encoded[numBytes++] = (uint8_t)loCellDelta;
+        decoded->hiCell_counts += (int16_t)hiCellDelta * FLIGHTREC_CELL_COUNTS_PER_LSB;
+        decoded->loCell_counts += (int16_t)loCellDelta * FLIGHTREC_CELL_COUNTS_PER_LSB;
+    }
+
+    //actual & spoofed pack voltage
+    int8_t packVoltageDelta    = flightRecorder_clamp((int16_t)sample->packVoltage    - decoded->packVoltage,    7);
+    int8_t spoofedVoltageDelta = flightRecorder_clamp((int16_t)sample->spoofedVoltage - decoded->spoofedVoltage, 7);
+    if ((packVoltageDelta != 0) || (spoofedVoltageDelta != 0))
+    {
+        flags |= FLIGHTREC_FLAG_VOLTS;
+        encoded[numBytes++] = ((uint8_t)packVoltageDelta << 4) | ((uint8_t)spoofedVoltageDelta & 0x0F);
+        decoded->packVoltage    += packVoltageDelta;
+        decoded->spoofedVoltage += spoofedVoltageDelta;
+    }
+
+    //METSCI
+    if ((sample->METSCI_E6 != decoded->METSCI_E6) || (sample->METSCI_B4 != decoded->METSCI_B4))
+    {
+        flags |= FLIGHTREC_FLAG_METSCI;
+        encoded[numBytes++] = sample->METSCI_E6;
+        encoded[numBytes++] = sample->METSCI_B4;
+        decoded->METSCI_E6 = sample->METSCI_E6;
+        decoded->METSCI_B4 = sample->METSCI_B4;
+    }
+
+    //BATTSCI SoC
+    int8_t SoCdelta = flightRecorder_clamp((int16_t)sample->SoC_deciPercent - (int16_t)decoded->SoC_deciPercent, 127);
+    if (SoCdelta != 0)
+    {
+        flags |= FLIGHTREC_FLAG_SoC;
+        encoded[numBytes++] = (uint8_t)SoCdelta;
+        decoded->SoC_deciPercent += SoCdelta;
+    }
+
+    encoded[0] |= flags;
+
+    for (uint8_t ii = 0; ii < numBytes; ii++) { block->data[block->numBytes++] = encoded[ii]; }
+    block->numSamples++;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//'*index' is advanced past the decoded sample
+void flightRecorder_decodeSample(const uint8_t data[], uint8_t *index, flightRecorderSample *sample)
+{
+    uint8_t byte0 = data[(*index)++];
+
+    int8_t currentDelta = (int8_t)byte0 >> 4;
+    if (currentDelta == FLIGHTREC_CURRENT_ESCAPE) { currentDelta = (int8_t)data[(*index)++]; }
+    sample->current_amps += currentDelta;
+
+    if (byte0 & FLIGHTREC_FLAG_CELLS)
+    {
+        sample->hiCell_counts += (int16_t)((int8_t)data[(*index)++]) * FLIGHTREC_CELL_COUNTS_PER_LSB;
+        sample->loCell_counts += (int16_t)((int8_t)data[(*index)++]) * FLIGHTREC_CELL_COUNTS_PER_LSB;
+    }
+
+    if (byte0 & FLIGHTREC_FLAG_VOLTS)
+    {
+        uint8_t volts = data[(*index)++];
+        sample->packVoltage    += (int8_t)volts >> 4;
+        sample->spoofedVoltage += (int8_t)(volts << 4) >> 4;
+    }
+
+    if (byte0 & FLIGHTREC_FLAG_METSCI)
+    {
+        sample->METSCI_E6 = data[(*index)++];
+        sample->METSCI_B4 = data[(*index)++];
+    }
+
+    if (byte0 & FLIGHTREC_FLAG_SoC) { sample->SoC_deciPercent += (int8_t)data[(*index)++]; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_handleKeyOn(void)
+{
+    if (flightRecorder_state == FLIGHTREC_STATE_SAVING) { return; } //finish saving previous capture //next keyON re-arms recorder
+
+    flightRecorder_newestBlock = FLIGHTREC_NUM_BLOCKS - 1;
+    flightRecorder_blocksUsed = 0;
+    flightRecorder_wasCellLimitHit = NO;
+    flightRecorder_state = FLIGHTREC_STATE_RECORDING;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_trigger(uint8_t triggerID, uint16_t arg)
+{
+    if (flightRecorder_state != FLIGHTREC_STATE_RECORDING)     { return; } //one capture per keyON
+    if (flightRecorder_blocksUsed == 0)                        { return; } //nothing recorded yet
+    if (flightRecorder_printBlock != FLIGHTREC_PRINT_IDLE)     { return; } //don't overwrite the capture '$FREC' is printing
+
+    if (triggerID != FLIGHTREC_TRIGGER_USER)
+    {
+        if ((params_get(PARAM_FLIGHTREC_TRIGGERS) & triggerID) == 0) { return; } //trigger disabled
+        if (time_sinceLatestKeyOn_ms() < FLIGHTREC_KEYON_SETTLE_ms)   { return; }
+    }
+
+    flightRecorder_header.version         = FLIGHTREC_VERSION;
+    flightRecorder_header.triggerID       = triggerID;
+    flightRecorder_header.triggerArg      = arg;
+    flightRecorder_header.trigger_ms      = millis();
+    flightRecorder_header.samplePeriod_ms = time_loopPeriod_ms_get() * FLIGHTREC_LOOPS_PER_SAMPLE;
+    flightRecorder_header.numBlocks       = flightRecorder_blocksUsed;
+    flightRecorder_header.crc = eeprom_calculateCRC8((const uint8_t *)&flightRecorder_header, sizeof(flightRecorderHeader) - 1);
+
+    flightRecorder_saveFirstBlock = (flightRecorder_newestBlock + FLIGHTREC_NUM_BLOCKS + 1 - flightRecorder_blocksUsed) % FLIGHTREC_NUM_BLOCKS;
+    flightRecorder_saveOffset = 0;
+    flightRecorder_state = FLIGHTREC_STATE_SAVING; //freezes ring
+
+    eeprom_flightRecorder_writeByte(FLIGHTREC_HEADER_OFFSET, EEPROM_ADDRESS_FACTORY_DEFAULT_VALUE); //invalidate previous capture
+    eventLog_log(EVENT_FLIGHTREC_TRIGGERED, triggerID);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//called each time a keyON loop takes longer than the loop period
+void flightRecorder_handleLoopOverrun(uint32_t loopTime_ms)
+{
+    static uint32_t windowStart_ms = 0;
+    static uint8_t overrunsInWindow = 0;
+
+    if (loopTime_ms > FLIGHTREC_WATCHDOG_NEAR_MISS_ms)
+    {
+        flightRecorder_trigger(FLIGHTREC_TRIGGER_WATCHDOG, (loopTime_ms > 0xFFFF) ? 0xFFFF : (uint16_t)loopTime_ms);
+    }
+
+    if ((uint32_t)(millis() - windowStart_ms) > FLIGHTREC_OVERRUN_BURST_WINDOW_ms)
+    {
+        windowStart_ms = millis();
+        overrunsInWindow = 0;
+    }
+
+    if (overrunsInWindow < 0xFF) { overrunsInWindow++; }
+
+    if (overrunsInWindow == FLIGHTREC_OVERRUN_BURST_COUNT) { flightRecorder_trigger(FLIGHTREC_TRIGGER_LOOP_OVERRUN, overrunsInWindow); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_checkTriggers(const flightRecorderSample *sample)
+{
+    bool isCellLimitHit = ((sample->hiCell_counts > params_get(PARAM_CELL_VMAX_REGEN) ) ||
+                           (sample->loCell_counts < params_get(PARAM_CELL_VMIN_ASSIST))  );
+
+    if ((isCellLimitHit == YES) && (flightRecorder_wasCellLimitHit == NO))
+    {
+        if (sample->hiCell_counts > params_get(PARAM_CELL_VMAX_REGEN)) { flightRecorder_trigger(FLIGHTREC_TRIGGER_CELL_LIMIT, sample->hiCell_counts); }
+        else                                                           { flightRecorder_trigger(FLIGHTREC_TRIGGER_CELL_LIMIT, sample->loCell_counts); }
+    }
+    flightRecorder_wasCellLimitHit = isCellLimitHit;
+
+    uint32_t METSCI_frameAge_ms = METSCI_latestFrameAge_ms();
+    if (METSCI_frameAge_ms > FLIGHTREC_METSCI_TIMEOUT_ms)
+    {
+        flightRecorder_trigger(FLIGHTREC_TRIGGER_METSCI_LOSS, (METSCI_frameAge_ms > 0xFFFF) ? 0xFFFF : (uint16_t)METSCI_frameAge_ms);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//copies frozen ring to EEPROM, without blocking the loop
+void flightRecorder_saveNextBytes(void)
+{
+    if (eeprom_isIdle() == NO) { return; } //other EEPROM writes have priority
+
+    uint16_t numBlockBytes = flightRecorder_header.numBlocks * sizeof(flightRecorderBlock);
+
+    for (uint8_t ii = 0; ii < FLIGHTREC_EEPROM_BYTES_PER_LOOP; ii++)
+    {
+        if (flightRecorder_saveOffset < numBlockBytes)
+        {
+            uint8_t block = (flightRecorder_saveFirstBlock + (flightRecorder_saveOffset / sizeof(flightRecorderBlock))) % FLIGHTREC_NUM_BLOCKS;
+            const uint8_t *blockBytes = (const uint8_t *)&flightRecorder_blocks[block];
+
+            eeprom_flightRecorder_writeByte(flightRecorder_saveOffset, blockBytes[flightRecorder_saveOffset % sizeof(flightRecorderBlock)]);
+        }
+        else
+        {
+            uint8_t headerByte = flightRecorder_saveOffset - numBlockBytes;
+            eeprom_flightRecorder_writeByte(FLIGHTREC_HEADER_OFFSET + headerByte, ((const uint8_t *)&flightRecorder_header)[headerByte]);
+
+            if (headerByte == (sizeof(flightRecorderHeader) - 1))
+            {
+                flightRecorder_state = FLIGHTREC_STATE_SAVED;
+                eventLog_log(EVENT_FLIGHTREC_SAVED, flightRecorder_header.numBlocks);
+                return;
+            }
+        }
+
+        flightRecorder_saveOffset++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_printTriggerName(uint8_t triggerID)
+{
+    switch (triggerID)
+    {
+        case FLIGHTREC_TRIGGER_CELL_LIMIT:   Serial.print(F("cell voltage limit")); break;
+        case FLIGHTREC_TRIGGER_METSCI_LOSS:  Serial.print(F("METSCI lost")); break;
+        case FLIGHTREC_TRIGGER_LOOP_OVERRUN: Serial.print(F("loop overrun burst")); break;
+        case FLIGHTREC_TRIGGER_WATCHDOG:     Serial.print(F("watchdog near miss")); break;
+        case FLIGHTREC_TRIGGER_USER:         Serial.print(F("user")); break;
+        default:                             Serial.print(triggerID, HEX); break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_printSample(uint32_t timestamp_ms, const flightRecorderSample *sample)
+{
+    Serial.print('\n');
+    Serial.print(timestamp_ms);
+    Serial.print(',');
+    Serial.print(sample->current_amps);
+    Serial.print(',');
+    Serial.print(sample->packVoltage);
+    Serial.print(',');
+    Serial.print(sample->spoofedVoltage);
+    Serial.print(',');
+    Serial.print(sample->hiCell_counts);
+    Serial.print(',');
+    Serial.print(sample->loCell_counts);
+    Serial.print(',');
+    Serial.print(sample->METSCI_E6, HEX);
+    Serial.print(',');
+    Serial.print(sample->METSCI_B4, HEX);
+    Serial.print(',');
+    Serial.print(sample->SoC_deciPercent);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//'$FREC'
+void flightRecorder_printSaved(void)
+{
+    if (flightRecorder_state == FLIGHTREC_STATE_SAVING) { Serial.print(F("\nFlight recorder: saving new capture")); return; }
+
+    flightRecorder_printBlock = FLIGHTREC_PRINT_IDLE; //restart if previous print hasn't finished
+
+    flightRecorderHeader header;
+    uint8_t *headerBytes = (uint8_t *)&header;
+
+    for (uint8_t ii = 0; ii < sizeof(flightRecorderHeader); ii++) { headerBytes[ii] = eeprom_flightRecorder_readByte(FLIGHTREC_HEADER_OFFSET + ii); }
+
+    if ( (header.version != FLIGHTREC_VERSION                                           ) ||
+         (header.crc != eeprom_calculateCRC8(headerBytes, sizeof(flightRecorderHeader) - 1)) ||
+         (header.numBlocks > FLIGHTREC_NUM_BLOCKS                                       )  )
+    {
+        Serial.print(F("\nFlight recorder: none saved"));
+        return;
+    }
+
+    Serial.print(F("\nFlight recorder trigger: "));
+    flightRecorder_printTriggerName(header.triggerID);
+    Serial.print(F(" (arg "));
+    Serial.print(header.triggerArg);
+    Serial.print(F(") at ms "));
+    Serial.print(header.trigger_ms);
+    Serial.print(F("\nms,amps,Vpack,Vspoof,hiCell,loCell,E6,B4,SoC(0.1%)"));
+
+    flightRecorder_printNumBlocks = header.numBlocks;
+    flightRecorder_printSamplePeriod_ms = header.samplePeriod_ms;
+    flightRecorder_printSampleIndex = 0;
+    flightRecorder_printBlock = (header.numBlocks > 0) ? 0 : FLIGHTREC_PRINT_IDLE; //flightRecorder_handler() prints samples
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//prints saved samples while USB transmit buffer has room
+void flightRecorder_printNextSamples(void)
+{
+    flightRecorderBlock blockData;
+    uint8_t *blockBytes = (uint8_t *)&blockData;
+    uint16_t blockOffset = flightRecorder_printBlock * sizeof(flightRecorderBlock);
+
+    for (uint8_t ii = 0; ii < sizeof(flightRecorderBlock); ii++) { blockBytes[ii] = eeprom_flightRecorder_readByte(blockOffset + ii); }
+
+    while (Serial.availableForWrite() > FLIGHTREC_PRINT_LINE_BYTES)
+    {
+        bool isBlockFinished = NO;
+
+        if (blockData.numBytes > FLIGHTREC_BLOCK_DATA_BYTES) { Serial.print(F("\nbad block")); isBlockFinished = YES; }
+        else if (flightRecorder_printSampleIndex == 0)
+        {
+            flightRecorder_printed = blockData.keyframe;
+            flightRecorder_printTimestamp_ms = blockData.timestamp_ms;
+            flightRecorder_printDataIndex = 0;
+        }
+        else if ((flightRecorder_printSampleIndex < blockData.numSamples) && (flightRecorder_printDataIndex < blockData.numBytes))
+        {
+            flightRecorder_decodeSample(blockData.data, &flightRecorder_printDataIndex, &flightRecorder_printed);
+            flightRecorder_printTimestamp_ms += flightRecorder_printSamplePeriod_ms; //approximate (loop overruns aren't recorded)
+        }
+        else { isBlockFinished = YES; }
+
+        if (isBlockFinished == YES)
+        {
+            flightRecorder_printSampleIndex = 0;
+            if (++flightRecorder_printBlock >= flightRecorder_printNumBlocks) { flightRecorder_printBlock = FLIGHTREC_PRINT_IDLE; }
+            return; //next block is read next loop
+        }
+
+        flightRecorder_printSample(flightRecorder_printTimestamp_ms, &flightRecorder_printed);
+        flightRecorder_printSampleIndex++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void flightRecorder_handler(void)
+{
+    if (flightRecorder_printBlock != FLIGHTREC_PRINT_IDLE) { flightRecorder_printNextSamples(); }
+
+    if (flightRecorder_state == FLIGHTREC_STATE_SAVING) { flightRecorder_saveNextBytes(); }
+    else if ((flightRecorder_state == FLIGHTREC_STATE_RECORDING) && (key_getSampledState() == KEYSTATE_ON))
+    {
+        flightRecorderSample sample;
+        flightRecorder_getLatestSample(&sample);
+        if ((time_getLoopCount_8b() & (FLIGHTREC_LOOPS_PER_SAMPLE - 1)) == 0) { flightRecorder_appendSample(&sample); }
+        flightRecorder_checkTriggers(&sample);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,58 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef flightRecorder_h
+    #define flightRecorder_h
+
+    //RAM ring buffer //each block starts with a full sample (keyframe), followed by delta encoded samples
+    #define FLIGHTREC_NUM_BLOCKS       16 //64B RAM per block //~10 seconds at 10 ms loop period (fewer seconds if signals change often)
+    #define FLIGHTREC_LOOPS_PER_SAMPLE  2 //MUST be 2^n //'1' samples every loop, but only stores ~5 seconds
+    #define FLIGHTREC_BLOCK_DATA_BYTES 46 //delta encoded samples per block //MUST keep block size at 64B (see flightRecorder.cpp)
+    #define FLIGHTREC_MAX_SAMPLE_BYTES  8 //largest delta encoded sample
+
+    //delta encoded sample:
+    //Byte0 [7:4]: battery current delta (int4, amps) //FLIGHTREC_CURRENT_ESCAPE: int8 current delta follows
+    //Byte0 [3:0]: flags //each flag's data follows (in flag order)
+    #define FLIGHTREC_CURRENT_ESCAPE    -8
+    #define FLIGHTREC_FLAG_CELLS      0x01 //int8 hi cell delta, int8 lo cell delta (FLIGHTREC_CELL_COUNTS_PER_LSB)
+    #define FLIGHTREC_FLAG_VOLTS      0x02 //int4 pack voltage delta [7:4], int4 spoofed voltage delta [3:0] (volts)
+    #define FLIGHTREC_FLAG_METSCI     0x04 //METSCI E6 byte, METSCI B4 byte (raw)
+    #define FLIGHTREC_FLAG_SoC        0x08 //int8 BATTSCI SoC delta (deciPercent)
+
+    #define FLIGHTREC_CELL_COUNTS_PER_LSB 8 //0.8 mV per cell delta count
+
+    //trigger IDs //PARAM_FLIGHTREC_TRIGGERS chooses which are enabled
+    #define FLIGHTREC_TRIGGER_CELL_LIMIT   0x01 //hi cell above VMAX_REGEN, or lo cell below VMIN_ASSIST
+    #define FLIGHTREC_TRIGGER_METSCI_LOSS  0x02 //no METSCI frame for FLIGHTREC_METSCI_TIMEOUT_ms
+    #define FLIGHTREC_TRIGGER_LOOP_OVERRUN 0x04 //FLIGHTREC_OVERRUN_BURST_COUNT loop overruns within FLIGHTREC_OVERRUN_BURST_WINDOW_ms
+    #define FLIGHTREC_TRIGGER_WATCHDOG     0x08 //single loop took longer than FLIGHTREC_WATCHDOG_NEAR_MISS_ms
+    #define FLIGHTREC_TRIGGER_ALL          0x0F
+    #define FLIGHTREC_TRIGGER_USER         0x80 //'$FREC=NOW' //always enabled
+
+    #define FLIGHTREC_METSCI_TIMEOUT_ms        500
+    #define FLIGHTREC_OVERRUN_BURST_COUNT       10
+    #define FLIGHTREC_OVERRUN_BURST_WINDOW_ms 1000
+    #define FLIGHTREC_WATCHDOG_NEAR_MISS_ms   1000 //watchdog resets LiBCM after 2000 ms
+    #define FLIGHTREC_KEYON_SETTLE_ms         3000 //triggers are ignored right after keyON (e.g. METSCI hasn't started yet)
+
+    #define FLIGHTREC_STATE_IDLE      0 //LiBCM hasn't been keyON since boot
+    #define FLIGHTREC_STATE_RECORDING 1
+    #define FLIGHTREC_STATE_SAVING    2 //ring is frozen //copying ring to EEPROM
+    #define FLIGHTREC_STATE_SAVED     3 //ring stays frozen until next keyON
+
+    #define FLIGHTREC_EEPROM_BYTES_PER_LOOP 4 //only written when EEPROM queue is empty, so loop period isn't affected
+    #define FLIGHTREC_PRINT_LINE_BYTES     50 //longest printed sample (MUST be less than 63) //'$FREC' only prints a sample when USB transmit buffer has this much room
+    #define FLIGHTREC_VERSION 0x01 //change if sample or block format changes
+
+    void flightRecorder_handler(void);
+
+    void flightRecorder_handleKeyOn(void);
+
+    void flightRecorder_handleLoopOverrun(uint32_t loopTime_ms); //called by time_waitForLoopPeriod()
+
+    void flightRecorder_trigger(uint8_t triggerID, uint16_t arg);
+
+    void flightRecorder_printTriggerName(uint8_t triggerID);
+    void flightRecorder_printSaved(void); //prints header, then flightRecorder_handler() prints samples in the background
+
+#endif
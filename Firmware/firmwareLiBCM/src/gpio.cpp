@@ -1,7 +1,7 @@
 //Copyright 2021-2023(c) John Sullivan
 //github.com/doppelhub/Honda_Insight_LiBCM
 
-//all digitalRead(), digitalWrite(), analogRead(), analogWrite() functions live here
+//all digitalRead(), digitalWrite(), analogWrite() functions live here (analog inputs are read in adc.cpp)
 //JTS2doLater: Replace Arduino fcns with low level
 
 #include "libcm.h"
@@ -69,14 +69,58 @@ void gpio_begin(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-bool gpio_keyStateNow(void) { return digitalRead(PIN_IGNITION_SENSE); }
+//returns NO if cpu_map.h '_PORT' & '_BIT' don't match the Arduino pin number
+bool gpio_verifyFastPin(uint8_t pin, volatile uint8_t *port, uint8_t bit, const __FlashStringHelper *pinName)
+{
+    if ((portOutputRegister(digitalPinToPort(pin)) == port) && (digitalPinToBitMask(pin) == (1 << bit))) { return YES; }
+
+    Serial.print(F("\nError: cpu_map.h '_PORT'/'_BIT' don't match "));
+    Serial.print(pinName);
+    return NO;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//fast pins are hand-mapped to port & bit in cpu_map.h, so check each against the Arduino pin table
+//returns NO if any pin is mismatched
+bool gpio_verifyFastPins(void)
+{
+    bool isMapCorrect = YES;
+
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_LED1))               == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_LED2))               == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_LED3))               == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_LED4))               == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_SPI_CS))             == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_METSCI_DE))          == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_METSCI_REn))         == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_BATTSCI_DE))         == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_BATTSCI_REn))        == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_IGNITION_SENSE))     == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_SENSOR_EN))          == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_FANOEM_LOW))         == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_FANOEM_HI))          == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_GRID_SENSE))         == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_GRID_PWM))           == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_GRID_EN))            == NO) { isMapCorrect = NO; }
+    if (gpio_verifyFastPin(GPIO_FAST_PIN_ARGS(PIN_ABSTRACTED_GRID_EN)) == NO) { isMapCorrect = NO; }
+
+    return isMapCorrect;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool gpio_keyStateNow(void) { return gpio_fastRead(PIN_IGNITION_SENSE); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //THIS FUNCTION DOES NOT RETURN!
 void gpio_turnLiBCM_off(void)
 {
-    //JTS2doLater: Write SoC to EEPROM (so LiBCM can read it back at next keyON, if not enough time to calculate it)
+    SoC_snapshot_save(); //so LiBCM can read it back at next keyON, if not enough time to calculate it
+    cellBalance_history_save();
+    batteryHistory_save();
+    eeprom_waitUntilIdle(); //MUST finish writing EEPROM before power is removed
     Serial.print(F("\nLiBCM turning off"));
     delay(20); //wait for the above message to transmit
     digitalWrite(PIN_TURNOFFLiBCM,HIGH);
@@ -89,13 +133,13 @@ void gpio_setFanSpeed_OEM(char speed)
 {
     switch (speed)
     {
-        case FAN_OFF:  digitalWrite(PIN_FANOEM_LOW,  LOW); digitalWrite(PIN_FANOEM_HI,  LOW); break;
-        case FAN_LOW:  digitalWrite(PIN_FANOEM_LOW, HIGH); digitalWrite(PIN_FANOEM_HI,  LOW); break;
-        //case FAN_MED:  digitalWrite(PIN_FANOEM_LOW, HIGH); digitalWrite(PIN_FANOEM_HI,  LOW); break; //same as FAN_LOW... OEM fan only supports OFF/LOW/HIGH
+        case FAN_OFF:  gpio_fastWrite(PIN_FANOEM_LOW,  LOW); gpio_fastWrite(PIN_FANOEM_HI,  LOW); break;
+        case FAN_LOW:  gpio_fastWrite(PIN_FANOEM_LOW, HIGH); gpio_fastWrite(PIN_FANOEM_HI,  LOW); break;
+        //case FAN_MED:  gpio_fastWrite(PIN_FANOEM_LOW, HIGH); gpio_fastWrite(PIN_FANOEM_HI,  LOW); break; //same as FAN_LOW... OEM fan only supports OFF/LOW/HIGH
         #ifdef BATTERY_TYPE_5AhG3
-            case FAN_HIGH: digitalWrite(PIN_FANOEM_LOW, LOW); digitalWrite(PIN_FANOEM_HI, HIGH); break; //OEM fan schematic requires one relay for high speed
+            case FAN_HIGH: gpio_fastWrite(PIN_FANOEM_LOW, LOW); gpio_fastWrite(PIN_FANOEM_HI, HIGH); break; //OEM fan schematic requires one relay for high speed
         #elif defined BATTERY_TYPE_47AhFoMoCo
-            case FAN_HIGH: digitalWrite(PIN_FANOEM_LOW, HIGH); digitalWrite(PIN_FANOEM_HI, HIGH); break; //PDU fan schematic requires both relays for high speed
+            case FAN_HIGH: gpio_fastWrite(PIN_FANOEM_LOW, HIGH); gpio_fastWrite(PIN_FANOEM_HI, HIGH); break; //PDU fan schematic requires both relays for high speed
         #endif
     }
 }
@@ -122,8 +166,8 @@ void gpio_setFanSpeed_PCB(char speed)
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //powers OEM current sensor, METSCI/BATTSCI power rail, and constant 5V load
-void gpio_turnPowerSensors_on( void) { digitalWrite(PIN_SENSOR_EN, HIGH); }
-void gpio_turnPowerSensors_off(void) { digitalWrite(PIN_SENSOR_EN,  LOW); }
+void gpio_turnPowerSensors_on( void) { gpio_fastWrite(PIN_SENSOR_EN, HIGH); }
+void gpio_turnPowerSensors_off(void) { gpio_fastWrite(PIN_SENSOR_EN,  LOW); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -133,13 +177,13 @@ bool gpio_HMIStateNow(void) { return digitalRead(PIN_HMI_EN); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-bool gpio_isGridChargerPluggedInNow(void) { return !(digitalRead(PIN_GRID_SENSE)       ); }
-bool gpio_isGridChargerChargingNow(void)  { return   digitalRead(PIN_ABSTRACTED_GRID_EN); }
+bool gpio_isGridChargerPluggedInNow(void) { return !(gpio_fastRead(PIN_GRID_SENSE)       ); }
+bool gpio_isGridChargerChargingNow(void)  { return   gpio_fastRead(PIN_ABSTRACTED_GRID_EN); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void gpio_turnGridCharger_on(void)  { digitalWrite(PIN_ABSTRACTED_GRID_EN, HIGH); }
-void gpio_turnGridCharger_off(void) { digitalWrite(PIN_ABSTRACTED_GRID_EN, LOW);  }
+void gpio_turnGridCharger_on(void)  { gpio_fastWrite(PIN_ABSTRACTED_GRID_EN, HIGH); }
+void gpio_turnGridCharger_off(void) { gpio_fastWrite(PIN_ABSTRACTED_GRID_EN, LOW);  }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -23,8 +23,46 @@
     #define GPIO_KEY_ON   true
     #define GPIO_KEY_OFF false
 
+    //fast GPIO //replaces digitalWrite()/digitalRead() (~50 cycles) in hot paths
+    //pin MUST be an output (pinMode() in begin function), and MUST have '_PORT' & '_BIT' defined in cpu_map.h
+    //each new fast pin MUST also be added to gpio_verifyFastPins()
+    //pin name is pasted (e.g. 'PIN_LED4' -> 'PIN_LED4_PORT'), so pass the cpu_map.h name (not a variable)
+    #define gpio_fastWrite(pin, level) gpio_fastWriteRegister(&GPIO_CONCAT(PORT, pin##_PORT), (1 << pin##_BIT), level)
+    #define gpio_fastRead(pin)         ((GPIO_CONCAT(PIN, pin##_PORT) & (1 << pin##_BIT)) != 0) //single 'sbis' (ports A to G)
+    #define gpio_fastToggle(pin)       (GPIO_CONCAT(PIN, pin##_PORT) = (1 << pin##_BIT)) //writing '1' to PINx toggles PORTx (always atomic)
+
+    //expands to gpio_verifyFastPin() arguments (pin number, '_PORT' register, '_BIT', pin name)
+    #define GPIO_FAST_PIN_ARGS(pin) pin, &GPIO_CONCAT(PORT, pin##_PORT), pin##_BIT, F(#pin)
+
+    #define GPIO_CONCAT(a, b)         GPIO_CONCAT_EXPANDED(a, b)
+    #define GPIO_CONCAT_EXPANDED(a, b) a##b
+
+    #define GPIO_SBI_CBI_MAX_ADDRESS 0x40 //PORTA to PORTG //higher ports (H to L) need read-modify-write
+
+    //always_inline, so constant port & mask collapse into a single 'sbi'/'cbi' instruction (ports A to G)
+    static inline void gpio_fastWriteRegister(volatile uint8_t *port, uint8_t mask, bool level) __attribute__ ((always_inline));
+    static inline void gpio_fastWriteRegister(volatile uint8_t *port, uint8_t mask, bool level)
+    {
+        if (port < (volatile uint8_t *)GPIO_SBI_CBI_MAX_ADDRESS)
+        {
+            if (level) { *port |=  mask; }
+            else       { *port &= ~mask; }
+        }
+        else
+        {
+            //an ISR could write the same port between read & write
+            uint8_t oldSREG = SREG;
+            noInterrupts();
+            if (level) { *port |=  mask; }
+            else       { *port &= ~mask; }
+            SREG = oldSREG;
+        }
+    }
+
     void gpio_begin(void);
 
+    bool gpio_verifyFastPins(void); //checks cpu_map.h fast pin port & bit against Arduino pin table //prints each mismatch
+
     bool gpio_keyStateNow(void); //recommendation: use key_getSampledState() instead
 
     void gpio_setFanSpeed_OEM(char speed); //don't call directly (use fan_requestSpeed() instead)
@@ -37,8 +37,8 @@ void runFansIfNeeded(void)
 uint16_t determineMaxAllowedCellVoltage(void)
 {
     //prevents rapid grid charger enable/disable when cells full
-    if (gpio_isGridChargerChargingNow() == YES) { return CELL_VMAX_GRIDCHARGER;                    }
-    else                                        { return CELL_VMAX_GRIDCHARGER - VCELL_HYSTERESIS; }
+    if (gpio_isGridChargerChargingNow() == YES) { return params_get(PARAM_CELL_VMAX_GRIDCHARGER);                    }
+    else                                        { return params_get(PARAM_CELL_VMAX_GRIDCHARGER) - VCELL_HYSTERESIS; }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -51,8 +51,8 @@ uint8_t isChargingAllowed(void)
     if (key_getSampledState()               == KEYSTATE_ON                              ) { return NO__KEY_IS_ON;               }
     //cell voltage checks
     if (LTC68042result_hiCellVoltage_get()   > CELL_VREST_85_PERCENT_SoC                ) { return NO__ATLEASTONECELL_TOO_HIGH; }
-    if (LTC68042result_loCellVoltage_get()   < CELL_VMIN_GRIDCHARGER                    ) { return NO__ATLEASTONECELL_TOO_LOW;  }
-    if (LTC68042result_hiCellVoltage_get()   > CELL_VMAX_GRIDCHARGER                    ) { return NO__ATLEASTONECELL_FULL;     }
+    if (LTC68042result_loCellVoltage_get()   < params_get(PARAM_CELL_VMIN_GRIDCHARGER)                        ) { return NO__ATLEASTONECELL_TOO_LOW;  }
+    if (LTC68042result_hiCellVoltage_get()   > params_get(PARAM_CELL_VMAX_GRIDCHARGER)                        ) { return NO__ATLEASTONECELL_FULL;     }
     if (LTC68042result_hiCellVoltage_get()   > determineMaxAllowedCellVoltage()         ) { return NO__CELL_VOLTAGE_HYSTERESIS; }
     //thermal checks
     if (temperature_gridCharger_getLatest()  > DISABLE_GRIDCHARGING_ABOVE_CHARGER_TEMP_C) { return NO__CHARGER_IS_HOT;          }
@@ -72,37 +72,58 @@ uint8_t isChargingAllowed(void)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//called by eventLog_handler()
+void gridCharger_printDisableReason(uint8_t canWeCharge)
+{
+    switch (canWeCharge)
+    {
+        //external checks
+        case NO__CHARGER_UNPLUGGED:       { Serial.print(F("Unplugged")         ); break; }
+        case NO__KEY_IS_ON:               { Serial.print(F("Key is ON")         ); break; }
+        //voltage issue
+        case NO__ATLEASTONECELL_TOO_HIGH: { Serial.print(F("Overcharged")       ); break; }
+        case NO__ATLEASTONECELL_TOO_LOW:  { Serial.print(F("Overdischarged")    ); break; }
+        case NO__ATLEASTONECELL_FULL:     { Serial.print(F("Pack Charged")      ); break; }
+        case NO__CELL_VOLTAGE_HYSTERESIS: { Serial.print(F("Vcell Hysteresis")  ); break; }
+        //thermal issue
+        case NO__CHARGER_IS_HOT:          { Serial.print(F("Charger Hot")       ); break; }
+        case NO__TEMP_UNPLUGGED_GRID:     { Serial.print(F("T_grid Unplugged")  ); break; }
+        case NO__BATTERY_IS_COLD:         { Serial.print(F("Pack Too Cold")     ); break; }
+        case NO__BATTERY_IS_HOT:          { Serial.print(F("Pack Too Hot")      ); break; }
+        case NO__AIRINTAKE_IS_HOT:        { Serial.print(F("Cabin Too Hot")     ); break; }
+        case NO__TEMP_UNPLUGGED_INTAKE:   { Serial.print(F("T_intake Unplugged")); break; }
+        case NO__TEMP_EXHAUST_IS_HOT:     { Serial.print(F("Exhaust Too Hot")   ); break; }
+        //time issue
+        case NO__JUST_PLUGGED_IN:         { Serial.print(F("Plugin Delay")      ); break; }
+        case NO__LIBCM_JUST_BOOTED:       { Serial.print(F("LiBCM Powerup")     ); break; }
+        case NO__RECENTLY_TURNED_OFF:     { Serial.print(F("Turnoff Delay")     ); break; }
+        //unknown reason
+        default:                          { Serial.print(F("Unknown Reason")    ); break; }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 //JTS2doLater: display status on LCD
 void processChargerDisableReason(uint8_t canWeCharge)
 {
-    Serial.print(F("\nCharger disabled: "));
+    eventLog_log(EVENT_GRIDCHARGER_DISABLED, canWeCharge);
     uint32_t offPeriod_helper = GRID_MIN_OFF_PERIOD__LONG_ms; //most common value //overwritten as needed
     uint8_t buzzer_helper = BUZZER_OFF; //most common value //overwritten as needed
 
     switch (canWeCharge)
     {
         //external checks
-        case NO__CHARGER_UNPLUGGED:       { Serial.print(F("Unplugged")         ); offPeriod_helper = GRID_MIN_OFF_PERIOD__NONE_ms; break; }
-        case NO__KEY_IS_ON:               { Serial.print(F("Key is ON")         ); buzzer_helper = BUZZER_LOW;                      break; }
+        case NO__CHARGER_UNPLUGGED:       { offPeriod_helper = GRID_MIN_OFF_PERIOD__NONE_ms; break; }
+        case NO__KEY_IS_ON:               { buzzer_helper = BUZZER_LOW;                      break; }
         //voltage issue
-        case NO__ATLEASTONECELL_TOO_HIGH: { Serial.print(F("Overcharged")       ); buzzer_helper = BUZZER_HIGH;                     break; }
-        case NO__ATLEASTONECELL_TOO_LOW:  { Serial.print(F("Overdischarged")    ); buzzer_helper = BUZZER_HIGH;                     break; }
-        case NO__ATLEASTONECELL_FULL:     { Serial.print(F("Pack Charged")      );                                                  break; }
-        case NO__CELL_VOLTAGE_HYSTERESIS: { Serial.print(F("Vcell Hysteresis")  );                                                  break; }
-        //thermal issue
-        case NO__CHARGER_IS_HOT:          { Serial.print(F("Charger Hot")       );                                                  break; }
-        case NO__TEMP_UNPLUGGED_GRID:     { Serial.print(F("T_grid Unplugged")  );                                                  break; }
-        case NO__BATTERY_IS_COLD:         { Serial.print(F("Pack Too Cold")     );                                                  break; }
-        case NO__BATTERY_IS_HOT:          { Serial.print(F("Pack Too Hot")      );                                                  break; }
-        case NO__AIRINTAKE_IS_HOT:        { Serial.print(F("Cabin Too Hot")     );                                                  break; }
-        case NO__TEMP_UNPLUGGED_INTAKE:   { Serial.print(F("T_intake Unplugged"));                                                  break; }
-        case NO__TEMP_EXHAUST_IS_HOT:     { Serial.print(F("Exhaust Too Hot")   );                                                  break; }
+        case NO__ATLEASTONECELL_TOO_HIGH: { buzzer_helper = BUZZER_HIGH;                     break; }
+        case NO__ATLEASTONECELL_TOO_LOW:  { buzzer_helper = BUZZER_HIGH;                     break; }
         //time issue
-        case NO__JUST_PLUGGED_IN:         { Serial.print(F("Plugin Delay")      ); offPeriod_helper = GRID_MIN_OFF_PERIOD__NONE_ms; break; }
-        case NO__LIBCM_JUST_BOOTED:       { Serial.print(F("LiBCM Powerup")     ); offPeriod_helper = GRID_MIN_OFF_PERIOD__NONE_ms; break; }
-        case NO__RECENTLY_TURNED_OFF:     { Serial.print(F("Turnoff Delay")     ); offPeriod_helper = minGridOffPeriod_ms;          break; }
-        //unknown reason
-        default:                          { Serial.print(F("Unknown Reason")    );                                                  break; }
+        case NO__JUST_PLUGGED_IN:         { offPeriod_helper = GRID_MIN_OFF_PERIOD__NONE_ms; break; }
+        case NO__LIBCM_JUST_BOOTED:       { offPeriod_helper = GRID_MIN_OFF_PERIOD__NONE_ms; break; }
+        case NO__RECENTLY_TURNED_OFF:     { offPeriod_helper = minGridOffPeriod_ms;          break; }
+        default:                          {                                                  break; }
     }
 
     minGridOffPeriod_ms = offPeriod_helper;
@@ -120,7 +141,7 @@ void chargerControlSignals_handler(void)
     {
         if (isChargingAllowed_previous != YES__CHARGING_ALLOWED)
         {
-            Serial.print(F("\nCharging"));
+            eventLog_log(EVENT_GRIDCHARGER_ENABLED, 0);
             adc_calibrateBatteryCurrentSensorOffset();
         }
 
@@ -44,4 +44,6 @@
 
     void gridCharger_handler(void);
 
+    void gridCharger_printDisableReason(uint8_t canWeCharge);
+
 #endif
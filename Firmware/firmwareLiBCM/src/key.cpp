@@ -19,14 +19,21 @@ void key_handleKeyEvent_off(void)
     LED(1,LOW);
     BATTSCI_disable(); //Must disable BATTSCI when key is off to prevent backdriving MCM
     METSCI_disable();
+    resetLog_phase(1); //phases show where a watchdog reset occurred (see resetLog.cpp)
     LTC68042cell_acquireAllCellVoltages();
     SoC_updateUsingLatestOpenCircuitVoltage(); //JTS2doLater: Add ten minute delay before VoC->SoC LUT
+    resetLog_phase(2);
     adc_calibrateBatteryCurrentSensorOffset();
     gpio_turnPowerSensors_off();
     LTC68042configure_handleKeyStateChange();
     vPackSpoof_handleKeyOFF();
     //JTS2doLater: Add built-in test suite, including VREF, VCELL, Balancing, temp verify (batt and OEM), etc.
+    resetLog_phase(3);
     eeprom_checkForExpiredFirmware();
+    SoC_snapshot_save(); //MUST run after uptime is updated
+    busStats_save();
+    resetLog_phase(4);
+    batteryHistory_handleKeyOff();
 
     time_latestKeyOff_ms_set(millis()); //MUST RUN LAST!
 }
@@ -37,11 +44,16 @@ void key_handleKeyEvent_on(void)
 {
     delay( eeprom_delayKeyON_ms_get() ); //this is a test tool to verify LiBCM is turning on fast enough to prevent P-code //JTS2doLater: Delete
     Serial.print(F("ON"));
+    resetLog_phase(1);
+    busStats_handleKeyOn();
+    flightRecorder_handleKeyOn();
     BATTSCI_enable();
     METSCI_enable();
     gpio_turnPowerSensors_on();
+    resetLog_phase(2);
     LTC68042configure_programVolatileDefaults(); //turn discharge resistors off, set ADC LPF, etc.
     LTC68042configure_handleKeyStateChange();
+    SoC_EKF_handleKeyOn();
     LED(1,HIGH);
 
     time_latestKeyOn_ms_set(millis()); //MUST RUN LAST!
@@ -66,7 +66,7 @@ uint8_t requestDisplayOff(uint8_t state)
 
             lcdTransmit_displayOff();
 
-            //does the backlight and display stay off if we Wire.end() here?
+            //does the backlight and display stay off if we twi_end() here?
 
             return LCDSTATE_OFF;
         }
@@ -82,6 +82,8 @@ void lcdState_handler(void)
     #ifdef LCD_4X20_CONNECTED
         static uint8_t statePrevious = LCDSTATE_LIBCM_JUST_TURNED_ON;
 
+        twi_handler(); //send transactions that were waiting for LCD to finish previous command
+
         if ((key_getSampledState() == KEYSTATE_OFF) && (gpio_isGridChargerPluggedInNow() == NO))
         {
             //nobody is using display, so turn it off
@@ -3,9 +3,9 @@
 
 //handles all communication with 4x20 lcd display
 
-//The 4x20 LCD I2C bus is super slow... therefore, only one screen variable is updated per superloop iteration.
-//This is handled by token 'lcd_whichFunctionUpdates', which is used for a round-robin scheduler
-//Avoid calling 'lcd2.___' at all costs; it's ALWAYS faster to do math to see if you need to send data to screen.
+//The 4x20 LCD I2C bus is super slow... therefore, 'lcd2.print()' only writes to a shadow framebuffer (RAM).
+//Each superloop iteration, the changed characters are sent to the LCD (up to LCD_I2C_TRANSACTIONS_PER_LOOP).
+//It's still faster to do math to see if a value changed, rather than formatting it every loop.
 
 #include "libcm.h"
 
@@ -36,7 +36,17 @@ bool     areAllStaticValuesDisplayed  =  NO;
 /////////////////////////////////////////////////////////////////////////////////////////
 
 void lcdTransmit_begin(void) { lcd2.begin(20,4); }
-void lcdTransmit_end(void)   { Wire.end();       }
+void lcdTransmit_end(void)   { twi_end();        }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//blocks until the entire shadow framebuffer is on screen
+//only use when the superloop isn't running (e.g. keyOff splashscreen, fatal errors)
+void lcd_sendAllChanges(void)
+{
+    while (lcd2.sendShadowChanges(LCD_I2C_TRANSACTIONS_PER_LOOP) == false) { twi_handler(); }
+    twi_waitUntilIdle();
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -126,10 +136,7 @@ bool lcd_printTime_unitless(void)
         {
             lcd2.setCursor(3,3);
 
-            if      (firmwareExpirationTime_hours < 10  ) { lcd2.print(F("  ")); } //one digit  (  0:   9)
-            else if (firmwareExpirationTime_hours < 100 ) { lcd2.print(F(" ") ); } //two digits ( 10:  99)
-
-            lcd2.print(String(firmwareExpirationTime_hours));
+            printFormat_paddedInt(lcd2, firmwareExpirationTime_hours, 3, ' ');
 
             timeValue_onScreen = firmwareExpirationTime_hours;
             didscreenUpdateOccur = SCREEN_UPDATED;
@@ -144,12 +151,7 @@ bool lcd_printTime_unitless(void)
         {
             lcd2.setCursor(1,3);
 
-            if      (timeSeconds < 10   ) { lcd2.print(F("    ")); } //one   digit  //   0:   9
-            else if (timeSeconds < 100  ) { lcd2.print(F("   ") ); } //two   digits //  10:  99
-            else if (timeSeconds < 1000 ) { lcd2.print(F("  ")  ); } //three digits // 100: 999
-            else if (timeSeconds < 10000) { lcd2.print(F(" ")   ); } //four  digits //1000:9999
-
-            lcd2.print(String(timeSeconds));
+            printFormat_paddedInt(lcd2, timeSeconds, 5, ' ');
 
             timeValue_onScreen = timeSeconds;
             didscreenUpdateOccur = SCREEN_UPDATED;
@@ -324,7 +326,7 @@ bool lcd_printCellVoltage_hi(void)
         didscreenUpdateOccur = SCREEN_UPDATED;
     }
 
-    if (LTC68042result_hiCellVoltage_get() > CELL_VMAX_REGEN) { isBacklightFlashingRequested = YES; }
+    if (LTC68042result_hiCellVoltage_get() > params_get(PARAM_CELL_VMAX_REGEN)) { isBacklightFlashingRequested = YES; }
     else                                                      { isBacklightFlashingRequested =  NO; }
 
     return didscreenUpdateOccur;
@@ -347,7 +349,7 @@ bool lcd_printCellVoltage_lo(void)
 
     static bool isBacklightOn = true;
 
-    if (LTC68042result_loCellVoltage_get() < CELL_VMIN_ASSIST) { isBacklightFlashingRequested = YES; }
+    if (LTC68042result_loCellVoltage_get() < params_get(PARAM_CELL_VMIN_ASSIST)) { isBacklightFlashingRequested = YES; }
     else                                                       { isBacklightFlashingRequested =  NO; }
 
     return didscreenUpdateOccur;
@@ -612,10 +614,14 @@ void lcdTransmit_Warning(uint8_t warningToDisplay)
         lcd2.setCursor(0,1); lcd2.print(F("       count doesn't"));
         lcd2.setCursor(0,2); lcd2.print(F("       match setting"));
         lcd2.setCursor(0,3); lcd2.print(F("       in config.h )"));
+
+        lcd_sendAllChanges(); //superloop isn't running
     }   
 
     if (++whichRowToPrint > 3) { whichRowToPrint = 0; }
 
+    lcd2.sendShadowChanges(LCD_I2C_TRANSACTIONS_PER_LOOP); //unchanged rows aren't resent
+
     areAllStaticValuesDisplayed = NO; //reprint static values once warning message goes away
 }
 
@@ -625,10 +631,12 @@ void lcdTransmit_splashscreenKeyOff(void)
 {
     lcd2.clear();
     lcd2.setCursor(0,0);
-    lcd2.print(F("LiBCM v")); lcd2.print(String(FW_VERSION));
+    lcd2.print(F("LiBCM v")); lcd2.print(F(FW_VERSION));
     lcd2.setCursor(0,1);
     lcd2.print(F("FW Hours Left: "));
-    lcd2.print(String(REQUIRED_FIRMWARE_UPDATE_PERIOD_HOURS - eeprom_uptimeStoredInEEPROM_hours_get() ));
+    lcd2.print((uint16_t)(REQUIRED_FIRMWARE_UPDATE_PERIOD_HOURS - eeprom_uptimeStoredInEEPROM_hours_get()));
+
+    lcd_sendAllChanges(); //screen turns off before next lcdTransmit_printNextElement()
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -668,7 +676,7 @@ bool lcd_updateValue(uint8_t stateToUpdate)
 //individually limit each element's lcd update rate
 uint8_t isMinimumDisplayPeriodMet(uint8_t whichElement)
 {
-    static uint8_t loopCountAtLastUpdate_8b[LCDVALUE_MAX_VALUE] = {127};
+    static uint8_t loopCountAtLastUpdate_8b[LCDVALUE_MAX_VALUE + 1] = {127};
 
     uint8_t absLoopCountDelta = time_getLoopCount_8b() - loopCountAtLastUpdate_8b[whichElement];
 
@@ -683,23 +691,13 @@ uint8_t isMinimumDisplayPeriodMet(uint8_t whichElement)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void updateNextVariable(void)
+//screen elements only write to the shadow framebuffer, so all of them are checked each loop
+void updateAllVariables(void)
 {
-    static uint8_t lcdVariableToUpdate = LCDVALUE_NO_UPDATE; //init round-robin
-
-    bool didScreenUpdateOccur = SCREEN_DIDNT_UPDATE;
-    uint8_t updateAttempts = 0;
-
-    do
+    for (uint8_t lcdVariableToUpdate = 1; lcdVariableToUpdate <= LCDVALUE_MAX_VALUE; lcdVariableToUpdate++)
     {
-        if (isMinimumDisplayPeriodMet(lcdVariableToUpdate) == YES) 
-        {
-            didScreenUpdateOccur = lcd_updateValue(lcdVariableToUpdate);
-        }
-
-        if (++lcdVariableToUpdate > LCDVALUE_MAX_VALUE) { lcdVariableToUpdate = 1; }
-    } while ((didScreenUpdateOccur == SCREEN_DIDNT_UPDATE)    &&
-             (++updateAttempts < LCD_UPDATE_ATTEMPTS_PER_LOOP) );
+        if (isMinimumDisplayPeriodMet(lcdVariableToUpdate) == YES) { lcd_updateValue(lcdVariableToUpdate); }
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -715,6 +713,8 @@ void updateNextVariable(void)
         lcd2.setCursor(0,1);  lcd2.print(F("01234567890123456789"));
         lcd2.setCursor(0,2);  lcd2.print(F("ABCDEFGHIJKLMNOPQRST"));
         lcd2.setCursor(0,3);  lcd2.print(F("UVWXYZ HELLO WORLD!!"));
+
+        lcd_sendAllChanges();
     }
 #endif
 
@@ -738,7 +738,7 @@ void updateNextVariable(void)
         //                              t_firmware*
         //                              FWuuuu=(0,3)  //*This segment cycles between these two parameters
         //
-//this function writes the above static data, one element per call:
+//this function writes the above static data (to the shadow framebuffer), one element per call:
 bool updateNextStatic(void)
 {
     static uint8_t lcdStaticElementToUpdate = LCDSTATIC_SET_DEFAULTS;
@@ -776,11 +776,13 @@ bool updateNextStatic(void)
 /////////////////////////////////////////////////////////////////////////////////////////
 
 //primary interface
-//update one screen element (if any have changed)
+//update all changed screen elements in RAM, then send some of the changed characters to the LCD
 void lcdTransmit_printNextElement(void)
 {
-    if (areAllStaticValuesDisplayed == YES) { updateNextVariable(); }
-    else { areAllStaticValuesDisplayed = updateNextStatic(); } //static values only sent once each time the display turns on
+    if (areAllStaticValuesDisplayed == YES) { updateAllVariables(); }
+    else { while (updateNextStatic() == NO) { ; } areAllStaticValuesDisplayed = YES; } //static values only written once each time the display turns on
+
+    lcd2.sendShadowChanges(LCD_I2C_TRANSACTIONS_PER_LOOP);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
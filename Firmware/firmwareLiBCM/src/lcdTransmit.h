@@ -8,7 +8,7 @@
     #define SCREEN_UPDATED      true
 
     //define screen elements
-    //up to one screen element is updated each loop, using round robbin state machine 
+    //each element writes to the shadow framebuffer when its value changes
     #define LCDVALUE_NO_UPDATE        0
     #define LCDVALUE_CALC_CYCLEFRAME  1
     #define LCDVALUE_SECONDS          2
@@ -31,7 +31,7 @@
     #define LCDVALUE_FLASH_BACKLIGHT 19
     #define LCDVALUE_MAX_VALUE       19 //must equal the highest defined number (above)
 
-    #define LCD_UPDATE_ATTEMPTS_PER_LOOP 10
+    #define LCD_I2C_TRANSACTIONS_PER_LOOP 2 //each transaction sends up to eight characters //entire screen refreshes in five loops
     #define LCD_VALUE_MINIMUM_DISPLAY_TIME_LOOPS 30
 
     //the following static text never changes, and is only sent once each time the display turns on
@@ -67,7 +67,7 @@
     void lcdTransmit_displayOn(void);
     void lcdTransmit_displayOff(void);
 
-    void lcdTransmit_printNextElement(void); //primary interface //each call updates one screen element
+    void lcdTransmit_printNextElement(void); //primary interface //each call sends changed characters to screen
 
     void lcdTransmit_splashscreenKeyOff(void);
 
@@ -14,24 +14,61 @@
 //Low level I2C driver for 4x20 display
 
 //JTS2doLater: Determine if LCD is connected (using NACK/ACK 9th bit)
-//JTS2doLater: Can we add dummy bytes between real bytes, to allow I2C interrupt handler to handle entire "sendCMD()"?
-//4x20 display I2C SCL is running at 100 kHz (100 kHz max)
+//4x20 display I2C SCL runs at 100 kHz (or 400 kHz if LCD_4X20_I2C_FAST_MODE is defined)
+//All I2C transactions are queued, then sent in the background by the TWI ISR (see twi.cpp)
+
+//Text is written to a shadow framebuffer (RAM), rather than directly to the LCD.
+//sendShadowChanges() then sends only the changed characters, packing several characters (and any cursor moves)...
+//into each I2C transaction.  Commands (clear, backlight, etc) are still sent immediately.
 
 #include "Arduino.h"
-#include "Wire.h"
 #include "lcd_I2C.h"
 #include "libcm.h"
 
-#define NO_DELAY 0
-#define ADD_DELAY 1
+#define NO_HOLDOFF 0
+
+volatile bool lcd_I2C_isTransmitErrorPending = NO;
+volatile uint8_t lcd_I2C_consecutiveErrors = 0;
 
-#define SEND_STOP_BIT 0
-#define SEND_RESTART_BIT 1
+uint32_t lcd_I2C_latestRetry_ms = 0;
+uint16_t lcd_I2C_retryBackoff_ms = LCD_I2C_RETRY_BACKOFF_MIN_ms;
 
 lcd_I2C_jts::lcd_I2C_jts(uint8_t address) { _i2cLcdAddress = address; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//called from TWI ISR when each transaction finishes
+void lcd_I2C_transactionComplete(uint8_t status)
+{
+    if (status == TWI_STATUS_OK) { lcd_I2C_consecutiveErrors = 0; }
+    else
+    {
+        lcd_I2C_isTransmitErrorPending = YES; //some characters weren't displayed
+        if (lcd_I2C_consecutiveErrors < 0xFF) { lcd_I2C_consecutiveErrors++; }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns NO while waiting to resend the screen after repeated failures
+bool lcd_I2C_isRetryAllowed(void)
+{
+    if (lcd_I2C_consecutiveErrors < LCD_I2C_ERRORS_BEFORE_BACKOFF)
+    {
+        lcd_I2C_retryBackoff_ms = LCD_I2C_RETRY_BACKOFF_MIN_ms; //display is responding
+        return YES;
+    }
+
+    if ((millis() - lcd_I2C_latestRetry_ms) < lcd_I2C_retryBackoff_ms) { return NO; }
+
+    lcd_I2C_latestRetry_ms = millis();
+    if (lcd_I2C_retryBackoff_ms < LCD_I2C_RETRY_BACKOFF_MAX_ms) { lcd_I2C_retryBackoff_ms <<= 1; }
+
+    return YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 void lcd_I2C_jts::setRowOffsets(int row1, int row2, int row3, int row4)
 {
     _rowOffsets[0] = row1;
@@ -42,53 +79,33 @@ void lcd_I2C_jts::setRowOffsets(int row1, int row2, int row3, int row4)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-//command to send one byte to the LCD display (containing DATA_PORTION nibble & CTRL_PORTION nibble)
+//queue one byte to the LCD display (containing DATA_PORTION nibble & CTRL_PORTION nibble)
 void lcd_I2C_jts::send(uint8_t byte) 
 { 
-    //time                bytes sent  time/Byte
-    //t= 39 microseconds      1B        39 us/B
-    //t= 52 microseconds      4B        13 us/B
-    //t= 71 microseconds      9B         8 us/B
-    //t=162 microseconds     31B         5 us/B
-    Wire.beginTransmission(_i2cLcdAddress); //~5 microseconds
-    Wire.write(byte);
-
-    // test packets
-    // Wire.write(0xFF);
-    // Wire.write(0x00);
-    // Wire.write(0B01010101);
-    // Wire.write(0x00);
-
-    Wire.endTransmission(SEND_RESTART_BIT); //Wire transmits all bytes in buffer
+    twi_transaction_begin(_i2cLcdAddress, 1);
+    twi_transaction_write(byte);
+    twi_transaction_end(NO_HOLDOFF, lcd_I2C_transactionComplete);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 // Merge the command quartet with the control command (BL EN RW RS)
-void lcd_I2C_jts::sendQuartet(uint8_t data, uint8_t includeDelayAfterWrite)
+void lcd_I2C_jts::sendQuartet(uint8_t data, uint16_t holdoff_us)
 {
-    data |= _ctrlRegister;
-  
-    //send(data); //Not necessary, per HD44780U timing diagram (page 22)
-
-    send(data | EN_BIT); // set EN ('E') line high.  Note: HD44780U latches nibble when 'E' line goes low.
-    //delayMicroseconds(1); //HD44780U requires 400 ns delay
-    send(data); //set EN ('E') line back low.  This latches data nibble into HD44780U's buffer 
-  
-    if (includeDelayAfterWrite) { delayMicroseconds(40); } //Guarantee HD44780U has processed data 
+    twi_transaction_begin(_i2cLcdAddress, 2);
+    queueQuartet(data);
+    twi_transaction_end(holdoff_us, lcd_I2C_transactionComplete);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 // Take a command byte and split it in two quartets (LCD operates in 4 bit mode)
-// This is the primary method used to send data to display
-void lcd_I2C_jts::sendCmd(uint8_t data) //t=200 microseconds
+// Only commands longer than HD44780U's 37 us execution time need a holdoff (see queueCmd())
+void lcd_I2C_jts::sendCmd(uint8_t data, uint16_t holdoff_us)
 {
-    sendQuartet( (data & DATA_PORTION), NO_DELAY);
-
-    //JTS: Can delay as long as desired (i.e. split interrupt handler here if desired)
-
-    sendQuartet( ((data << 4) & DATA_PORTION), ADD_DELAY);
+    twi_transaction_begin(_i2cLcdAddress, LCD_I2C_BYTES_PER_CHARACTER);
+    queueCmd(data);
+    twi_transaction_end(holdoff_us, lcd_I2C_transactionComplete);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -118,18 +135,136 @@ void lcd_I2C_jts::setEntryModeBit(uint8_t bit, bool state)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-// write a byte to the I2C bus
+// write a byte to the shadow framebuffer (sendShadowChanges() sends it to the LCD)
 size_t lcd_I2C_jts::write(uint8_t byte)
 {
-    _ctrlRegister |= RS_BIT; // Set register to DATA
-    sendCmd(byte);
-    _ctrlRegister &= ~RS_BIT; // Reset register to INSTRUCTION
+    if ((_shadowRow < LCD_SHADOW_ROWS) && (_shadowCol < LCD_SHADOW_COLS))
+    {
+        if (_shadow[_shadowRow][_shadowCol] != byte)
+        {
+            _shadow[_shadowRow][_shadowCol] = byte;
+            _dirtyColumns[_shadowRow] |= ((uint32_t)1 << _shadowCol);
+        }
+
+        _shadowCol++;
+    }
+    //characters past the end of each row are discarded
 
     return 1;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+// Shadow framebuffer matches LCD after LCD_CLEARDISPLAY
+void lcd_I2C_jts::resetShadow()
+{
+    for (uint8_t row = 0; row < LCD_SHADOW_ROWS; row++)
+    {
+        for (uint8_t col = 0; col < LCD_SHADOW_COLS; col++) { _shadow[row][col] = ' '; }
+        _dirtyColumns[row] = 0;
+    }
+
+    _shadowCol = 0;
+    _shadowRow = 0;
+    _ddramAddress = 0x00; //LCD_CLEARDISPLAY also resets address counter
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool lcd_I2C_jts::isShadowOnScreen()
+{
+    for (uint8_t row = 0; row < LCD_SHADOW_ROWS; row++) { if (_dirtyColumns[row] != 0) { return false; } }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Add one nibble to the transaction (EN high, then EN low to latch)
+// Caller must call twi_transaction_begin() first
+void lcd_I2C_jts::queueQuartet(uint8_t data)
+{
+    data |= _ctrlRegister;
+
+    twi_transaction_write(data | EN_BIT); // set EN ('E') line high.  Note: HD44780U latches nibble when 'E' line goes low.
+    twi_transaction_write(data);          // set EN ('E') line back low.  This latches data nibble into HD44780U's buffer
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Add one command/data byte to the transaction
+// No delay is required between queued bytes: each byte latches at least two I2C bytes after the previous one...
+// which is longer than HD44780U's 37 us execution time (even at 400 kHz)
+void lcd_I2C_jts::queueCmd(uint8_t data)
+{
+    queueQuartet(  data       & DATA_PORTION);
+    queueQuartet( (data << 4) & DATA_PORTION);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Queue changed characters, using up to 'maxTransactions' I2C transactions
+// Each transaction sends up to eight characters (fewer when the cursor must move)
+// Never waits: stops early if the TWI queue is full
+bool lcd_I2C_jts::sendShadowChanges(uint8_t maxTransactions)
+{
+    if (lcd_I2C_isTransmitErrorPending == YES)
+    {
+        if (lcd_I2C_isRetryAllowed() == NO) { return true; } //changes stay dirty until next retry
+
+        //resend entire screen
+        lcd_I2C_isTransmitErrorPending = NO;
+        for (uint8_t row = 0; row < LCD_SHADOW_ROWS; row++) { _dirtyColumns[row] = ((uint32_t)1 << LCD_SHADOW_COLS) - 1; }
+        _ddramAddress = LCD_DDRAM_ADDRESS_UNKNOWN;
+    }
+
+    uint8_t row = 0;
+
+    while (maxTransactions > 0)
+    {
+        if (isShadowOnScreen() == true)                                   { return true;  }
+        if (twi_isSpaceAvailable(LCD_I2C_BYTES_PER_TRANSACTION) == NO) { return false; }
+
+        uint8_t bytesQueued = 0;
+        twi_transaction_begin(_i2cLcdAddress, LCD_I2C_BYTES_PER_TRANSACTION);
+
+        while (row < LCD_SHADOW_ROWS)
+        {
+            if (_dirtyColumns[row] == 0) { row++; continue; }
+
+            uint8_t col = 0;
+            while ((_dirtyColumns[row] & ((uint32_t)1 << col)) == 0) { col++; }
+
+            uint8_t address = col + _rowOffsets[row];
+
+            uint8_t bytesRequired = LCD_I2C_BYTES_PER_CHARACTER;
+            if (address != _ddramAddress) { bytesRequired += LCD_I2C_BYTES_PER_CHARACTER; } //cursor move
+
+            if ((bytesQueued + bytesRequired) > LCD_I2C_BYTES_PER_TRANSACTION) { break; } //transaction is full
+
+            if (address != _ddramAddress) { queueCmd(LCD_SETDDRAMADDR | address); }
+
+            _ctrlRegister |= RS_BIT; // Set register to DATA
+            queueCmd(_shadow[row][col]);
+            _ctrlRegister &= ~RS_BIT; // Reset register to INSTRUCTION
+
+            bytesQueued += bytesRequired;
+            _dirtyColumns[row] &= ~((uint32_t)1 << col);
+
+            //HD44780U auto-increments address counter, except at the end of each DDRAM line
+            if ((address == 0x27) || (address == 0x67)) { _ddramAddress = LCD_DDRAM_ADDRESS_UNKNOWN; }
+            else                                        { _ddramAddress = address + 1;               }
+        }
+
+        twi_transaction_end(NO_HOLDOFF, lcd_I2C_transactionComplete);
+
+        maxTransactions--;
+    }
+
+    return isShadowOnScreen();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 // Initialization routine to set the LCD to 4 bit mode
 void lcd_I2C_jts::initializationRoutine()
 {
@@ -139,15 +274,13 @@ void lcd_I2C_jts::initializationRoutine()
     // (HD44780U datasheet, page 45)
     // It also may be optional, useful only when:
     //"the power supply conditions for correctly operating the internal reset circuit are not met"
-    sendQuartet( (LCD_FUNCTIONSET | LCD_FUNCTIONSET_DL_BIT), ADD_DELAY);
-    delayMicroseconds(4200); //JTS2doLater: split this function into multiple calls, so it doesn't add so much delay
-    sendQuartet( (LCD_FUNCTIONSET | LCD_FUNCTIONSET_DL_BIT), ADD_DELAY); 
-    delayMicroseconds(110);
-    sendQuartet( (LCD_FUNCTIONSET | LCD_FUNCTIONSET_DL_BIT), ADD_DELAY); 
+    sendQuartet( (LCD_FUNCTIONSET | LCD_FUNCTIONSET_DL_BIT), LCD_HOLDOFF_INIT_1ST_us);
+    sendQuartet( (LCD_FUNCTIONSET | LCD_FUNCTIONSET_DL_BIT), LCD_HOLDOFF_INIT_2ND_us); 
+    sendQuartet( (LCD_FUNCTIONSET | LCD_FUNCTIONSET_DL_BIT), NO_HOLDOFF); 
     //The above three commands guarantee HD44780U is in known state (see datasheet)
 
     // set in 4-bit mode (Function set)
-    sendQuartet(LCD_FUNCTIONSET, ADD_DELAY);
+    sendQuartet(LCD_FUNCTIONSET, NO_HOLDOFF);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -186,10 +319,12 @@ void lcd_I2C_jts::setEntryMode(uint8_t increment, uint8_t shift)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+// Move shadow framebuffer cursor (LCD cursor is moved by sendShadowChanges())
 void lcd_I2C_jts::setCursor(uint8_t col, uint8_t row)
 {
     if ((row >= _rows) | (row >= 4)) { row = _rows - 1; }
-    sendCmd(LCD_SETDDRAMADDR | (col + _rowOffsets[row]));
+    _shadowCol = col;
+    _shadowRow = row;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -197,8 +332,8 @@ void lcd_I2C_jts::setCursor(uint8_t col, uint8_t row)
 // Clear display
 void lcd_I2C_jts::clear()
 {
-    sendCmd(LCD_CLEARDISPLAY);
-    delay(2);
+    sendCmd(LCD_CLEARDISPLAY, LCD_HOLDOFF_CLEAR_us);
+    resetShadow();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -206,8 +341,8 @@ void lcd_I2C_jts::clear()
 // Set cursor to 0;0 position
 void lcd_I2C_jts::home()
 {
-    sendCmd(LCD_RETURNHOME);
-    delay(2);
+    sendCmd(LCD_RETURNHOME, LCD_HOLDOFF_CLEAR_us);
+    _ddramAddress = 0x00;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -215,8 +350,7 @@ void lcd_I2C_jts::home()
 // Setting up and initializig the LCD 
 void lcd_I2C_jts::begin(uint8_t cols, uint8_t rows, uint8_t font)
 {
-    Wire.begin();
-    Wire.setWireTimeout(1000, true); //waits up to 1000 microseconds
+    twi_begin(LCD_I2C_SCL_Hz);
     _cols = cols;
     _rows = rows;
     _font = font;
@@ -261,6 +395,8 @@ void lcd_I2C_jts::createChar(uint8_t index, uint8_t character[])
 
     for (uint8_t i=0; i<8; i++) { sendCmd(character[i]); }
     _ctrlRegister &= ~RS_BIT; // Reset register to INSTRUCTION
+
+    _ddramAddress = LCD_DDRAM_ADDRESS_UNKNOWN; //address counter now points to CGRAM
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
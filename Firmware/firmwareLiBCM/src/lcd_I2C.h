@@ -17,7 +17,6 @@
 
     #include <inttypes.h>
     #include "Arduino.h"
-    #include "Wire.h"
     #include "Print.h"
 
     /*
@@ -35,6 +34,33 @@
     #define LCD_5x10DOTS 1
     #define LCD_5x8DOTS  0
 
+    //shadow framebuffer size
+    #define LCD_SHADOW_COLS 20
+    #define LCD_SHADOW_ROWS  4
+
+    //each character is two nibbles, and each nibble is sent twice (EN high, then EN low)
+    #define LCD_I2C_BYTES_PER_CHARACTER    4
+    #define LCD_I2C_BYTES_PER_TRANSACTION 32 //up to eight characters per transaction
+
+    #ifdef LCD_4X20_I2C_FAST_MODE
+        #define LCD_I2C_SCL_Hz TWI_SCL_FAST_MODE_Hz
+    #else
+        #define LCD_I2C_SCL_Hz TWI_SCL_STANDARD_MODE_Hz
+    #endif
+
+    //HD44780U execution times that are longer than the gap between transactions
+    #define LCD_HOLDOFF_CLEAR_us    2000
+    #define LCD_HOLDOFF_INIT_1ST_us 4200
+    #define LCD_HOLDOFF_INIT_2ND_us  110
+
+    #define LCD_DDRAM_ADDRESS_UNKNOWN 0xFF
+
+    //failed transactions (e.g. display unplugged) resend the entire screen
+    //after several consecutive failures, each resend waits longer than the previous one (up to LCD_I2C_RETRY_BACKOFF_MAX_ms)
+    #define LCD_I2C_ERRORS_BEFORE_BACKOFF    3
+    #define LCD_I2C_RETRY_BACKOFF_MIN_ms   100
+    #define LCD_I2C_RETRY_BACKOFF_MAX_ms  6400
+
     /*
      * Command definitions
      * 
@@ -104,15 +130,29 @@
         uint8_t _font;
 
         uint8_t _rowOffsets[4];
+
+        /*
+        * Shadow framebuffer
+        * print()/write() only modify RAM; sendShadowChanges() transmits characters that differ from what the LCD holds
+        */
+        uint8_t  _shadow[LCD_SHADOW_ROWS][LCD_SHADOW_COLS];
+        uint32_t _dirtyColumns[LCD_SHADOW_ROWS]; //bit n set when column n hasn't been sent to LCD yet
+        uint8_t  _shadowCol = 0;
+        uint8_t  _shadowRow = 0;
+        uint8_t  _ddramAddress = LCD_DDRAM_ADDRESS_UNKNOWN; //LCD's address counter //sequential characters don't need a cursor move
         
         void initializationRoutine();
+        void resetShadow();
+        bool isShadowOnScreen();
+        void queueQuartet(uint8_t data);
+        void queueCmd(uint8_t data);
 
         void send(uint8_t data);
-        void sendQuartet(uint8_t data, uint8_t includeDelayAfterWrite);
+        void sendQuartet(uint8_t data, uint16_t holdoff_us);
         void setCtrlRegisterBit(uint8_t bit, bool state);
         void setDsplRegisterBit(uint8_t bit, bool state);
         void setEntryModeBit(uint8_t bit, bool state);
-        void sendCmd(uint8_t data);
+        void sendCmd(uint8_t data, uint16_t holdoff_us = 0);
     public:
         lcd_I2C_jts(uint8_t address);
         
@@ -127,6 +167,8 @@
 
         virtual size_t write(uint8_t);
 
+        bool sendShadowChanges(uint8_t maxTransactions); //returns true once all changes are queued (see twi.cpp)
+
         // Faster than using LiquidCrystal Library compatible functions
         // Set multiple bits, send one time
         void setFctnRegister(uint8_t bytemode, uint8_t lines, uint8_t font = LCD_5x8DOTS);
@@ -15,20 +15,26 @@
     //define standard libraries used by LiBCM
     #include <Arduino.h>
     #include <avr/wdt.h>
+    #include <util/crc16.h>
 
     //Define LiBCM system include files.  Note: Do not alter order.
     #include "../config.h"
     #include "cpu_map.h"
     #include "debugLED.h"
+    #include "printFormat.h"
     #include "debugUSB.h"
+    #include "eventLog.h"
+    #include "telemetry.h"
     #include "gpio.h"
     #include "key.h"
     #include "LT_SPI.h"
+    #include "busStats.h"
     #include "battsci.h"
     #include "metsci.h"
     #include "LiDisplay.h"
     #include "adc.h"
     #include "vPackSpoof.h"
+    #include "twi.h"
     #include "lcdState.h"
     #include "lcdTransmit.h"
     #include "gridCharger.h"
@@ -38,8 +44,10 @@
     #include "LTC68042result.h"
     #include "BringupTester.h"
     #include "SoC.h"
+    #include "SoC_EKF.h"
     #include "temperature.h"
     #include "eepromAccess.h"
+    #include "params.h"
     #include "cellBalance.h"
     #include "time.h"
     #include "USB_userInterface.h"
@@ -49,5 +57,8 @@
     #include "heater.h"
     #include "LiControl.h"
     #include "batteryHistory.h"
+    #include "flightRecorder.h"
+    #include "resetLog.h"
+    #include "ramMonitor.h"
 
 #endif
@@ -122,23 +122,107 @@
 
 #include "libcm.h"
 
+//METSCI bytes are received by the USART3 RX interrupt, which assembles each frame (see ISR(USART3_RX_vect) below)
+//The main loop reads the latest frame in constant time, without scanning a serial buffer
+//Serial3 MUST NOT be used anywhere (Arduino's Serial3 RX interrupt would conflict with LiBCM's)
+
 struct packetTypes
 {
     uint8_t latestE6Packet_assistLevel;
     uint8_t latestB4Packet_engine;
     uint8_t latestB3Packet_engine;
     uint8_t latestE1Packet_SoC;
-} METSCI_Packets;
+};
+
+struct frameTypes
+{
+    packetTypes packets;
+    uint8_t  latestPacketType; //Byte3 //only used for debug
+    uint16_t sequence;         //increments each time a frame is published
+    uint32_t timestamp_us;     //when the frame's last byte was received
+};
+
+//double buffer //ISR writes one frame while the main loop reads the other
+volatile frameTypes METSCI_frames[2];
+volatile uint8_t METSCI_frameToRead = 0;
+
+//ISR working values (only accessed inside ISR, or with interrupts disabled)
+packetTypes isr_packets;
+uint8_t  isr_state = METSCI_STATE_WAIT_FOR_E6;
+uint8_t  isr_assistLevel = 0;
+uint8_t  isr_packetType = 0;
+uint8_t  isr_packetData = 0;
+uint16_t isr_sequence = 0;
+uint32_t isr_previousFrame_us = 0;
+bool     isr_isPreviousFrameValid = NO; //NO until first frame after keyON
+
+//raw bytes, for BATTSCI->METSCI loopback test (see BringupTester)
+volatile uint8_t METSCI_rawBytes[METSCI_RAW_BUFFER_SIZE];
+volatile uint8_t METSCI_rawBytes_head = 0;
+volatile uint8_t METSCI_rawBytes_tail = 0;
+
+uint16_t METSCI_parseLatency_us = 0;
+uint16_t METSCI_parseLatencyMax_us = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t METSCI_getPacketB3(){ return METSCI_Packets.latestB3Packet_engine;      }
-uint8_t METSCI_getPacketB4(){ return METSCI_Packets.latestB4Packet_engine;      }
-uint8_t METSCI_getPacketE1(){ return METSCI_Packets.latestE1Packet_SoC;         }
-uint8_t METSCI_getPacketE6(){ return METSCI_Packets.latestE6Packet_assistLevel; }
+uint8_t METSCI_getPacketB3(){ return METSCI_frames[METSCI_frameToRead].packets.latestB3Packet_engine;      }
+uint8_t METSCI_getPacketB4(){ return METSCI_frames[METSCI_frameToRead].packets.latestB4Packet_engine;      }
+uint8_t METSCI_getPacketE1(){ return METSCI_frames[METSCI_frameToRead].packets.latestE1Packet_SoC;         }
+uint8_t METSCI_getPacketE6(){ return METSCI_frames[METSCI_frameToRead].packets.latestE6Packet_assistLevel; }
+
+//use when reading more than one packet (individual getters above might return values from different frames)
+void METSCI_getLatestPackets(uint8_t *packetE6, uint8_t *packetB3, uint8_t *packetB4, uint8_t *packetE1)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    uint8_t frame = METSCI_frameToRead;
+    *packetE6 = METSCI_frames[frame].packets.latestE6Packet_assistLevel;
+    *packetB3 = METSCI_frames[frame].packets.latestB3Packet_engine;
+    *packetB4 = METSCI_frames[frame].packets.latestB4Packet_engine;
+    *packetE1 = METSCI_frames[frame].packets.latestE1Packet_SoC;
+
+    SREG = oldSREG;
+}
+
+uint16_t METSCI_parseLatency_us_get(void)    { return METSCI_parseLatency_us;    }
+uint16_t METSCI_parseLatencyMax_us_get(void) { return METSCI_parseLatencyMax_us; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//time since the latest frame was received (or since keyON, if no frames yet)
+uint32_t METSCI_latestFrameAge_ms(void)
+{
+    noInterrupts();
+    uint32_t timestamp_us = METSCI_frames[METSCI_frameToRead].timestamp_us;
+    interrupts();
+
+    return (micros() - timestamp_us) / 1000;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//copy ISR working values into the frame the main loop isn't reading, then swap frames
+//only call from ISR, or with interrupts disabled
+void METSCI_publishFrame(uint32_t timestamp_us)
+{
+    uint8_t frameToWrite = METSCI_frameToRead ^ 1;
+
+    METSCI_frames[frameToWrite].packets.latestE6Packet_assistLevel = isr_packets.latestE6Packet_assistLevel;
+    METSCI_frames[frameToWrite].packets.latestB4Packet_engine      = isr_packets.latestB4Packet_engine;
+    METSCI_frames[frameToWrite].packets.latestB3Packet_engine      = isr_packets.latestB3Packet_engine;
+    METSCI_frames[frameToWrite].packets.latestE1Packet_SoC         = isr_packets.latestE1Packet_SoC;
+    METSCI_frames[frameToWrite].latestPacketType = isr_packetType;
+    METSCI_frames[frameToWrite].sequence = ++isr_sequence;
+    METSCI_frames[frameToWrite].timestamp_us = timestamp_us;
+
+    METSCI_frameToRead = frameToWrite;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//9600 baud, 8 data bits, even parity, 1 stop bit
 void METSCI_begin(void)
 {
     pinMode(PIN_METSCI_DE, OUTPUT);
@@ -147,128 +231,218 @@ void METSCI_begin(void)
     pinMode(PIN_METSCI_REn, OUTPUT);
     digitalWrite(PIN_METSCI_REn,HIGH);
 
-    Serial3.begin(9600,SERIAL_8E1);
+    UCSR3A = (1 << U2X3); //double speed mode (lower baud rate error)
+    UBRR3H = highByte(METSCI_UBRR_VALUE);
+    UBRR3L =  lowByte(METSCI_UBRR_VALUE);
+    UCSR3C = (1 << UPM31) | (1 << UCSZ31) | (1 << UCSZ30); //even parity, 8 data bits
+    UCSR3B = (1 << RXEN3) | (1 << TXEN3) | (1 << RXCIE3);  //TX unused, but enabled so the pin idles high
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 void METSCI_enable(void)
 {
-    digitalWrite(PIN_METSCI_REn,LOW);
+    gpio_fastWrite(PIN_METSCI_REn, LOW);
 
-    //MCM throws CEL if old data sent when key first turned on
-    METSCI_Packets.latestB4Packet_engine = 0x18; //OEM BCM transmits 0x18 on BATTSCI until first valid B4 packet received on METSCI
-    METSCI_Packets.latestE6Packet_assistLevel = 0x40; // 0x40 is "zero bars assist/regen"
-    METSCI_Packets.latestB3Packet_engine = 0x06; //OEM BCM transmits 0x06 on BATTSCI until first valid B3 packet received on METSCI
-    METSCI_Packets.latestE1Packet_SoC = 0x00;
+    noInterrupts();
+    {
+        //MCM throws CEL if old data sent when key first turned on
+        isr_packets.latestB4Packet_engine = 0x18; //OEM BCM transmits 0x18 on BATTSCI until first valid B4 packet received on METSCI
+        isr_packets.latestE6Packet_assistLevel = 0x40; // 0x40 is "zero bars assist/regen"
+        isr_packets.latestB3Packet_engine = 0x06; //OEM BCM transmits 0x06 on BATTSCI until first valid B3 packet received on METSCI
+        isr_packets.latestE1Packet_SoC = 0x00;
+        isr_state = METSCI_STATE_WAIT_FOR_E6;
+        isr_isPreviousFrameValid = NO;
+        METSCI_publishFrame(micros());
+    }
+    interrupts();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-void METSCI_disable() { digitalWrite(PIN_METSCI_REn,HIGH); } //prevent backdriving MCM (thru METSCI bus)
+void METSCI_disable() { gpio_fastWrite(PIN_METSCI_REn, HIGH); } //prevent backdriving MCM (thru METSCI bus)
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+//returns oldest raw byte received
 uint8_t METSCI_readByte(void)
 {
-    uint8_t data = Serial3.read();
-    if ((debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BATTMETSCI) &&
-        (data != 0xE6)                                                   ) //METSCI frames begin with 0xE6. 'E6' printed in METSCI_processLatestFrame()
+    uint8_t data = 0;
+
+    if (METSCI_rawBytes_tail != METSCI_rawBytes_head)
     {
-        if (data < 0x10) { Serial.print('0'); } //print leading zero for single digit hex
-        Serial.print(data,HEX);
-        Serial.print(',');
+        data = METSCI_rawBytes[METSCI_rawBytes_tail];
+        METSCI_rawBytes_tail = (METSCI_rawBytes_tail + 1) & (METSCI_RAW_BUFFER_SIZE - 1);
     }
-  
+
     return data;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t METSCI_bytesAvailableToRead(void) { return Serial3.available(); }
+uint8_t METSCI_bytesAvailableToRead(void) { return (METSCI_rawBytes_head - METSCI_rawBytes_tail) & (METSCI_RAW_BUFFER_SIZE - 1); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-//If a new frame isn't available in the serial receive buffer when this function is called,
-//then the previous frame is returned immediately. No time to wait around for 9600 baud frames!
-void METSCI_processLatestFrame(void)
+//only call from ISR
+void METSCI_logFramePeriod(uint32_t timestamp_us)
+{
+    if (isr_isPreviousFrameValid == YES) { busStats_logFramePeriod(BUS_METSCI, timestamp_us - isr_previousFrame_us); }
+    isr_previousFrame_us = timestamp_us;
+    isr_isPreviousFrameValid = YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//Frames are assembled one byte at a time, as each byte arrives
+//Each complete frame is published to the main loop (see METSCI_publishFrame())
+ISR(USART3_RX_vect)
 {
-    while (METSCI_bytesAvailableToRead() > (METSCI_BYTES_IN_FRAME << 1))
+    uint32_t timestamp_us = micros(); //RX complete interrupt occurs during the stop bit
+    uint8_t status = UCSR3A; //MUST read before UDR3
+    uint8_t data = UDR3;
+
+    //store raw byte //oldest byte is overwritten if buffer is full
+    METSCI_rawBytes[METSCI_rawBytes_head] = data;
+    METSCI_rawBytes_head = (METSCI_rawBytes_head + 1) & (METSCI_RAW_BUFFER_SIZE - 1);
+    if (METSCI_rawBytes_head == METSCI_rawBytes_tail) { METSCI_rawBytes_tail = (METSCI_rawBytes_tail + 1) & (METSCI_RAW_BUFFER_SIZE - 1); }
+
+    if (status & ((1 << FE3) | (1 << UPE3) | (1 << DOR3)))
     {
-        //serial receive buffer contains more than two full frames //we've somehow fallen behind
-        Serial.print(F("\nMETSCI stale.  Discarding frame: "));
-        for (int ii=0; ii < METSCI_BYTES_IN_FRAME; ii++) { Serial.print(String(METSCI_readByte(), HEX) ); } //Display (and delete) oldest frame
+        //framing error, parity error, or previous byte lost //discard partial frame
+        if (status & (1 << FE3))  { busStats_increment(BUS_METSCI, BUS_STAT_FRAMING_ERRORS); }
+        if (status & (1 << UPE3)) { busStats_increment(BUS_METSCI, BUS_STAT_PARITY_ERRORS);  }
+        if (status & (1 << DOR3)) { busStats_increment(BUS_METSCI, BUS_STAT_OVERRUN_ERRORS); }
+        busStats_add(BUS_METSCI, BUS_STAT_BYTES_DISCARDED, isr_state + 1); //isr_state is the number of bytes already received in this frame
+        isr_state = METSCI_STATE_WAIT_FOR_E6;
+        return;
     }
 
-    //At this point the serial receive buffer contains at most the two latest complete frames
-    //If everything is in sync, then the next six bytes are a complete frame, and the first byte is 0xE6.
-    if (METSCI_bytesAvailableToRead() > METSCI_BYTES_IN_FRAME)  //Verify a full frame exists in the buffer
+    switch (isr_state)
     {
-        uint8_t resyncAttempt = 0; //prevents endless loop by bailing after N tries
-
-        while (METSCI_readByte() != 0xE6)  //Ensure the first byte is 0xE6 //JTS2doLater: See if keyONinitial pattern "E6,E6,E1,E6" occurs with LiBCM installed
-        {
-            //throw away data until the next frame starts (0xE6 byte)
-            if (resyncAttempt == 0) { Serial.print( F("\nMETSCI buffer sync") ); }
-            else                    { Serial.print('.'); }
-
-            resyncAttempt++;
-            if (resyncAttempt > METSCI_BYTES_IN_FRAME) { return; } //prevent hang if METSCI signal is corrupt (i.e. 0xE6 never occurs)
-        }
-
-        //If we get here, then we've read the first byte, which is 0xE6
-        if (debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BATTMETSCI) { Serial.print(F(" MET:E6,")); }
-
-        //now read the remaining five bytes in the frame
-        uint8_t packetType = 0xE6;              //Byte0 (always 0xE6) (we discarded it above)
-        uint8_t packetData = METSCI_readByte(); //Byte1 (always number of bars assist/regen)
-        uint8_t packetCRC  = METSCI_readByte(); //Byte2 (checksum)
-
-        if (METSCI_isChecksumValid(packetType, packetData, packetCRC))
-        {
-            METSCI_Packets.latestE6Packet_assistLevel = packetData;
-
-            packetType = METSCI_readByte(); //Byte3 (either 0xE1, 0xB3, or 0xB4)
-            packetData = METSCI_readByte(); //Byte4 (data)
-            packetCRC  = METSCI_readByte(); //Byte5 (checksum)
-            if (METSCI_isChecksumValid(packetType, packetData, packetCRC))
+        case METSCI_STATE_WAIT_FOR_E6: //Byte0
+            if (data == 0xE6) { isr_state = METSCI_STATE_E6_DATA; }
+            else { busStats_increment(BUS_METSCI, BUS_STAT_BYTES_DISCARDED); } //throw away data until the next frame starts
+            break;
+
+        case METSCI_STATE_E6_DATA: //Byte1
+            isr_assistLevel = data;
+            isr_state = METSCI_STATE_E6_CHECKSUM;
+            break;
+
+        case METSCI_STATE_E6_CHECKSUM: //Byte2
+            if (METSCI_isChecksumValid(0xE6, isr_assistLevel, data))
             {
-                if      ( packetType == 0xB4 ) { METSCI_Packets.latestB4Packet_engine = packetData; }
-                else if ( packetType == 0xB3 ) { METSCI_Packets.latestB3Packet_engine = packetData; }
-                else if ( packetType == 0xE1 ) { METSCI_Packets.latestE1Packet_SoC    = packetData; }
+                isr_packets.latestE6Packet_assistLevel = isr_assistLevel;
+                isr_state = METSCI_STATE_PACKET_TYPE;
             }
-            else //unknown packet type received
+            else
             {
-                Serial.print(F("\nUnknown METSCI packet type:"));
-                Serial.print(String(packetType,HEX));
-                Serial.print(F(", value:"));
-                Serial.print(String(packetData,HEX));
-
-                //JTS2doLater: Why nuke all values after reading an unknown packet type?
-                METSCI_Packets.latestB4Packet_engine = 0;
-                METSCI_Packets.latestB3Packet_engine = 0;
-                METSCI_Packets.latestE1Packet_SoC    = 0;
+                //0xE6 checksum invalid
+                busStats_increment(BUS_METSCI, BUS_STAT_CHECKSUM_ERRORS);
+                eventLog_log(EVENT_METSCI_CHECKSUM_ERROR, 0xE6);
+                isr_packets.latestE6Packet_assistLevel = 0;
+                METSCI_logFramePeriod(timestamp_us);
+                METSCI_publishFrame(timestamp_us);
+                isr_state = METSCI_STATE_WAIT_FOR_E6;
             }
-        }
-        else
-        {
-            //0xE6 checksum invalid
-            METSCI_Packets.latestE6Packet_assistLevel = 0;
-        }
+            break;
+
+        case METSCI_STATE_PACKET_TYPE: //Byte3 (either 0xE1, 0xB3, or 0xB4)
+            if (data == 0xE6)
+            {
+                //previous frame was truncated //0xE6 is never a packet type
+                busStats_add(BUS_METSCI, BUS_STAT_BYTES_DISCARDED, 3); //previous frame's 0xE6 packet
+                eventLog_log(EVENT_METSCI_RESYNC, 0);
+                isr_state = METSCI_STATE_E6_DATA;
+            }
+            else
+            {
+                isr_packetType = data;
+                isr_state = METSCI_STATE_PACKET_DATA;
+            }
+            break;
+
+        case METSCI_STATE_PACKET_DATA: //Byte4
+            isr_packetData = data;
+            isr_state = METSCI_STATE_PACKET_CHECKSUM;
+            break;
+
+        case METSCI_STATE_PACKET_CHECKSUM: //Byte5
+            if (METSCI_isChecksumValid(isr_packetType, isr_packetData, data))
+            {
+                if      ( isr_packetType == 0xB4 ) { isr_packets.latestB4Packet_engine = isr_packetData; }
+                else if ( isr_packetType == 0xB3 ) { isr_packets.latestB3Packet_engine = isr_packetData; }
+                else if ( isr_packetType == 0xE1 ) { isr_packets.latestE1Packet_SoC    = isr_packetData; }
+                else { eventLog_log(EVENT_METSCI_UNKNOWN_PACKET, ((uint16_t)isr_packetType << 8) | isr_packetData); }
+                busStats_increment(BUS_METSCI, BUS_STAT_FRAMES_OK);
+            }
+            else
+            {
+                busStats_increment(BUS_METSCI, BUS_STAT_CHECKSUM_ERRORS);
+                eventLog_log(EVENT_METSCI_CHECKSUM_ERROR, isr_packetType);
+                //JTS2doLater: Why nuke all values after reading an invalid packet?
+                isr_packets.latestB4Packet_engine = 0;
+                isr_packets.latestB3Packet_engine = 0;
+                isr_packets.latestE1Packet_SoC    = 0;
+            }
+            METSCI_logFramePeriod(timestamp_us);
+            METSCI_publishFrame(timestamp_us);
+            isr_state = METSCI_STATE_WAIT_FOR_E6;
+            break;
+
+        default: isr_state = METSCI_STATE_WAIT_FOR_E6; break;
     }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
-uint8_t METSCI_isChecksumValid(uint8_t type, uint8_t data, uint8_t checksum)
+//ISR already parsed the latest frame, so this function only measures latency and prints debug data
+//Debug data is only printed if the USB transmit buffer has room (never blocks)
+void METSCI_processLatestFrame(void)
 {
-    if ( ((type + data + checksum) & 0x7F) == 0 ) { return 1; } //data is valid
-    else
+    static uint16_t sequence_previous = 0;
+
+    noInterrupts();
+    uint8_t  frame = METSCI_frameToRead;
+    uint16_t sequence = METSCI_frames[frame].sequence;
+    uint32_t timestamp_us = METSCI_frames[frame].timestamp_us;
+    interrupts();
+
+    if (sequence == sequence_previous) { return; } //no new frame
+
+    //frames published since main loop last saw one (1 = none missed)
+    uint16_t framesBehind = sequence - sequence_previous;
+    if (framesBehind > 0xFF) { framesBehind = 0xFF; }
+    busStats_logRxBytesWaiting(BUS_METSCI, (uint8_t)framesBehind);
+
+    sequence_previous = sequence;
+
+    //time from frame's last stop bit until main loop sees new data
+    uint32_t latency_us = micros() - timestamp_us;
+    if (latency_us > 0xFFFF) { latency_us = 0xFFFF; }
+    METSCI_parseLatency_us = (uint16_t)latency_us;
+    if (METSCI_parseLatency_us > METSCI_parseLatencyMax_us) { METSCI_parseLatencyMax_us = METSCI_parseLatency_us; }
+
+    if ((debugUSB_dataTypeToStream_get() == DEBUGUSB_STREAM_BATTMETSCI) &&
+        (Serial.availableForWrite() > METSCI_DEBUG_MESSAGE_BYTES)       )
     {
-        //data invalid
-        Serial.println(F("\nMETSCI Bad Checksum"));
-        return 0;
+        Serial.print(F(" MET:E6,"));
+        Serial.print(METSCI_frames[frame].packets.latestE6Packet_assistLevel, HEX);
+        Serial.print(',');
+        Serial.print(METSCI_frames[frame].latestPacketType, HEX);
+        Serial.print(F(",lat(us):"));
+        Serial.print(METSCI_parseLatency_us);
     }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
+
+//called from ISR //MUST NOT print
+uint8_t METSCI_isChecksumValid(uint8_t type, uint8_t data, uint8_t checksum)
+{
+    if ( ((type + data + checksum) & 0x7F) == 0 ) { return 1; } //data is valid
+    else                                          { return 0; } //data invalid
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
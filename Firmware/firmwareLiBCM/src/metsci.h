@@ -5,6 +5,20 @@
     #define metci_h
 
     #define METSCI_BYTES_IN_FRAME 6
+
+    #define METSCI_UBRR_VALUE (((F_CPU / 4 / 9600) - 1) / 2) //9600 baud (double speed mode)
+
+    //USART3 RX ISR state machine //state is the next expected byte
+    #define METSCI_STATE_WAIT_FOR_E6     0 //Byte0
+    #define METSCI_STATE_E6_DATA         1 //Byte1
+    #define METSCI_STATE_E6_CHECKSUM     2 //Byte2
+    #define METSCI_STATE_PACKET_TYPE     3 //Byte3
+    #define METSCI_STATE_PACKET_DATA     4 //Byte4
+    #define METSCI_STATE_PACKET_CHECKSUM 5 //Byte5
+
+    #define METSCI_RAW_BUFFER_SIZE 16 //MUST be a power of two
+
+    #define METSCI_DEBUG_MESSAGE_BYTES 24 //max characters printed per frame
     #define RUNNING 1
     #define STOPPED 0
 
@@ -19,6 +33,8 @@
     uint8_t METSCI_getPacketE1(void);
     uint8_t METSCI_getPacketE6(void);
 
+    void METSCI_getLatestPackets(uint8_t *packetE6, uint8_t *packetB3, uint8_t *packetB4, uint8_t *packetE1); //all from same frame
+
     uint8_t METSCI_readByte(void);
 
     uint8_t METSCI_bytesAvailableToRead(void);
@@ -27,4 +43,9 @@
 
     uint8_t METSCI_isChecksumValid( uint8_t type, uint8_t data, uint8_t checksum );
 
+    uint16_t METSCI_parseLatency_us_get(void);
+    uint16_t METSCI_parseLatencyMax_us_get(void);
+
+    uint32_t METSCI_latestFrameAge_ms(void);
+
 #endif
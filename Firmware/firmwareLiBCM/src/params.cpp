@@ -0,0 +1,347 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//runtime parameters (previously compile time #defines in config.h)
+//config.h values are now the defaults
+//parameters are stored in EEPROM (with version, hardware ID, config.h defaults CRC & CRC), then copied into RAM at boot
+//'$GET' prints all parameters, '$SET=NAME=VALUE' changes one parameter, '$SET=DEFAULTS' restores config.h values
+//battery type, stack size, and current hack remain compile time (they change array sizes & lookup tables)
+
+#include "libcm.h"
+
+struct paramInfo
+{
+    const char *name; //PROGMEM
+    uint16_t minValue;
+    uint16_t maxValue;
+    uint16_t defaultValue;
+};
+
+//names are typed by user, so MUST be uppercase and short enough to fit USER_INPUT_BUFFER_SIZE
+const char paramName_00[] PROGMEM = "SOC_MAX";
+const char paramName_01[] PROGMEM = "SOC_MIN";
+const char paramName_02[] PROGMEM = "VMAX_REGEN";
+const char paramName_03[] PROGMEM = "VMIN_ASSIST";
+const char paramName_04[] PROGMEM = "VMAX_GRID";
+const char paramName_05[] PROGMEM = "VMIN_GRID";
+const char paramName_06[] PROGMEM = "VMIN_KEYOFF";
+const char paramName_07[] PROGMEM = "BAL_MIN_SOC";
+const char paramName_08[] PROGMEM = "BAL_LOOSE_PM";
+const char paramName_09[] PROGMEM = "BAL_TIGHT_PM";
+const char paramName_10[] PROGMEM = "BAL_MAX_TEMP";
+const char paramName_11[] PROGMEM = "COOL_KEYOFF";
+const char paramName_12[] PROGMEM = "COOL_GRID";
+const char paramName_13[] PROGMEM = "COOL_KEYON";
+const char paramName_14[] PROGMEM = "HEAT_KEYON";
+const char paramName_15[] PROGMEM = "HEAT_GRID";
+const char paramName_16[] PROGMEM = "HEAT_KEYOFF";
+const char paramName_17[] PROGMEM = "THERM_MIN_SOC";
+const char paramName_18[] PROGMEM = "OFF_DELAY_MIN";
+const char paramName_19[] PROGMEM = "LIDISP_BIN";
+const char paramName_20[] PROGMEM = "LIDISP_SPLASH_MS";
+const char paramName_21[] PROGMEM = "LIDISP_GRID_MS";
+const char paramName_22[] PROGMEM = "VSPOOF_MODE";
+const char paramName_23[] PROGMEM = "VSPOOF_MIN_60S";
+const char paramName_24[] PROGMEM = "FREC_TRIG";
+
+const paramInfo paramTable[PARAM_COUNT] PROGMEM = {
+    //name          min    max  default
+    {paramName_00,    50,    95, STACK_SoC_MAX},
+    {paramName_01,     5,    40, STACK_SoC_MIN},
+    {paramName_02, 39000, 43000, CELL_VMAX_REGEN},
+    {paramName_03, 30000, 36000, CELL_VMIN_ASSIST},
+    {paramName_04, 37000, CELL_VREST_85_PERCENT_SoC - 1, CELL_VMAX_GRIDCHARGER}, //above 85% SoC, cells are balanced (and age faster)
+    {paramName_05, 28000, 33000, CELL_VMIN_GRIDCHARGER},
+    {paramName_06, 30000, 37000, CELL_VMIN_KEYOFF},
+    {paramName_07,     0,   100, CELL_BALANCE_MIN_SoC},
+    {paramName_08,     2,    50, CELL_BALANCE_TO_WITHIN_PERMILLE_LOOSE},
+    {paramName_09,     1,    49, CELL_BALANCE_TO_WITHIN_PERMILLE_TIGHT},
+    {paramName_10,    20,    50, CELL_BALANCE_MAX_TEMP_C},
+    {paramName_11,    20,    50, COOL_BATTERY_ABOVE_TEMP_C_KEYOFF},
+    {paramName_12,    20,    50, COOL_BATTERY_ABOVE_TEMP_C_GRIDCHARGING},
+    {paramName_13,    20,    50, COOL_BATTERY_ABOVE_TEMP_C_KEYON},
+    {paramName_14,     0,    25, HEAT_BATTERY_BELOW_TEMP_C_KEYON},
+    {paramName_15,     0,    25, HEAT_BATTERY_BELOW_TEMP_C_GRIDCHARGING},
+    {paramName_16,     0,    25, HEAT_BATTERY_BELOW_TEMP_C_KEYOFF},
+    {paramName_17,     0,   100, KEYOFF_DISABLE_THERMAL_MANAGEMENT_BELOW_SoC},
+    {paramName_18,     1,  1440, KEYOFF_DELAY_LIBCM_TURNOFF_MINUTES},
+    {paramName_19,    32,   255, LIDISPLAY_CELL_COLOR_BIN_SIZE_COUNTS},
+    {paramName_20,     0, 10000, LIDISPLAY_SPLASH_PAGE_MS},
+    {paramName_21,     0, 10000, LIDISPLAY_GRID_CHARGE_PAGE_COOLDOWN_MS},
+    {paramName_22,     0, VSPOOF_MODE_MAX_ALLOWED, VSPOOF_MODE_DEFAULT},
+    {paramName_23,   150,   180, MIN_SPOOFED_VOLTAGE_60S},
+    {paramName_24,     0, FLIGHTREC_TRIGGER_ALL, FLIGHT_RECORDER_TRIGGERS}
+};
+
+uint16_t params_value[PARAM_COUNT]; //hot path reads come from RAM
+uint8_t  params_defaultsCRC = 0;    //config.h defaults this firmware was compiled with (see params_begin())
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void params_readInfo(uint8_t param, paramInfo *info) { memcpy_P(info, &paramTable[param], sizeof(paramInfo)); }
+
+uint16_t params_get(uint8_t param) { return params_value[param]; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool params_isValueInRange(uint8_t param, uint16_t value)
+{
+    paramInfo info;
+    params_readInfo(param, &info);
+
+    if ((value < info.minValue) || (value > info.maxValue)) { return NO; }
+    else                                                    { return YES; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//each pair's first parameter MUST be less than its second parameter
+//balancing hysteresis requires TIGHT < LOOSE
+//thermal management requires HEAT < COOL (otherwise fans would heat and cool at the same temperature)
+#define PARAMS_NUM_ORDERED_PAIRS 4
+const uint8_t params_orderedPairs[PARAMS_NUM_ORDERED_PAIRS][2] PROGMEM = {
+    {PARAM_CELL_BALANCE_PERMILLE_TIGHT, PARAM_CELL_BALANCE_PERMILLE_LOOSE},
+    {PARAM_HEAT_BELOW_TEMP_C_KEYON,     PARAM_COOL_ABOVE_TEMP_C_KEYON    },
+    {PARAM_HEAT_BELOW_TEMP_C_GRID,      PARAM_COOL_ABOVE_TEMP_C_GRID     },
+    {PARAM_HEAT_BELOW_TEMP_C_KEYOFF,    PARAM_COOL_ABOVE_TEMP_C_KEYOFF   }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns NO if changing 'param' to 'value' would violate any ordered pair
+bool params_isOrderValid(uint8_t param, uint16_t value)
+{
+    for (uint8_t pair = 0; pair < PARAMS_NUM_ORDERED_PAIRS; pair++)
+    {
+        uint8_t paramLo = pgm_read_byte(&params_orderedPairs[pair][0]);
+        uint8_t paramHi = pgm_read_byte(&params_orderedPairs[pair][1]);
+
+        if ((param == paramLo) && (value >= params_value[paramHi])) { return NO; }
+        if ((param == paramHi) && (params_value[paramLo] >= value)) { return NO; }
+    }
+
+    return YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void params_save(void)
+{
+    uint8_t data[PARAMS_NUM_BYTES];
+
+    data[0] = PARAMS_VERSION;
+    data[1] = PARAMS_HARDWARE_ID;
+    data[2] = params_defaultsCRC;
+
+    for (uint8_t param = 0; param < PARAM_COUNT; param++)
+    {
+        data[3 + (param * 2)] = highByte(params_value[param]);
+        data[4 + (param * 2)] =  lowByte(params_value[param]);
+    }
+
+    eeprom_params_save(data, PARAMS_NUM_BYTES); //only changed bytes are written
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void params_loadDefaults(void)
+{
+    paramInfo info;
+
+    for (uint8_t param = 0; param < PARAM_COUNT; param++)
+    {
+        params_readInfo(param, &info);
+        params_value[param] = info.defaultValue;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t params_calculateDefaultsCRC(void)
+{
+    uint8_t defaults[PARAM_COUNT * 2];
+    paramInfo info;
+
+    for (uint8_t param = 0; param < PARAM_COUNT; param++)
+    {
+        params_readInfo(param, &info);
+        defaults[(param * 2)    ] = highByte(info.defaultValue);
+        defaults[(param * 2) + 1] =  lowByte(info.defaultValue);
+    }
+
+    return eeprom_calculateCRC8(defaults, PARAM_COUNT * 2);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void params_restoreDefaults(void)
+{
+    params_loadDefaults();
+    params_save();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST run after eeprom_begin()
+//if any config.h default changed since parameters were stored (e.g. new firmware tightens a safety limit), all stored values are discarded
+void params_begin(void)
+{
+    uint8_t data[PARAMS_NUM_BYTES];
+
+    params_loadDefaults(); //also used if a stored value is out of range
+    params_defaultsCRC = params_calculateDefaultsCRC();
+
+    if ( (eeprom_params_load(data, PARAMS_NUM_BYTES) == NO) ||
+         (data[0] != PARAMS_VERSION                       ) ||
+         (data[1] != PARAMS_HARDWARE_ID                   )  )
+    {
+        Serial.print(F("\nRestoring EEPROM value: parameters"));
+        params_save();
+        return;
+    }
+
+    if (data[2] != params_defaultsCRC)
+    {
+        Serial.print(F("\nconfig.h defaults changed: restoring parameters ('$GET' to review)"));
+        params_save();
+        return;
+    }
+
+    for (uint8_t param = 0; param < PARAM_COUNT; param++)
+    {
+        uint16_t storedValue = (data[3 + (param * 2)] << 8) + data[4 + (param * 2)];
+
+        if (params_isValueInRange(param, storedValue) == YES) { params_value[param] = storedValue; }
+    }
+
+    for (uint8_t pair = 0; pair < PARAMS_NUM_ORDERED_PAIRS; pair++)
+    {
+        uint8_t paramLo = pgm_read_byte(&params_orderedPairs[pair][0]);
+        uint8_t paramHi = pgm_read_byte(&params_orderedPairs[pair][1]);
+
+        if (params_value[paramLo] >= params_value[paramHi])
+        {
+            paramInfo info;
+            params_readInfo(paramLo, &info); params_value[paramLo] = info.defaultValue;
+            params_readInfo(paramHi, &info); params_value[paramHi] = info.defaultValue;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool params_set(uint8_t param, uint16_t value)
+{
+    if (param >= PARAM_COUNT)                      { return NO; }
+    if (params_isValueInRange(param, value) == NO) { return NO; }
+
+    if (params_isOrderValid(param, value) == NO)   { return NO; } //e.g. HEAT_KEYON >= COOL_KEYON
+
+    params_value[param] = value;
+    params_save();
+
+    return YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns PARAM_COUNT if name not found
+//'*nameLength' is set to the number of characters matched
+uint8_t params_findByName(const uint8_t input[], uint8_t *nameLength)
+{
+    paramInfo info;
+
+    for (uint8_t param = 0; param < PARAM_COUNT; param++)
+    {
+        params_readInfo(param, &info);
+
+        uint8_t ii = 0;
+        while ((pgm_read_byte(&info.name[ii]) != 0) && (pgm_read_byte(&info.name[ii]) == input[ii])) { ii++; }
+
+        if ( (pgm_read_byte(&info.name[ii]) == 0) &&
+             ((input[ii] == '=') || (input[ii] == STRING_TERMINATION_CHARACTER)) ) { *nameLength = ii; return param; }
+    }
+
+    return PARAM_COUNT;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void params_print(uint8_t param)
+{
+    paramInfo info;
+    params_readInfo(param, &info);
+
+    Serial.print(F("\n "));
+    Serial.print((const __FlashStringHelper *)info.name);
+    Serial.print('=');
+    Serial.print(params_value[param]);
+    Serial.print(F(" ("));
+    Serial.print(info.minValue);
+    Serial.print(F(" to "));
+    Serial.print(info.maxValue);
+    Serial.print(F(", default "));
+    Serial.print(info.defaultValue);
+    Serial.print(')');
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void params_handleUserGet(const uint8_t input[])
+{
+    if (input[0] == STRING_TERMINATION_CHARACTER)
+    {
+        Serial.print(F("\nParameters ('$SET=NAME=VALUE' to change):"));
+        for (uint8_t param = 0; param < PARAM_COUNT; param++) { params_print(param); }
+    }
+    else if (input[0] == '=')
+    {
+        uint8_t nameLength = 0;
+        uint8_t param = params_findByName(&input[1], &nameLength);
+
+        if (param < PARAM_COUNT) { params_print(param);                   }
+        else                     { Serial.print(F("\nUnknown parameter")); }
+    }
+    else { Serial.print(F("\nInvalid Entry")); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//input points to character after '$SET'
+void params_handleUserSet(const uint8_t input[])
+{
+    if (input[0] != '=') { Serial.print(F("\nInvalid Entry")); return; }
+
+    if ((input[1] == 'D') && (input[2] == 'E') && (input[3] == 'F') && (input[4] == 'A') && (input[5] == 'U') &&
+        (input[6] == 'L') && (input[7] == 'T') && (input[8] == 'S') && (input[9] == STRING_TERMINATION_CHARACTER))
+    {
+        Serial.print(F("\nRestoring default parameters"));
+        params_restoreDefaults();
+        return;
+    }
+
+    uint8_t nameLength = 0;
+    uint8_t param = params_findByName(&input[1], &nameLength);
+
+    if (param >= PARAM_COUNT)            { Serial.print(F("\nUnknown parameter")); return; }
+    if (input[1 + nameLength] != '=')    { Serial.print(F("\nInvalid Entry"));     return; }
+
+    //LiBCM's atoi() implementation for uint16_t
+    const uint8_t *digit = &input[2 + nameLength];
+    uint32_t newValue = 0;
+
+    if (*digit == STRING_TERMINATION_CHARACTER) { Serial.print(F("\nInvalid Entry")); return; }
+
+    while (*digit != STRING_TERMINATION_CHARACTER)
+    {
+        if ((*digit < '0') || (*digit > '9') || (newValue > 0xFFFF)) { Serial.print(F("\nInvalid Entry")); return; }
+        newValue = (newValue * 10) + (*digit - '0');
+        digit++;
+    }
+
+    if ((newValue > 0xFFFF) || (params_set(param, (uint16_t)newValue) == NO)) { Serial.print(F("\nValue out of range (or HEAT >= COOL, TIGHT >= LOOSE)")); }
+
+    params_print(param);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
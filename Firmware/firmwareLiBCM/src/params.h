@@ -0,0 +1,63 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef params_h
+    #define params_h
+
+    //each parameter's default value is set in config.h
+    //MUST match paramTable[] order (see params.cpp)
+    #define PARAM_STACK_SoC_MAX                0
+    #define PARAM_STACK_SoC_MIN                1
+    #define PARAM_CELL_VMAX_REGEN              2
+    #define PARAM_CELL_VMIN_ASSIST             3
+    #define PARAM_CELL_VMAX_GRIDCHARGER        4
+    #define PARAM_CELL_VMIN_GRIDCHARGER        5
+    #define PARAM_CELL_VMIN_KEYOFF             6
+    #define PARAM_CELL_BALANCE_MIN_SoC         7
+    #define PARAM_CELL_BALANCE_PERMILLE_LOOSE  8
+    #define PARAM_CELL_BALANCE_PERMILLE_TIGHT  9
+    #define PARAM_CELL_BALANCE_MAX_TEMP_C     10
+    #define PARAM_COOL_ABOVE_TEMP_C_KEYOFF    11
+    #define PARAM_COOL_ABOVE_TEMP_C_GRID      12
+    #define PARAM_COOL_ABOVE_TEMP_C_KEYON     13
+    #define PARAM_HEAT_BELOW_TEMP_C_KEYON     14
+    #define PARAM_HEAT_BELOW_TEMP_C_GRID      15
+    #define PARAM_HEAT_BELOW_TEMP_C_KEYOFF    16
+    #define PARAM_KEYOFF_THERMAL_MIN_SoC      17
+    #define PARAM_KEYOFF_TURNOFF_DELAY_MINUTES 18
+    #define PARAM_LIDISPLAY_CELL_COLOR_BIN    19
+    #define PARAM_LIDISPLAY_SPLASH_PAGE_ms    20
+    #define PARAM_LIDISPLAY_GRID_COOLDOWN_ms  21
+    #define PARAM_VSPOOF_MODE                 22
+    #define PARAM_MIN_SPOOFED_VOLTAGE_60S     23
+    #define PARAM_FLIGHTREC_TRIGGERS          24
+    #define PARAM_COUNT                       25
+
+    #define PARAMS_VERSION 0x02 //change if any parameter is added, removed, or reordered
+
+    //stored parameters are discarded if battery type or stack size changes
+    #if   defined BATTERY_TYPE_5AhG3
+        #define PARAMS_HARDWARE_ID_BATTERY 0x01
+    #elif defined BATTERY_TYPE_47AhFoMoCo
+        #define PARAMS_HARDWARE_ID_BATTERY 0x02
+    #endif
+
+    #if   defined STACK_IS_48S
+        #define PARAMS_HARDWARE_ID (PARAMS_HARDWARE_ID_BATTERY | 0x10)
+    #elif defined STACK_IS_60S
+        #define PARAMS_HARDWARE_ID (PARAMS_HARDWARE_ID_BATTERY | 0x20)
+    #endif
+
+    #define PARAMS_NUM_BYTES (3 + (PARAM_COUNT * 2)) //version, hardware ID, defaults CRC, values
+
+    void params_begin(void);
+
+    uint16_t params_get(uint8_t param);
+    bool     params_set(uint8_t param, uint16_t value); //returns NO if value is out of range, or conflicts with another parameter (e.g. HEAT >= COOL)
+
+    void params_restoreDefaults(void);
+
+    void params_handleUserSet(const uint8_t input[]); //'$SET=NAME=VALUE'
+    void params_handleUserGet(const uint8_t input[]); //'$GET' or '$GET=NAME'
+
+#endif
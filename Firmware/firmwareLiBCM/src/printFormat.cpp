@@ -0,0 +1,138 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//number formatters that don't use String (which allocates heap memory, and eventually fragments the heap)
+//each number is formatted into a stack buffer, then written to 'output' (e.g. Serial or lcd2) in a single call
+
+#include "libcm.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//fills buffer from the end //returns index of first character
+uint8_t printFormat_toDigits(uint32_t value, char buffer[], uint8_t index, uint8_t base, uint8_t minDigits)
+{
+    uint8_t digitsWritten = 0;
+
+    do
+    {
+        uint8_t digit = value % base;
+        buffer[--index] = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+        value /= base;
+        digitsWritten++;
+    } while ( ((value > 0) || (digitsWritten < minDigits)) && (index > 0) );
+
+    return index;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//shared by signed and unsigned versions
+uint8_t printFormat_fixedPointMagnitude_toBuffer(char buffer[], uint32_t magnitude, bool isNegative, uint8_t scaleDigits, uint8_t decimalPlaces)
+{
+    uint8_t index = PRINTFORMAT_BUFFER_BYTES;
+
+    if (decimalPlaces > scaleDigits) { decimalPlaces = scaleDigits; }
+
+    uint32_t divisor = 1;
+    for (uint8_t ii = decimalPlaces; ii < scaleDigits; ii++) { divisor *= 10; }
+    magnitude = (magnitude + (divisor >> 1)) / divisor; //round, then discard digits that won't be printed
+
+    if (decimalPlaces > 0)
+    {
+        uint32_t fractionDivisor = 1;
+        for (uint8_t ii = 0; ii < decimalPlaces; ii++) { fractionDivisor *= 10; }
+
+        index = printFormat_toDigits(magnitude % fractionDivisor, buffer, index, 10, decimalPlaces);
+        buffer[--index] = '.';
+        index = printFormat_toDigits(magnitude / fractionDivisor, buffer, index, 10, 1);
+    }
+    else { index = printFormat_toDigits(magnitude, buffer, index, 10, 1); }
+
+    if ((isNegative == YES) && (magnitude != 0)) { buffer[--index] = '-'; }
+
+    return index;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//value is scaled by (10^scaleDigits) //e.g. cell voltage counts: printFormat_fixedPoint(Serial, 37123, 4, 3) prints "3.712"
+//rounds to nearest printed digit
+//fills buffer from the end //returns index of first character
+uint8_t printFormat_fixedPoint_toBuffer(char buffer[], int32_t value, uint8_t scaleDigits, uint8_t decimalPlaces)
+{
+    bool isNegative = (value < 0);
+    uint32_t magnitude = (isNegative == YES) ? (0 - (uint32_t)value) : (uint32_t)value;
+
+    return printFormat_fixedPointMagnitude_toBuffer(buffer, magnitude, isNegative, scaleDigits, decimalPlaces);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//full uint32 range (e.g. millis(), which exceeds int32 after ~24.8 days)
+uint8_t printFormat_fixedPointUnsigned_toBuffer(char buffer[], uint32_t value, uint8_t scaleDigits, uint8_t decimalPlaces)
+{
+    return printFormat_fixedPointMagnitude_toBuffer(buffer, value, NO, scaleDigits, decimalPlaces);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void printFormat_fixedPoint(Print &output, int32_t value, uint8_t scaleDigits, uint8_t decimalPlaces)
+{
+    char buffer[PRINTFORMAT_BUFFER_BYTES];
+    uint8_t index = printFormat_fixedPoint_toBuffer(buffer, value, scaleDigits, decimalPlaces);
+
+    output.write((const uint8_t *)&buffer[index], PRINTFORMAT_BUFFER_BYTES - index);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void printFormat_fixedPointUnsigned(Print &output, uint32_t value, uint8_t scaleDigits, uint8_t decimalPlaces)
+{
+    char buffer[PRINTFORMAT_BUFFER_BYTES];
+    uint8_t index = printFormat_fixedPointUnsigned_toBuffer(buffer, value, scaleDigits, decimalPlaces);
+
+    output.write((const uint8_t *)&buffer[index], PRINTFORMAT_BUFFER_BYTES - index);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//right justified //padding is placed before '-' //e.g. printFormat_paddedInt(lcd2, 42, 4, ' ') prints "  42"
+//fills buffer from the end //returns index of first character
+uint8_t printFormat_paddedInt_toBuffer(char buffer[], int32_t value, uint8_t minWidth, char padding)
+{
+    uint8_t index = PRINTFORMAT_BUFFER_BYTES;
+
+    bool isNegative = (value < 0);
+    uint32_t magnitude = (isNegative == YES) ? (0 - (uint32_t)value) : (uint32_t)value;
+
+    index = printFormat_toDigits(magnitude, buffer, index, 10, 1);
+    if (isNegative == YES) { buffer[--index] = '-'; }
+
+    if (minWidth > PRINTFORMAT_BUFFER_BYTES) { minWidth = PRINTFORMAT_BUFFER_BYTES; }
+    while ((PRINTFORMAT_BUFFER_BYTES - index) < minWidth) { buffer[--index] = padding; }
+
+    return index;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void printFormat_paddedInt(Print &output, int32_t value, uint8_t minWidth, char padding)
+{
+    char buffer[PRINTFORMAT_BUFFER_BYTES];
+    uint8_t index = printFormat_paddedInt_toBuffer(buffer, value, minWidth, padding);
+
+    output.write((const uint8_t *)&buffer[index], PRINTFORMAT_BUFFER_BYTES - index);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//uppercase, with leading zeros //e.g. printFormat_hex(Serial, 0x0A, 2) prints "0A"
+void printFormat_hex(Print &output, uint32_t value, uint8_t minDigits)
+{
+    char buffer[PRINTFORMAT_BUFFER_BYTES];
+    uint8_t index = printFormat_toDigits(value, buffer, PRINTFORMAT_BUFFER_BYTES, 16, minDigits);
+
+    output.write((const uint8_t *)&buffer[index], PRINTFORMAT_BUFFER_BYTES - index);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
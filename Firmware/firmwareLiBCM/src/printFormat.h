@@ -0,0 +1,22 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef printformat_h
+    #define printformat_h
+
+    #define PRINTFORMAT_BUFFER_BYTES 14 //'-' + 10 digits + '.' + leading '0'
+
+    void printFormat_fixedPoint(Print &output, int32_t value, uint8_t scaleDigits, uint8_t decimalPlaces);
+    void printFormat_fixedPointUnsigned(Print &output, uint32_t value, uint8_t scaleDigits, uint8_t decimalPlaces);
+
+    void printFormat_paddedInt(Print &output, int32_t value, uint8_t minWidth, char padding);
+
+    //same as above, but formats into buffer (PRINTFORMAT_BUFFER_BYTES long) //returns index of first character
+    uint8_t printFormat_fixedPoint_toBuffer(char buffer[], int32_t value, uint8_t scaleDigits, uint8_t decimalPlaces);
+    uint8_t printFormat_fixedPointUnsigned_toBuffer(char buffer[], uint32_t value, uint8_t scaleDigits, uint8_t decimalPlaces);
+
+    uint8_t printFormat_paddedInt_toBuffer(char buffer[], int32_t value, uint8_t minWidth, char padding);
+
+    void printFormat_hex(Print &output, uint32_t value, uint8_t minDigits);
+
+#endif
@@ -0,0 +1,108 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//measures how much RAM the stack and heap have used
+//Free RAM (between heap and stack) is painted with RAMMONITOR_CANARY before main() runs.
+//The stack low water mark is the lowest address that no longer contains the canary.
+//If the stack grows into the heap (or .bss), cell data is silently corrupted... so warn well before that happens.
+
+#include "libcm.h"
+
+//linker symbols
+extern uint8_t __data_start, __data_end;
+extern uint8_t __bss_start, __bss_end;
+extern uint8_t __noinit_start, __noinit_end;
+extern uint8_t __heap_start; //first address after .noinit
+extern uint8_t *__brkval;    //heap end (0 if malloc() never called)
+
+uint8_t *stackLowWater = (uint8_t *)RAMEND; //lowest address stack has ever used
+uint8_t *scanAddress = &__heap_start;
+uint16_t minMargin_bytes = 0xFFFF;
+bool wasLowMarginLogged = NO;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//runs before main(), when nothing is on the stack yet
+void ramMonitor_paintFreeRAM(void) __attribute__ ((naked, used, section (".init3")));
+void ramMonitor_paintFreeRAM(void)
+{
+    uint8_t *address = &__heap_start;
+    while (address < (uint8_t *)RAMEND) { *address++ = RAMMONITOR_CANARY; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t * ramMonitor_heapEnd(void)
+{
+    if (__brkval == 0) { return &__heap_start; }
+    else               { return __brkval;      }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t ramMonitor_stackMax_bytes_get(void) { return (uint16_t)((uint8_t *)RAMEND - stackLowWater); }
+uint16_t ramMonitor_minMargin_bytes_get(void) { return minMargin_bytes; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//scans a few bytes per call, starting at heap end, until it finds the first byte the stack has overwritten
+void ramMonitor_handler(void)
+{
+    uint8_t *heapEnd = ramMonitor_heapEnd();
+
+    if (scanAddress < heapEnd) { scanAddress = heapEnd; } //heap grew
+
+    for (uint8_t ii = 0; ii < RAMMONITOR_SCAN_BYTES_PER_LOOP; ii++)
+    {
+        if ((scanAddress >= stackLowWater) || (*scanAddress != RAMMONITOR_CANARY))
+        {
+            //scan complete
+            if (scanAddress < stackLowWater) { stackLowWater = scanAddress; }
+
+            uint16_t margin_bytes = (stackLowWater > heapEnd) ? (uint16_t)(stackLowWater - heapEnd) : 0;
+            if (margin_bytes < minMargin_bytes) { minMargin_bytes = margin_bytes; }
+
+            if ((minMargin_bytes < RAMMONITOR_MIN_MARGIN_BYTES) && (wasLowMarginLogged == NO))
+            {
+                eventLog_log(EVENT_RAM_MARGIN_LOW, minMargin_bytes);
+                wasLowMarginLogged = YES;
+            }
+
+            scanAddress = heapEnd; //start next scan
+            return;
+        }
+
+        scanAddress++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void ramMonitor_printLine(const __FlashStringHelper *name, uint16_t numBytes)
+{
+    Serial.print(name);
+    Serial.print(numBytes, DEC);
+    Serial.print(F(" B"));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//'$MEM'
+void ramMonitor_print(void)
+{
+    uint8_t stackPointer; //address of this local variable is (close to) stack pointer
+    uint8_t *heapEnd = ramMonitor_heapEnd();
+
+    Serial.print(F("\nRAM usage:"));
+    ramMonitor_printLine(F("\n.data:   "), (uint16_t)(&__data_end - &__data_start));
+    ramMonitor_printLine(F("\n.bss:    "), (uint16_t)(&__bss_end - &__bss_start));
+    ramMonitor_printLine(F("\n.noinit: "), (uint16_t)(&__noinit_end - &__noinit_start));
+    ramMonitor_printLine(F("\nheap:    "), (uint16_t)(heapEnd - &__heap_start));
+    ramMonitor_printLine(F("\nstack:   "), (uint16_t)((uint8_t *)RAMEND - &stackPointer));
+    ramMonitor_printLine(F(" (max "), ramMonitor_stackMax_bytes_get());
+    Serial.print(')');
+    ramMonitor_printLine(F("\nfree:    "), (uint16_t)(&stackPointer - heapEnd));
+    if (minMargin_bytes == 0xFFFF) { Serial.print(F(" (first scan not finished)")); }
+    else                           { ramMonitor_printLine(F(" (min "), minMargin_bytes); Serial.print(')'); }
+    ramMonitor_printLine(F("\ntotal:   "), (uint16_t)(RAMEND - RAMSTART + 1));
+}
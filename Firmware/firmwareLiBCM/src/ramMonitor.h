@@ -0,0 +1,18 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef ramMonitor_h
+    #define ramMonitor_h
+
+    #define RAMMONITOR_CANARY              0xC5 //unused RAM is painted with this value at boot
+    #define RAMMONITOR_SCAN_BYTES_PER_LOOP   64 //~25 us per loop //full scan takes ~50 loops
+    #define RAMMONITOR_MIN_MARGIN_BYTES     256 //log warning if stack ever gets closer than this to heap
+
+    void ramMonitor_handler(void);
+
+    uint16_t ramMonitor_stackMax_bytes_get(void);
+    uint16_t ramMonitor_minMargin_bytes_get(void);
+
+    void ramMonitor_print(void);
+
+#endif
@@ -0,0 +1,234 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//reports why LiBCM reset, and what it was doing when it did
+//Each loop() handler writes its task ID into a breadcrumb stored in '.noinit' RAM (not zeroed at boot).
+//After a watchdog (or brownout) reset, the breadcrumb still contains the task that was running.
+//The stock bootloader clears MCUSR, so a watchdog reset can't be told apart from a USB (DTR) reset or '$BOOT' using MCUSR alone.
+//Instead, the watchdog runs in interrupt+reset mode: WDT_vect writes a marker into the breadcrumb, then the next timeout resets LiBCM.
+//Only resets with that marker (or with BORF/WDRF, if the bootloader left them) are saved to EEPROM.
+
+#include "libcm.h"
+
+struct resetLogBreadcrumb
+{
+    uint16_t magic; //RESETLOG_BREADCRUMB_MAGIC if breadcrumb survived reset
+    uint8_t  task;
+    uint8_t  phase;
+    uint16_t loopTime_ms; //latest completed loop
+    uint16_t maxLoopTime_ms;
+    uint8_t  resetMarker; //RESETLOG_MARKER_WATCHDOG if WDT_vect fired
+};
+
+volatile resetLogBreadcrumb breadcrumb __attribute__ ((section (".noinit")));
+
+uint8_t resetLog_MCUSR __attribute__ ((section (".noinit")));
+
+//breadcrumb contents from before latest reset
+resetLogBreadcrumb previousBreadcrumb;
+bool isPreviousBreadcrumbValid = NO;
+uint8_t previousResetCause = 0; //MCUSR, plus RESETLOG_CAUSE_WATCHDOG_MARKER
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//runs before main() (and before .data/.bss are initialized)
+//MCUSR MUST be cleared, otherwise WDRF keeps the watchdog enabled
+//Note: Some bootloaders clear MCUSR before starting the sketch, in which case the reset cause is unknown.
+void resetLog_captureMCUSR(void) __attribute__ ((naked, used, section (".init3")));
+void resetLog_captureMCUSR(void)
+{
+    resetLog_MCUSR = MCUSR;
+    MCUSR = 0;
+    wdt_disable();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_begin(void)
+{
+    previousResetCause = resetLog_MCUSR;
+
+    if ( (breadcrumb.magic == RESETLOG_BREADCRUMB_MAGIC) && !(previousResetCause & (1 << PORF)) )
+    {
+        isPreviousBreadcrumbValid = YES;
+        previousBreadcrumb.task           = breadcrumb.task;
+        previousBreadcrumb.phase          = breadcrumb.phase;
+        previousBreadcrumb.loopTime_ms    = breadcrumb.loopTime_ms;
+        previousBreadcrumb.maxLoopTime_ms = breadcrumb.maxLoopTime_ms;
+        if (breadcrumb.resetMarker == RESETLOG_MARKER_WATCHDOG) { previousResetCause |= RESETLOG_CAUSE_WATCHDOG_MARKER; }
+    }
+    else { isPreviousBreadcrumbValid = NO; } //power on (RAM contents are random)
+
+    breadcrumb.resetMarker = 0;
+    breadcrumb.task = TASK_SETUP;
+    breadcrumb.phase = 0;
+    breadcrumb.loopTime_ms = 0;
+    breadcrumb.maxLoopTime_ms = 0;
+    breadcrumb.magic = RESETLOG_BREADCRUMB_MAGIC;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_task(uint8_t task)
+{
+    breadcrumb.task = task;
+    breadcrumb.phase = 0;
+}
+
+void resetLog_phase(uint8_t phase) { breadcrumb.phase = phase; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_loopTime(uint32_t loopTime_ms)
+{
+    if (loopTime_ms > 0xFFFF) { loopTime_ms = 0xFFFF; }
+
+    breadcrumb.loopTime_ms = (uint16_t)loopTime_ms;
+    if (loopTime_ms > breadcrumb.maxLoopTime_ms) { breadcrumb.maxLoopTime_ms = (uint16_t)loopTime_ms; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//power on, USB (DTR) and '$BOOT' resets are normal, so they aren't saved
+void resetLog_save(void)
+{
+    const uint8_t unexpectedResetCauses = RESETLOG_CAUSE_WATCHDOG_MARKER | (1 << WDRF) | (1 << BORF);
+
+    if ((isPreviousBreadcrumbValid == YES) && (previousResetCause & unexpectedResetCauses))
+    {
+        eeprom_resetHistory_save(previousResetCause, previousBreadcrumb.task, previousBreadcrumb.phase, previousBreadcrumb.loopTime_ms);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//first timeout calls WDT_vect (which clears WDIE), second timeout resets LiBCM
+void resetLog_enableWatchdog(void)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    wdt_reset();
+    WDTCSR = (1 << WDCE) | (1 << WDE); //timed sequence (next write MUST occur within four clock cycles)
+    WDTCSR = (1 << WDIE) | (1 << WDE) | (1 << WDP2) | (1 << WDP1); //1 second timeout
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_feedWatchdog(void)
+{
+    wdt_reset();
+
+    if (breadcrumb.resetMarker == RESETLOG_MARKER_WATCHDOG)
+    {
+        //loop recovered before watchdog reset LiBCM
+        breadcrumb.resetMarker = 0;
+        WDTCSR |= (1 << WDIE); //re-arm interrupt (doesn't require timed sequence)
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//loop hasn't fed watchdog for 1 second //LiBCM resets 1 second from now, unless loop recovers
+ISR(WDT_vect) { breadcrumb.resetMarker = RESETLOG_MARKER_WATCHDOG; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_printCause(uint8_t resetCause)
+{
+    if (resetCause == 0) { Serial.print(F("unknown (MCUSR cleared by bootloader, USB reset, or $BOOT)")); return; }
+
+    if (resetCause & (1 << PORF))  { Serial.print(F("powerOn "));  }
+    if (resetCause & (1 << EXTRF)) { Serial.print(F("external ")); }
+    if (resetCause & (1 << BORF))  { Serial.print(F("brownout ")); }
+    if (resetCause & ((1 << WDRF) | RESETLOG_CAUSE_WATCHDOG_MARKER)) { Serial.print(F("watchdog ")); }
+    if (resetCause & (1 << JTRF))  { Serial.print(F("JTAG "));     }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_printTaskName(uint8_t task)
+{
+    switch (task)
+    {
+        case TASK_SETUP:            Serial.print(F("setup"));          break;
+        case TASK_KEY_STATE:        Serial.print(F("keyState"));       break;
+        case TASK_TIME:             Serial.print(F("time"));           break;
+        case TASK_TEMPERATURE:      Serial.print(F("temperature"));    break;
+        case TASK_SoC:              Serial.print(F("SoC"));            break;
+        case TASK_FAN:              Serial.print(F("fan"));            break;
+        case TASK_HEATER:           Serial.print(F("heater"));         break;
+        case TASK_GRIDCHARGER:      Serial.print(F("gridCharger"));    break;
+        case TASK_BUZZER:           Serial.print(F("buzzer"));         break;
+        case TASK_LCD:              Serial.print(F("lcd"));            break;
+        case TASK_LIDISPLAY:        Serial.print(F("LiDisplay"));      break;
+        case TASK_BATTERY_HISTORY:  Serial.print(F("batteryHistory")); break;
+        case TASK_CELL_BALANCE:     Serial.print(F("cellBalance"));    break;
+        case TASK_BATTSCI:          Serial.print(F("BATTSCI"));        break;
+        case TASK_LTC6804:          Serial.print(F("LTC6804"));        break;
+        case TASK_METSCI:           Serial.print(F("METSCI"));         break;
+        case TASK_ADC:              Serial.print(F("adc"));            break;
+        case TASK_VSPOOF:           Serial.print(F("vPackSpoof"));     break;
+        case TASK_DEBUG_USB:        Serial.print(F("debugUSB"));       break;
+        case TASK_LICONTROL:        Serial.print(F("LiControl"));      break;
+        case TASK_KEYOFF_TASKS:     Serial.print(F("keyOffTasks"));    break;
+        case TASK_FLIGHT_RECORDER:  Serial.print(F("flightRecorder")); break;
+        case TASK_USB_INPUT:        Serial.print(F("USB input"));      break;
+        case TASK_EVENT_LOG:        Serial.print(F("eventLog"));       break;
+        case TASK_LOOP_WAIT:        Serial.print(F("loopWait"));       break;
+        case TASK_RAM_MONITOR:      Serial.print(F("ramMonitor"));     break;
+        default:                    Serial.print(F("unknown "));       Serial.print(task, DEC); break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void resetLog_printRecord(uint8_t resetCause, uint8_t task, uint8_t phase, uint16_t loopTime_ms)
+{
+    resetLog_printCause(resetCause);
+    Serial.print(F(", task: "));
+    resetLog_printTaskName(task);
+    Serial.print('.');
+    Serial.print(phase, DEC);
+    Serial.print(F(", loop: "));
+    Serial.print(loopTime_ms, DEC);
+    Serial.print(F(" ms"));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//called once after boot banner
+void resetLog_printLatest(void)
+{
+    Serial.print(F("\nReset cause: "));
+
+    if (isPreviousBreadcrumbValid == NO) { resetLog_printCause(previousResetCause); return; }
+
+    resetLog_printRecord(previousResetCause, previousBreadcrumb.task, previousBreadcrumb.phase, previousBreadcrumb.loopTime_ms);
+    Serial.print(F(" (max "));
+    Serial.print(previousBreadcrumb.maxLoopTime_ms, DEC);
+    Serial.print(F(" ms)"));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//'$RESETS'
+void resetLog_printHistory(void)
+{
+    Serial.print(F("\nReset history (newest first), total: "));
+    Serial.print(eeprom_resetHistory_total_get(), DEC);
+
+    for (uint8_t age = 0; age < RESET_HISTORY_NUM_RECORDS; age++)
+    {
+        uint16_t sequence;
+        uint8_t resetCause, task, phase;
+        uint16_t loopTime_ms;
+
+        if (eeprom_resetHistory_get(age, &sequence, &resetCause, &task, &phase, &loopTime_ms) == NO) { break; }
+
+        Serial.print(F("\n#"));
+        Serial.print(sequence, DEC);
+        Serial.print(F(": "));
+        resetLog_printRecord(resetCause, task, phase, loopTime_ms);
+    }
+}
@@ -0,0 +1,55 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef resetLog_h
+    #define resetLog_h
+
+    //task IDs //each loop() handler stores its ID in a breadcrumb (that survives watchdog & brownout resets)
+    #define TASK_SETUP            0
+    #define TASK_KEY_STATE        1
+    #define TASK_TIME             2
+    #define TASK_TEMPERATURE      3
+    #define TASK_SoC              4
+    #define TASK_FAN              5
+    #define TASK_HEATER           6
+    #define TASK_GRIDCHARGER      7
+    #define TASK_BUZZER           8
+    #define TASK_LCD              9
+    #define TASK_LIDISPLAY       10
+    #define TASK_BATTERY_HISTORY 11
+    #define TASK_CELL_BALANCE    12
+    #define TASK_BATTSCI         13
+    #define TASK_LTC6804         14
+    #define TASK_METSCI          15
+    #define TASK_ADC             16
+    #define TASK_VSPOOF          17
+    #define TASK_DEBUG_USB       18
+    #define TASK_LICONTROL       19
+    #define TASK_KEYOFF_TASKS    20
+    #define TASK_FLIGHT_RECORDER 21
+    #define TASK_USB_INPUT       22
+    #define TASK_EVENT_LOG       23
+    #define TASK_LOOP_WAIT       24
+    #define TASK_RAM_MONITOR     25
+
+    #define RESETLOG_BREADCRUMB_MAGIC 0xB7C3 //breadcrumb is invalid after power on (RAM contents are random)
+    #define RESETLOG_MARKER_WATCHDOG  0x5A   //written by WDT_vect, one watchdog period before the watchdog resets LiBCM
+
+    //the bootloader clears MCUSR, so WDT_vect's marker is stored with the reset cause in this otherwise unused MCUSR bit
+    #define RESETLOG_CAUSE_WATCHDOG_MARKER 0x80
+
+    void resetLog_begin(void); //MUST run first in setup()
+    void resetLog_save(void);  //MUST run after eeprom_begin()
+
+    void resetLog_enableWatchdog(void); //interrupt after 1 s (see WDT_vect), then reset after 2 s
+    void resetLog_feedWatchdog(void);   //call once per loop
+
+    void resetLog_task(uint8_t task);   //resets phase to zero
+    void resetLog_phase(uint8_t phase); //optional checkpoints inside a task
+
+    void resetLog_loopTime(uint32_t loopTime_ms);
+
+    void resetLog_printLatest(void);
+    void resetLog_printHistory(void);
+
+#endif
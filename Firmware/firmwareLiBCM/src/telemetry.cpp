@@ -0,0 +1,205 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//binary telemetry stream (record format is documented in telemetry.h)
+//each record is only sent if the entire record fits in the USB transmit buffer (never blocks)
+//each sample set contains one of each record type (and one cell record per IC)
+
+#include "libcm.h"
+
+uint8_t record[TELEMETRY_MAX_RECORD_BYTES];
+uint8_t recordLength = 0;
+uint8_t recordSequence = 0;
+
+uint8_t nextRecordToSend = 0; //index into the current sample set
+
+#define TELEMETRY_SET_POWER  0
+#define TELEMETRY_SET_SoC    1
+#define TELEMETRY_SET_SCI    2
+#define TELEMETRY_SET_TEMPS  3
+#define TELEMETRY_SET_FAULTS 4
+#define TELEMETRY_SET_CELLS  5 //first IC //one record per IC
+#define TELEMETRY_SET_DONE   (TELEMETRY_SET_CELLS + TOTAL_IC)
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void telemetry_append_uint8(uint8_t data)
+{
+    if (recordLength < (TELEMETRY_MAX_RECORD_BYTES - TELEMETRY_CRC_BYTES)) { record[recordLength++] = data; }
+}
+
+void telemetry_append_uint16(uint16_t data)
+{
+    telemetry_append_uint8( lowByte(data));
+    telemetry_append_uint8(highByte(data));
+}
+
+void telemetry_append_uint32(uint32_t data)
+{
+    telemetry_append_uint16((uint16_t)(data      ));
+    telemetry_append_uint16((uint16_t)(data >> 16));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void telemetry_beginRecord(uint8_t recordType, uint8_t recordVersion)
+{
+    recordLength = 0;
+    telemetry_append_uint8(recordType);
+    telemetry_append_uint8(recordVersion);
+    telemetry_append_uint8(recordSequence);
+    telemetry_append_uint32(millis());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//Consistent Overhead Byte Stuffing: removes all 0x00 bytes, so 0x00 can delimit records
+//output buffer must be at least (length + 2) bytes
+uint8_t telemetry_encodeCOBS(const uint8_t input[], uint8_t length, uint8_t output[])
+{
+    uint8_t codeIndex = 0; //where the current block's length byte goes
+    uint8_t outputIndex = 1;
+    uint8_t code = 1;
+
+    for (uint8_t ii = 0; ii < length; ii++)
+    {
+        if (input[ii] == 0)
+        {
+            output[codeIndex] = code;
+            codeIndex = outputIndex++;
+            code = 1;
+        }
+        else
+        {
+            output[outputIndex++] = input[ii];
+            if (++code == 0xFF)
+            {
+                //maximum block length
+                output[codeIndex] = code;
+                codeIndex = outputIndex++;
+                code = 1;
+            }
+        }
+    }
+    output[codeIndex] = code;
+
+    return outputIndex;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//returns NO if USB transmit buffer doesn't have room (record isn't sent)
+bool telemetry_sendRecord(void)
+{
+    uint16_t crc = 0xFFFF;
+    for (uint8_t ii = 0; ii < recordLength; ii++) { crc = _crc_ccitt_update(crc, record[ii]); }
+    record[recordLength++] = lowByte(crc);
+    record[recordLength++] = highByte(crc);
+
+    uint8_t encoded[TELEMETRY_MAX_RECORD_BYTES + 3]; //COBS overhead + delimiter
+    uint8_t encodedLength = telemetry_encodeCOBS(record, recordLength, encoded);
+    encoded[encodedLength++] = 0x00; //delimiter
+
+    if (Serial.availableForWrite() < encodedLength) { return NO; } //try again next loop
+
+    Serial.write(encoded, encodedLength); //entire record fits in buffer, so this returns immediately
+    recordSequence++;
+
+    return YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void telemetry_buildRecord(uint8_t recordIndex)
+{
+    switch (recordIndex)
+    {
+        case TELEMETRY_SET_POWER:
+            telemetry_beginRecord(TELEMETRY_RECORD_POWER, TELEMETRY_VERSION_POWER);
+            telemetry_append_uint16(adc_getLatestBatteryCurrent_deciAmps());
+            telemetry_append_uint16(adc_getLatestSpoofedCurrent_deciAmps());
+            telemetry_append_uint8(LTC68042result_packVoltage_get());
+            telemetry_append_uint8(vPackSpoof_getSpoofedPackVoltage());
+            telemetry_append_uint16(LTC68042result_hiCellVoltage_get());
+            telemetry_append_uint16(LTC68042result_loCellVoltage_get());
+            telemetry_append_uint8(temperature_battery_getLatest());
+            break;
+
+        case TELEMETRY_SET_SoC:
+            telemetry_beginRecord(TELEMETRY_RECORD_SoC, TELEMETRY_VERSION_SoC);
+            telemetry_append_uint8(SoC_getBatteryStateNow_percent());
+            telemetry_append_uint8(SoC_source_get());
+            telemetry_append_uint16(SoC_getBatteryStateNow_mAh());
+            telemetry_append_uint16(SoC_getStackFullCapacity_mAh());
+            telemetry_append_uint8(SoC_EKF_uncertainty_percent_get());
+            telemetry_append_uint16(SoC_EKF_latestInnovation_counts_get());
+            break;
+
+        case TELEMETRY_SET_SCI:
+        {
+            uint8_t packetE6, packetB3, packetB4, packetE1;
+            METSCI_getLatestPackets(&packetE6, &packetB3, &packetB4, &packetE1);
+
+            telemetry_beginRecord(TELEMETRY_RECORD_SCI, TELEMETRY_VERSION_SCI);
+            telemetry_append_uint8(packetE6);
+            telemetry_append_uint8(packetB3);
+            telemetry_append_uint8(packetB4);
+            telemetry_append_uint8(packetE1);
+            telemetry_append_uint8(BATTSCI_framePeriod_ms_get());
+            telemetry_append_uint16(METSCI_parseLatency_us_get());
+            telemetry_append_uint16(METSCI_parseLatencyMax_us_get());
+            break;
+        }
+
+        case TELEMETRY_SET_TEMPS:
+            telemetry_beginRecord(TELEMETRY_RECORD_TEMPS, TELEMETRY_VERSION_TEMPS);
+            telemetry_append_uint8(temperature_battery_getLatest());
+            telemetry_append_uint8(temperature_intake_getLatest());
+            telemetry_append_uint8(temperature_exhaust_getLatest());
+            telemetry_append_uint8(temperature_gridCharger_getLatest());
+            telemetry_append_uint8(temperature_ambient_getLatest());
+            break;
+
+        case TELEMETRY_SET_FAULTS:
+            telemetry_beginRecord(TELEMETRY_RECORD_FAULTS, TELEMETRY_VERSION_FAULTS);
+            telemetry_append_uint8(LTC68042result_errorCount_get());
+            telemetry_append_uint16(busStats_get(BUS_METSCI, BUS_STAT_CHECKSUM_ERRORS));
+            telemetry_append_uint16(busStats_get(BUS_METSCI, BUS_STAT_FRAMING_ERRORS));
+            telemetry_append_uint16(busStats_get(BUS_METSCI, BUS_STAT_PARITY_ERRORS));
+            telemetry_append_uint16(busStats_get(BUS_BATTSCI, BUS_STAT_OVERRUN_ERRORS));
+            telemetry_append_uint8(key_getSampledState());
+            telemetry_append_uint8(eeprom_expirationStatus_get());
+            break;
+
+        default: //cell voltages
+        {
+            uint8_t icToSend = recordIndex - TELEMETRY_SET_CELLS;
+            telemetry_beginRecord(TELEMETRY_RECORD_CELLS, TELEMETRY_VERSION_CELLS);
+            telemetry_append_uint8(icToSend);
+            for (uint8_t cell = 0; cell < CELLS_PER_IC; cell++) { telemetry_append_uint16(LTC68042result_specificCellVoltage_get(icToSend, cell)); }
+            break;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//call each time the next sample set should be sent //any unsent records from the previous set are discarded
+void telemetry_startNewSampleSet(void) { nextRecordToSend = 0; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//sends as many records as fit in the USB transmit buffer
+void telemetry_sendPendingRecords(void)
+{
+    while (nextRecordToSend < TELEMETRY_SET_DONE)
+    {
+        telemetry_buildRecord(nextRecordToSend);
+
+        if (telemetry_sendRecord() == NO) { break; } //USB transmit buffer full //try again next loop
+
+        nextRecordToSend++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
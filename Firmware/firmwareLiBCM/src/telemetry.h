@@ -0,0 +1,58 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef telemetry_h
+    #define telemetry_h
+
+    /************************************************************************************************************************
+     * Binary telemetry stream ('$DISP=BIN')
+     *
+     * Each record is COBS encoded, then followed by a single 0x00 delimiter byte.
+     * Decoded record:
+     *   Byte0:   record type (see TELEMETRY_RECORD_xxx)
+     *   Byte1:   record version (changes each time that record type's payload changes)
+     *   Byte2:   sequence number (increments each record, so the host can detect dropped records)
+     *   Byte3:6: millis() when record was built
+     *   ...      payload (see each record type below)
+     *   last 2B: CRC-16/MCRF4XX of all preceding bytes (poly 0x1021 reflected, init 0xFFFF, no final XOR)
+     * All multi-byte values are little-endian.  Host should discard records with an incorrect CRC (e.g. text mixed into stream).
+     * Host decoder: Firmware/tools/telemetryDecoder.py (update it whenever a record's payload changes).
+     ************************************************************************************************************************/
+
+    #define TELEMETRY_HEADER_BYTES 7
+    #define TELEMETRY_CRC_BYTES    2
+    #define TELEMETRY_MAX_PAYLOAD_BYTES (1 + (CELLS_PER_IC * 2)) //largest record is cell voltages
+    #define TELEMETRY_MAX_RECORD_BYTES  (TELEMETRY_HEADER_BYTES + TELEMETRY_MAX_PAYLOAD_BYTES + TELEMETRY_CRC_BYTES)
+
+    //payload: int16 battery current (deciAmps), int16 spoofed current (deciAmps), uint8 pack voltage (V), uint8 spoofed pack voltage (V),
+    //         uint16 hi cell (100 uV counts), uint16 lo cell (100 uV counts), int8 battery temp (degC)
+    #define TELEMETRY_RECORD_POWER   0x01
+    #define TELEMETRY_VERSION_POWER  0x01
+
+    //payload: uint8 IC number, then CELLS_PER_IC * uint16 cell voltage (100 uV counts)
+    #define TELEMETRY_RECORD_CELLS   0x02
+    #define TELEMETRY_VERSION_CELLS  0x01
+
+    //payload: int8 battery, intake, exhaust, grid charger, ambient temperature (degC) //ambient is OEM WHT sensor (5AhG3) or YEL sensor (FoMoCo)
+    #define TELEMETRY_RECORD_TEMPS   0x03
+    #define TELEMETRY_VERSION_TEMPS  0x01
+
+    //payload: uint8 METSCI E6, B3, B4, E1 data, uint8 BATTSCI frame period (ms), uint16 METSCI latency (us), uint16 METSCI max latency (us)
+    #define TELEMETRY_RECORD_SCI     0x04
+    #define TELEMETRY_VERSION_SCI    0x01
+
+    //payload: uint8 SoC (%), uint8 SoC source (see SoC.h), uint16 charge (mAh), uint16 capacity (mAh),
+    //         uint8 EKF uncertainty (%), int16 EKF innovation (100 uV counts)
+    #define TELEMETRY_RECORD_SoC     0x05
+    #define TELEMETRY_VERSION_SoC    0x01
+
+    //payload: uint8 isoSPI error count, uint16 METSCI checksum errors, uint16 METSCI framing errors, uint16 METSCI parity errors,
+    //         uint16 BATTSCI overruns, uint8 key state, uint8 firmware status
+    #define TELEMETRY_RECORD_FAULTS  0x06
+    #define TELEMETRY_VERSION_FAULTS 0x01
+
+    void telemetry_startNewSampleSet(void);
+
+    void telemetry_sendPendingRecords(void);
+
+#endif
@@ -64,7 +64,7 @@ void temperature_measureBattery(void)
             (batteryTemps[ii] == TEMPERATURE_SENSOR_FAULT_LO)  )
         {
             Serial.print(F("\nCheck Batt Temp Sensor! Bay: "));
-            Serial.print(String(ii,DEC));
+            Serial.print(ii,DEC);
         }
         else
         {
@@ -143,11 +143,11 @@ int8_t temperature_coolBatteryAbove_C(void)
 {
     int8_t coolBattAboveTemp_C = ROOM_TEMP_DEGC;
 
-    if      (key_getSampledState() == KEYSTATE_ON)            { coolBattAboveTemp_C = COOL_BATTERY_ABOVE_TEMP_C_KEYON;        }
-    else if (gpio_isGridChargerPluggedInNow() == YES)         { coolBattAboveTemp_C = COOL_BATTERY_ABOVE_TEMP_C_GRIDCHARGING; }
-    else if ( (SoC_getBatteryStateNow_percent() > KEYOFF_DISABLE_THERMAL_MANAGEMENT_BELOW_SoC) &&
-              (key_getSampledState() == KEYSTATE_OFF) )       { coolBattAboveTemp_C = COOL_BATTERY_ABOVE_TEMP_C_KEYOFF;       }
-    else /*KEYOFF && SoC too low*/                            { coolBattAboveTemp_C = TEMPERATURE_SENSOR_FAULT_HI;            } //don't request fan if SoC low
+    if      (key_getSampledState() == KEYSTATE_ON)                                     { coolBattAboveTemp_C = params_get(PARAM_COOL_ABOVE_TEMP_C_KEYON);  }
+    else if (gpio_isGridChargerPluggedInNow() == YES)                                  { coolBattAboveTemp_C = params_get(PARAM_COOL_ABOVE_TEMP_C_GRID);   }
+    else if ( (SoC_getBatteryStateNow_percent() > params_get(PARAM_KEYOFF_THERMAL_MIN_SoC)) &&
+              (key_getSampledState() == KEYSTATE_OFF) )                                { coolBattAboveTemp_C = params_get(PARAM_COOL_ABOVE_TEMP_C_KEYOFF); }
+    else /*KEYOFF && SoC too low*/                                                     { coolBattAboveTemp_C = TEMPERATURE_SENSOR_FAULT_HI;                } //don't request fan if SoC low
 
     if      (fan_getSpeed_now() == FAN_HIGH) { coolBattAboveTemp_C -= FAN_SPEED_HYSTERESIS_HIGH_degC; }
     else if (fan_getSpeed_now() == FAN_LOW ) { coolBattAboveTemp_C -= FAN_SPEED_HYSTERESIS_LOW_degC;  }
@@ -162,11 +162,11 @@ int8_t temperature_heatBatteryBelow_C(void)
 {
     int8_t heatBattBelowTemp_C = ROOM_TEMP_DEGC;
 
-    if      (key_getSampledState() == KEYSTATE_ON)           { heatBattBelowTemp_C = HEAT_BATTERY_BELOW_TEMP_C_KEYON;        }
-    else if (gpio_isGridChargerPluggedInNow() == YES)        { heatBattBelowTemp_C = HEAT_BATTERY_BELOW_TEMP_C_GRIDCHARGING; }
-    else if ( (SoC_getBatteryStateNow_percent() > KEYOFF_DISABLE_THERMAL_MANAGEMENT_BELOW_SoC) &&
-             (key_getSampledState() == KEYSTATE_OFF) )       { heatBattBelowTemp_C = HEAT_BATTERY_BELOW_TEMP_C_KEYOFF;       }
-    else /*KEYOFF && SoC too low*/                           { heatBattBelowTemp_C = TEMPERATURE_SENSOR_FAULT_LO;            } //don't request fan if SoC low
+    if      (key_getSampledState() == KEYSTATE_ON)                                    { heatBattBelowTemp_C = params_get(PARAM_HEAT_BELOW_TEMP_C_KEYON);  }
+    else if (gpio_isGridChargerPluggedInNow() == YES)                                 { heatBattBelowTemp_C = params_get(PARAM_HEAT_BELOW_TEMP_C_GRID);   }
+    else if ( (SoC_getBatteryStateNow_percent() > params_get(PARAM_KEYOFF_THERMAL_MIN_SoC)) &&
+             (key_getSampledState() == KEYSTATE_OFF) )                                { heatBattBelowTemp_C = params_get(PARAM_HEAT_BELOW_TEMP_C_KEYOFF); }
+    else /*KEYOFF && SoC too low*/                                                    { heatBattBelowTemp_C = TEMPERATURE_SENSOR_FAULT_LO;                } //don't request fan if SoC low
 
     if      (fan_getSpeed_now() == FAN_HIGH) { heatBattBelowTemp_C += FAN_SPEED_HYSTERESIS_HIGH_degC; }
     else if (fan_getSpeed_now() == FAN_LOW ) { heatBattBelowTemp_C += FAN_SPEED_HYSTERESIS_LOW_degC;  }
@@ -240,7 +240,7 @@ void temperature_handler(void)
     {
         //sensors only turn off when key is off and grid charger is unplugged
         Serial.print(F("\nTemp(C): ")); //print temp when key is off
-        Serial.print(String(tempBattery));
+        Serial.print((int16_t)tempBattery);
         gpio_turnTemperatureSensors_off(); 
         tempSensorState = TEMPSENSORSTATE_OFF;
     }
@@ -263,7 +263,7 @@ void temperature_handler(void)
 //JTS2doLater: Need to differentiate between TEMPERATURE_SENSOR_FAULT_LO and actually being below -30 degC
 int8_t temperature_measureOneSensor_degC(uint8_t thermistorPin)
 {           
-    uint16_t countsADC = analogRead(thermistorPin); //measure ADC counts
+    uint16_t countsADC = adc_getTemperature(thermistorPin); //latest ADC counts (measured in background)
 
     //This commented out section is quite math intensive:
     // -QTY3 floating point divisions
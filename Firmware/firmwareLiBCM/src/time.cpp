@@ -54,9 +54,12 @@ void updateKeyOffTaskFlag(void)
     static uint32_t timestamp_lastUpdate_ms = 0;
     uint32_t keyOffUpdatePeriod_ms = KEY_OFF_UPDATE_PERIOD_TEN_MINUTES_ms;
 
-    if ( ((cellBalance_areCellsBalancing() == YES) && (SoC_getBatteryStateNow_percent() > CELL_BALANCE_MIN_SoC)) ||
-         ((cellBalance_areCellsBalancing() == YES) && (gpio_isGridChargerPluggedInNow() == YES)                ) ||
-         ((gpio_isGridChargerChargingNow() == YES)                                                             )  )
+    //anchor rest must end on time, otherwise each hourly re-anchor would pause balancing for up to ten minutes
+    bool isBalancing = ((cellBalance_areCellsBalancing() == YES) || (cellBalance_isBalancingPending() == YES));
+
+    if ( ((isBalancing == YES) && (SoC_getBatteryStateNow_percent() > params_get(PARAM_CELL_BALANCE_MIN_SoC))) ||
+         ((isBalancing == YES) && (gpio_isGridChargerPluggedInNow() == YES)                                 ) ||
+         ((gpio_isGridChargerChargingNow() == YES)                                                                              )  )
     { 
         keyOffUpdatePeriod_ms = KEY_OFF_UPDATE_PERIOD_ONE_SECOND_ms; //if over 1800 ms, LTC ICs will turn off (bad)
     } 
@@ -76,7 +79,7 @@ bool time_hasKeyBeenOffLongEnough_toTurnOffLiBCM(void)
 {
     bool keyOffForLongEnough = false;
 
-    if ((millis() - time_latestKeyOff_ms_get()) > (KEYOFF_DELAY_LIBCM_TURNOFF_MINUTES * 60000))
+    if ((millis() - time_latestKeyOff_ms_get()) > ((uint32_t)params_get(PARAM_KEYOFF_TURNOFF_DELAY_MINUTES) * 60000))
     {
         keyOffForLongEnough = true;
     }
@@ -94,6 +97,8 @@ void time_waitForLoopPeriod(void)
 
     uint32_t timeNow_ms = millis();
 
+    resetLog_loopTime(timeNow_ms - timestamp_loopStart_previous_ms); //time spent executing this loop
+
     bool timingMet = false;
 
     LiBCM_justBooted = NO;
@@ -103,14 +108,20 @@ void time_waitForLoopPeriod(void)
     while ((uint32_t)(timeNow_ms - timestamp_loopStart_previous_ms) < time_loopPeriod_ms_get())
     {
         //wait here to start next loop
+        twi_handler(); //start transactions whose holdoff expired, rather than waiting for lcdState_handler() next loop
         timeNow_ms = millis();
         timingMet = true;
     }
     LED(4,LOW);
 
+    if ((key_getSampledState() == KEYSTATE_ON) && (timingMet == false))
+    {
+        uint32_t overrun_ms = timeNow_ms - timestamp_loopStart_previous_ms - time_loopPeriod_ms_get();
+        eventLog_log(EVENT_LOOP_OVERRUN, (overrun_ms > 0xFFFF) ? 0xFFFF : (uint16_t)overrun_ms);
+        flightRecorder_handleLoopOverrun(overrun_ms + time_loopPeriod_ms_get());
+    }
+
     timestamp_loopStart_previous_ms = timeNow_ms;
-        
-    if ((key_getSampledState() == KEYSTATE_ON) && (timingMet == false)) { Serial.print('*'); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,324 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+//interrupt driven TWI (I2C) master transmitter //replaces Arduino's Wire library (which waits for each transmission to finish)
+//transactions are queued, then the TWI ISR sends them in the background
+//a transaction can request a holdoff (e.g. HD44780U clear display takes 1.52 ms)...
+//in which case the next transaction is started by twi_handler() once the holdoff expires
+//twi_handler() is called while the superloop waits for its next period (see time_waitForLoopPeriod()), so holdoffs don't stretch to a full loop
+
+#include "libcm.h"
+
+//TWSR status codes (master transmitter mode)
+#define TWI_SR_START            0x08
+#define TWI_SR_REPEATED_START   0x10
+#define TWI_SR_SLA_W_ACK        0x18
+#define TWI_SR_SLA_W_NACK       0x20
+#define TWI_SR_DATA_ACK         0x28
+#define TWI_SR_DATA_NACK        0x30
+#define TWI_SR_ARBITRATION_LOST 0x38
+#define TWI_SR_MASK             0xF8
+
+#define TWI_TWCR_SEND_NEXT       ((1 << TWEN) | (1 << TWIE) | (1 << TWINT))
+#define TWI_TWCR_SEND_START      ((1 << TWEN) | (1 << TWIE) | (1 << TWINT) | (1 << TWSTA))
+#define TWI_TWCR_SEND_STOP       ((1 << TWEN) |               (1 << TWINT) | (1 << TWSTO))
+#define TWI_TWCR_SEND_STOP_START ((1 << TWEN) | (1 << TWIE) | (1 << TWINT) | (1 << TWSTO) | (1 << TWSTA))
+
+struct twiTransaction
+{
+    uint8_t address;
+    uint8_t firstByte; //index into twi_buffer[]
+    uint8_t length;
+    uint16_t holdoff_us;
+    twi_callback_t callback;
+};
+
+twiTransaction twi_queue[TWI_QUEUE_TRANSACTIONS];
+volatile uint8_t twi_queue_head = 0; //next transaction written here
+volatile uint8_t twi_queue_tail = 0; //oldest transaction (currently sending, or next to send)
+
+uint8_t twi_buffer[TWI_BUFFER_SIZE];
+volatile uint8_t twi_buffer_head = 0; //next byte written here
+volatile uint8_t twi_buffer_tail = 0; //first byte of oldest transaction
+
+//transaction being written (see twi_transaction_begin())
+uint8_t twi_newTransaction_address = 0;
+uint8_t twi_newTransaction_length = 0;
+
+//these variables are modified inside the TWI ISR
+volatile bool     twi_isBusy = NO; //transaction in progress
+volatile uint8_t  twi_bytesSent = 0;
+volatile uint32_t twi_transactionStart_ms = 0;
+volatile uint32_t twi_holdoffStart_us = 0;
+volatile uint16_t twi_holdoff_us = 0;
+volatile uint16_t twi_transactionCount = 0;
+volatile uint16_t twi_errorCount = 0;
+
+bool     twi_isEnabled = NO;
+uint32_t twi_blockedTime_us = 0;
+uint16_t twi_blockedTimeMax_us = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t twi_transactionCount_get(void) { noInterrupts(); uint16_t count = twi_transactionCount; interrupts(); return count; }
+uint16_t twi_errorCount_get(void)       { noInterrupts(); uint16_t count = twi_errorCount;       interrupts(); return count; }
+
+uint32_t twi_blockedTime_us_get(void)    { return twi_blockedTime_us;    }
+uint16_t twi_blockedTimeMax_us_get(void) { return twi_blockedTimeMax_us; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST be called with interrupts disabled
+void twi_startTransaction(uint8_t twcrValue)
+{
+    twi_isBusy = YES;
+    twi_bytesSent = 0;
+    twi_transactionStart_ms = millis();
+    TWCR = twcrValue;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST be called with interrupts disabled
+bool twi_isNextTransactionReady(void)
+{
+    if (twi_isBusy == YES)                   { return NO; }
+    if (twi_queue_tail == twi_queue_head)    { return NO; } //nothing to send
+    if (twi_holdoff_us == 0)                 { return YES; }
+    return ((micros() - twi_holdoffStart_us) >= twi_holdoff_us);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//MUST be called with interrupts disabled
+//sends STOP condition, then starts next transaction (if it's ready)
+void twi_finishTransaction(uint8_t status)
+{
+    twiTransaction *transaction = &twi_queue[twi_queue_tail];
+
+    if (status == TWI_STATUS_OK) { if (twi_transactionCount < 0xFFFF) { twi_transactionCount++; } }
+    else                         { if (twi_errorCount       < 0xFFFF) { twi_errorCount++;       } }
+
+    twi_buffer_tail = (transaction->firstByte + transaction->length) & (TWI_BUFFER_SIZE - 1);
+    twi_holdoff_us = transaction->holdoff_us;
+    twi_holdoffStart_us = micros();
+    twi_callback_t callback = transaction->callback;
+
+    twi_queue_tail = (twi_queue_tail + 1) & (TWI_QUEUE_TRANSACTIONS - 1);
+    twi_isBusy = NO;
+
+    if (callback != NULL) { callback(status); }
+
+    if (twi_isNextTransactionReady() == YES) { twi_startTransaction(TWI_TWCR_SEND_STOP_START); } //TWI sends STOP, then START
+    else                                     { TWCR = TWI_TWCR_SEND_STOP;                      }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+ISR(TWI_vect)
+{
+    twiTransaction *transaction = &twi_queue[twi_queue_tail];
+
+    switch (TWSR & TWI_SR_MASK)
+    {
+        case TWI_SR_START:
+        case TWI_SR_REPEATED_START:
+            TWDR = (transaction->address << 1); //write
+            TWCR = TWI_TWCR_SEND_NEXT;
+            break;
+
+        case TWI_SR_SLA_W_ACK:
+        case TWI_SR_DATA_ACK:
+            if (twi_bytesSent < transaction->length)
+            {
+                TWDR = twi_buffer[(transaction->firstByte + twi_bytesSent) & (TWI_BUFFER_SIZE - 1)];
+                twi_bytesSent++;
+                TWCR = TWI_TWCR_SEND_NEXT;
+            }
+            else { twi_finishTransaction(TWI_STATUS_OK); }
+            break;
+
+        case TWI_SR_SLA_W_NACK:
+        case TWI_SR_DATA_NACK:
+            twi_finishTransaction(TWI_STATUS_NACK);
+            break;
+
+        case TWI_SR_ARBITRATION_LOST:
+        default: //bus error
+            twi_finishTransaction(TWI_STATUS_BUS_ERROR);
+            break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//start next transaction (if TWI ISR couldn't because of holdoff)
+void twi_startIfReady(void)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if (twi_isNextTransactionReady() == YES)
+    {
+        while (TWCR & (1 << TWSTO)) { ; } //previous STOP condition still sending (~5 us)
+        twi_startTransaction(TWI_TWCR_SEND_START);
+    }
+
+    SREG = oldSREG;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void twi_handler(void)
+{
+    if (twi_isEnabled == NO) { return; }
+
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if ((twi_isBusy == YES) && ((millis() - twi_transactionStart_ms) > TWI_TIMEOUT_ms))
+    {
+        //slave is holding SCL low, or ISR missed an event
+        TWCR = 0; //release bus
+        TWCR = (1 << TWEN);
+        twi_finishTransaction(TWI_STATUS_TIMEOUT);
+    }
+
+    SREG = oldSREG;
+
+    twi_startIfReady();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool twi_isSpaceAvailable(uint8_t numBytes)
+{
+    uint8_t bytesUsed = (twi_buffer_head - twi_buffer_tail) & (TWI_BUFFER_SIZE - 1);
+    uint8_t nextQueueHead = (twi_queue_head + 1) & (TWI_QUEUE_TRANSACTIONS - 1);
+
+    return ( ((TWI_BUFFER_SIZE - 1 - bytesUsed) >= numBytes) && (nextQueueHead != twi_queue_tail) );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool twi_isIdle(void)
+{
+    noInterrupts();
+    bool isIdle = ((twi_isBusy == NO) && (twi_queue_tail == twi_queue_head));
+    interrupts();
+
+    return isIdle;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void twi_logBlockedTime(uint32_t waitStart_us)
+{
+    uint32_t blockedTime_us = micros() - waitStart_us;
+
+    twi_blockedTime_us += blockedTime_us;
+    if (blockedTime_us > 0xFFFF)                { blockedTime_us = 0xFFFF;                }
+    if (blockedTime_us > twi_blockedTimeMax_us) { twi_blockedTimeMax_us = blockedTime_us; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void twi_waitUntilIdle(void)
+{
+    if (twi_isEnabled == NO) { return; }
+
+    uint32_t waitStart_us = micros();
+    while (twi_isIdle() == NO) { twi_handler(); }
+    twi_logBlockedTime(waitStart_us);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//waits until 'maxBytes' are available //MUST NOT be called with interrupts disabled
+void twi_transaction_begin(uint8_t address, uint8_t maxBytes)
+{
+    if (twi_isSpaceAvailable(maxBytes) == NO)
+    {
+        uint32_t waitStart_us = micros();
+        while (twi_isSpaceAvailable(maxBytes) == NO) { twi_handler(); } //handler times out stuck transactions, so this always finishes
+        twi_logBlockedTime(waitStart_us);
+    }
+
+    twi_newTransaction_address = address;
+    twi_newTransaction_length = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//caller MUST NOT write more than 'maxBytes' (see twi_transaction_begin())
+void twi_transaction_write(uint8_t data)
+{
+    twi_buffer[(twi_buffer_head + twi_newTransaction_length) & (TWI_BUFFER_SIZE - 1)] = data;
+    twi_newTransaction_length++;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void twi_transaction_end(uint16_t holdoff_us, twi_callback_t callback)
+{
+    if (twi_isEnabled == NO) { return; } //discard transaction
+
+    twiTransaction *transaction = &twi_queue[twi_queue_head];
+
+    transaction->address = twi_newTransaction_address;
+    transaction->firstByte = twi_buffer_head;
+    transaction->length = twi_newTransaction_length;
+    transaction->holdoff_us = holdoff_us;
+    transaction->callback = callback;
+
+    uint8_t oldSREG = SREG;
+    noInterrupts(); //also prevents compiler from moving the above writes after the following lines
+    twi_buffer_head = (twi_buffer_head + twi_newTransaction_length) & (TWI_BUFFER_SIZE - 1);
+    twi_queue_head = (twi_queue_head + 1) & (TWI_QUEUE_TRANSACTIONS - 1);
+    SREG = oldSREG;
+
+    twi_startIfReady();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void twi_begin(uint32_t sclFrequency_Hz)
+{
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    {
+        TWCR = 0;
+        twi_queue_head = 0;
+        twi_queue_tail = 0;
+        twi_buffer_head = 0;
+        twi_buffer_tail = 0;
+        twi_isBusy = NO;
+        twi_holdoff_us = 0;
+
+        //internal pullups (same as Wire library)
+        digitalWrite(DEBUG_SDA, HIGH);
+        digitalWrite(DEBUG_CLK, HIGH);
+
+        TWSR = 0; //prescaler = 1
+        TWBR = ((F_CPU / sclFrequency_Hz) - 16) / 2;
+        TWCR = (1 << TWEN);
+    }
+    SREG = oldSREG;
+
+    twi_isEnabled = YES;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+void twi_end(void)
+{
+    twi_waitUntilIdle();
+
+    TWCR = 0;
+    digitalWrite(DEBUG_SDA, LOW);
+    digitalWrite(DEBUG_CLK, LOW);
+
+    twi_isEnabled = NO;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,43 @@
+//Copyright 2021-2023(c) John Sullivan
+//github.com/doppelhub/Honda_Insight_LiBCM
+
+#ifndef twi_h
+    #define twi_h
+
+    #define TWI_SCL_STANDARD_MODE_Hz 100000
+    #define TWI_SCL_FAST_MODE_Hz     400000
+
+    #define TWI_QUEUE_TRANSACTIONS   16 //must be a power of 2
+    #define TWI_BUFFER_SIZE         128 //must be a power of 2 //bytes waiting to be sent (all queued transactions)
+    #define TWI_TIMEOUT_ms            5 //longest transaction (32 bytes at 100 kHz) takes ~3 ms
+
+    #define TWI_STATUS_OK             0
+    #define TWI_STATUS_NACK           1 //address or data byte not acknowledged (e.g. display unplugged)
+    #define TWI_STATUS_BUS_ERROR      2 //arbitration lost or illegal START/STOP
+    #define TWI_STATUS_TIMEOUT        3 //transaction didn't finish within TWI_TIMEOUT_ms
+
+    typedef void (*twi_callback_t)(uint8_t status); //called from TWI ISR when each transaction finishes
+
+    void twi_begin(uint32_t sclFrequency_Hz);
+    void twi_end(void); //waits for queued transactions to finish
+
+    void twi_handler(void); //starts transactions after their holdoff expires //recovers from stuck bus
+
+    //transactions are written in three steps:
+    //twi_transaction_begin() waits (if necessary) until 'maxBytes' are available in the queue
+    //twi_transaction_write() adds one byte (up to 'maxBytes')
+    //twi_transaction_end() queues the transaction //the next transaction won't start until 'holdoff_us' after this one finishes
+    void twi_transaction_begin(uint8_t address, uint8_t maxBytes);
+    void twi_transaction_write(uint8_t data);
+    void twi_transaction_end(uint16_t holdoff_us, twi_callback_t callback);
+
+    bool twi_isSpaceAvailable(uint8_t numBytes); //returns YES if twi_transaction_begin() won't wait
+    bool twi_isIdle(void);
+    void twi_waitUntilIdle(void);
+
+    uint16_t twi_transactionCount_get(void);
+    uint16_t twi_errorCount_get(void);
+    uint32_t twi_blockedTime_us_get(void);    //total time spent waiting on TWI since boot
+    uint16_t twi_blockedTimeMax_us_get(void); //longest single wait
+
+#endif
@@ -112,7 +112,11 @@ void spoofVoltage_calculateValue(void)
 {
     uint8_t maxPossibleVspoof = calculate_Vspoof_maxPossible();
 
-    #if defined VOLTAGE_SPOOFING_DISABLE
+    //mode is a runtime parameter (see params.cpp) //60S only allows VSPOOF_MODE_DISABLE
+    switch (params_get(PARAM_VSPOOF_MODE))
+    {
+    case VSPOOF_MODE_DISABLE:
+    default:
         //For those that don't want variable voltage spoofing, spoof maximum possible pack voltage
         
         #ifdef STACK_IS_48S
@@ -121,31 +125,27 @@ void spoofVoltage_calculateValue(void)
 
         #elif defined STACK_IS_60S
             spoofedPackVoltage = LTC68042result_packVoltage_get() * 0.67; //Vspoof(60S)=136 @ Vcell=3.4 //Vspoof(60S)=169 @ Vcell=4.2
-            if (spoofedPackVoltage < MIN_SPOOFED_VOLTAGE_60S) { spoofedPackVoltage = MIN_SPOOFED_VOLTAGE_60S; } //prevent P1440 during heavy assist (due to MCM increasing current as voltage drops) //JTS2doLater: Automate this process (e.g. limit output power to 23 kW) 
+            if (spoofedPackVoltage < params_get(PARAM_MIN_SPOOFED_VOLTAGE_60S)) { spoofedPackVoltage = params_get(PARAM_MIN_SPOOFED_VOLTAGE_60S); } //prevent P1440 during heavy assist (due to MCM increasing current as voltage drops) //JTS2doLater: Automate this process (e.g. limit output power to 23 kW) 
         #endif
+        break;
 
     //JTS2doLater: Add 60S logic to all other modes (below)
 
     //---------------------------------------------------------------------------
 
-    #elif defined VOLTAGE_SPOOFING_ASSIST_ONLY_BINARY
-        #ifdef STACK_IS_60S
-            #error (60S only works with VOLTAGE_SPOOFING_DISABLE selected in config.h)
-        #endif
+    case VSPOOF_MODE_ASSIST_ONLY_BINARY:
         if (adc_getLatestBatteryCurrent_amps() > MAXIMIZE_POWER_ABOVE_CURRENT_AMPS) { spoofedPackVoltage = VSPOOF_TO_MAXIMIZE_POWER; } //more power during heavy assist
         else { spoofedPackVoltage = maxPossibleVspoof; } //no voltage spoofing during regen, idle, or light assist
+        break;
 
     //---------------------------------------------------------------------------
 
     //JTS2doLater: Remove this mode before exiting beta
     //DEPRECATED: This mode is no longer updated and may not work in future firmware versions
     //Based on test data, spoofing pack voltage during regen causes erratic and/or heavy regen behavior.
-    //Recommendation: use VOLTAGE_SPOOFING_ASSIST_ONLY_VARIABLE
+    //Recommendation: use VSPOOF_MODE_ASSIST_ONLY_VARIABLE
 
-    #elif defined VOLTAGE_SPOOFING_ASSIST_AND_REGEN
-        #ifdef STACK_IS_60S
-            #error (60S only works with VOLTAGE_SPOOFING_DISABLE selected in config.h)
-        #endif
+    case VSPOOF_MODE_ASSIST_AND_REGEN:
         //Derivation:
         //Maximum assist occurs when MCM thinks pack is at 120 volts.
         //Therefore, we want to adjust the pack voltage over that range:
@@ -186,13 +186,11 @@ void spoofVoltage_calculateValue(void)
 
         spoofedPackVoltage = (uint8_t)((uint16_t)(LTC68042result_packVoltage_get() * ( 167 - adc_getLatestBatteryCurrent_amps() )
                                 + 135 * adc_getLatestBatteryCurrent_amps() + 8000) >> 8);
+        break;
 
     //---------------------------------------------------------------------------
 
-    #elif defined   VOLTAGE_SPOOFING_ASSIST_ONLY_VARIABLE
-        #ifdef STACK_IS_60S
-            #error (60S only works with VOLTAGE_SPOOFING_DISABLE selected in config.h)
-        #endif
+    case VSPOOF_MODE_ASSIST_ONLY_VARIABLE:
         
         if     ((maxPossibleVspoof < VSPOOF_TO_MAXIMIZE_POWER)                           || //pack voltage too low     
                 (adc_getLatestBatteryCurrent_amps() < BEGIN_SPOOFING_VOLTAGE_ABOVE_AMPS)  ) { spoofedPackVoltage = maxPossibleVspoof; } //regen, idle, or light assist
@@ -221,10 +219,11 @@ void spoofVoltage_calculateValue(void)
             //Calculate spoofed pack voltage
             spoofedPackVoltage = maxPossibleVspoof - packVoltageReduction_V;
         }
+        break;
 
     //---------------------------------------------------------------------------
 
-    #elif defined  VOLTAGE_SPOOFING_LINEAR
+    case VSPOOF_MODE_LINEAR:
 	
 	           spoofedPackVoltage = maxPossibleVspoof * 0.4 + 78; 
 	
@@ -233,12 +232,8 @@ void spoofVoltage_calculateValue(void)
 		   // 60S yields from +28% power
 		   // max spoofing is within 67% of Vpack
 		   // this is compatible with standard 100A OEM fuse.
-
-    //---------------------------------------------------------------------------
-	
-    #else
-        #error (VOLTAGE_SPOOFING value not selected in config.h)
-    #endif
+        break;
+    }
 
     //---------------------------------------------------------------------------
 
@@ -4,6 +4,36 @@
 #ifndef vpackspoof_h
     #define vpackspoof_h
 
+    //voltage spoofing mode is a runtime parameter (PARAM_VSPOOF_MODE) //config.h selects the default
+    #define VSPOOF_MODE_DISABLE              0
+    #define VSPOOF_MODE_ASSIST_ONLY_VARIABLE 1
+    #define VSPOOF_MODE_ASSIST_ONLY_BINARY   2
+    #define VSPOOF_MODE_ASSIST_AND_REGEN     3 //DEPRECATED
+    #define VSPOOF_MODE_LINEAR               4
+
+    #if   defined VOLTAGE_SPOOFING_DISABLE
+        #define VSPOOF_MODE_DEFAULT VSPOOF_MODE_DISABLE
+    #elif defined VOLTAGE_SPOOFING_ASSIST_ONLY_VARIABLE
+        #define VSPOOF_MODE_DEFAULT VSPOOF_MODE_ASSIST_ONLY_VARIABLE
+    #elif defined VOLTAGE_SPOOFING_ASSIST_ONLY_BINARY
+        #define VSPOOF_MODE_DEFAULT VSPOOF_MODE_ASSIST_ONLY_BINARY
+    #elif defined VOLTAGE_SPOOFING_ASSIST_AND_REGEN
+        #define VSPOOF_MODE_DEFAULT VSPOOF_MODE_ASSIST_AND_REGEN
+    #elif defined VOLTAGE_SPOOFING_LINEAR
+        #define VSPOOF_MODE_DEFAULT VSPOOF_MODE_LINEAR
+    #else
+        #error (VOLTAGE_SPOOFING value not selected in config.h)
+    #endif
+
+    #ifdef STACK_IS_60S
+        #define VSPOOF_MODE_MAX_ALLOWED VSPOOF_MODE_DISABLE //60S only works with VOLTAGE_SPOOFING_DISABLE
+        #if (VSPOOF_MODE_DEFAULT != VSPOOF_MODE_DISABLE)
+            #error (60S only works with VOLTAGE_SPOOFING_DISABLE selected in config.h)
+        #endif
+    #else
+        #define VSPOOF_MODE_MAX_ALLOWED VSPOOF_MODE_LINEAR
+    #endif
+
     #define BEGIN_SPOOFING_VOLTAGE_ABOVE_AMPS 10 //below this many amps assist, spoofed pack voltage is as high as possible
         
     //choose the current range to adjust spoofed pack voltage from 0 to 100% over
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+#Copyright 2021-2023(c) John Sullivan
+#github.com/doppelhub/Honda_Insight_LiBCM
+
+#host decoder for LiBCM's binary telemetry stream ('$DISP=BIN')
+#record format is documented in Firmware/firmwareLiBCM/src/telemetry.h
+#each record is split on the 0x00 delimiter, COBS decoded, then CRC checked
+#text mixed into the stream (e.g. event log messages) has no delimiter, so it's prepended to the next record
+#when that happens the record is recovered by retrying after each newline in the frame
+#
+#usage:
+#  python3 telemetryDecoder.py /dev/ttyACM0            (live, requires pyserial) //sends '$DISP=BIN' first
+#  python3 telemetryDecoder.py capture.bin              (raw bytes previously captured from USB)
+#  python3 telemetryDecoder.py --csv capture.bin > out.csv
+
+import struct
+import sys
+
+RECORD_POWER  = 0x01
+RECORD_CELLS  = 0x02
+RECORD_TEMPS  = 0x03
+RECORD_SCI    = 0x04
+RECORD_SoC    = 0x05
+RECORD_FAULTS = 0x06
+
+HEADER_FORMAT = '<BBBI' #type, version, sequence, millis()
+HEADER_BYTES  = struct.calcsize(HEADER_FORMAT)
+CRC_BYTES     = 2
+
+#(record type, version): (name, struct format, field names) //MUST match telemetry_buildRecord()
+#cell records have a variable number of cells, so they're decoded separately
+RECORD_FORMATS = {
+    (RECORD_POWER,  0x01): ('POWER',  '<hhBBHHb', ('current_dA', 'spoofedCurrent_dA', 'packVoltage', 'spoofedVoltage',
+                                                    'hiCell_counts', 'loCell_counts', 'batteryTemp_C')),
+    (RECORD_TEMPS,  0x01): ('TEMPS',  '<bbbbb',   ('battery_C', 'intake_C', 'exhaust_C', 'gridCharger_C', 'ambient_C')),
+    (RECORD_SCI,    0x01): ('SCI',    '<BBBBBHH', ('METSCI_E6', 'METSCI_B3', 'METSCI_B4', 'METSCI_E1',
+                                                    'BATTSCI_framePeriod_ms', 'METSCI_latency_us', 'METSCI_latencyMax_us')),
+    (RECORD_SoC,    0x01): ('SoC',    '<BBHHBh',  ('SoC_percent', 'SoC_source', 'charge_mAh', 'capacity_mAh',
+                                                    'EKF_uncertainty_percent', 'EKF_innovation_counts')),
+    (RECORD_FAULTS, 0x01): ('FAULTS', '<BHHHHBB', ('isoSPI_errors', 'METSCI_checksumErrors', 'METSCI_framingErrors',
+                                                    'METSCI_parityErrors', 'BATTSCI_overruns', 'keyState', 'firmwareStatus')),
+}
+
+#########################################################################################
+
+#same algorithm as avr-libc _crc_ccitt_update() (CRC-16/MCRF4XX)
+def crc_ccitt_update(crc, data):
+    data ^= crc & 0xFF
+    data ^= (data << 4) & 0xFF
+    return (((data << 8) | (crc >> 8)) ^ (data >> 4) ^ (data << 3)) & 0xFFFF
+
+def crc_ccitt(data):
+    crc = 0xFFFF
+    for byte in data: crc = crc_ccitt_update(crc, byte)
+    return crc
+
+#########################################################################################
+
+#returns None if 'encoded' isn't valid COBS
+def decode_cobs(encoded):
+    decoded = bytearray()
+    index = 0
+
+    while index < len(encoded):
+        code = encoded[index]
+        if code == 0 or (index + code) > len(encoded): return None
+
+        decoded += encoded[index + 1 : index + code]
+        index += code
+
+        if code < 0xFF and index < len(encoded): decoded.append(0) #block ended with a zero (except final block)
+
+    return bytes(decoded)
+
+#########################################################################################
+
+#returns dict, or None if record is corrupted
+def parse_record(record):
+    if len(record) < (HEADER_BYTES + CRC_BYTES): return None
+
+    (storedCRC,) = struct.unpack('<H', record[-CRC_BYTES:])
+    if crc_ccitt(record[:-CRC_BYTES]) != storedCRC: return None
+
+    recordType, version, sequence, timestamp_ms = struct.unpack(HEADER_FORMAT, record[:HEADER_BYTES])
+    payload = record[HEADER_BYTES:-CRC_BYTES]
+    fields = {'type': recordType, 'version': version, 'sequence': sequence, 'ms': timestamp_ms}
+
+    if (recordType == RECORD_CELLS) and (version == 0x01) and (len(payload) % 2 == 1):
+        fields['name'] = 'CELLS'
+        fields['ic'] = payload[0]
+        fields['cells_counts'] = list(struct.unpack('<%dH' % ((len(payload) - 1) // 2), payload[1:]))
+    elif (recordType, version) in RECORD_FORMATS:
+        name, payloadFormat, fieldNames = RECORD_FORMATS[(recordType, version)]
+        if len(payload) != struct.calcsize(payloadFormat): return None
+        fields['name'] = name
+        fields.update(zip(fieldNames, struct.unpack(payloadFormat, payload)))
+    else:
+        fields['name'] = 'UNKNOWN'
+        fields['payload'] = payload.hex()
+
+    return fields
+
+#########################################################################################
+
+#returns dict, or None if no valid record is found in frame
+def parse_frame(frame):
+    decoded = decode_cobs(frame)
+    fields = parse_record(decoded) if decoded is not None else None
+    if fields is not None: return fields
+
+    #text printed between records ends with a newline
+    newline = frame.find(b'\n')
+    while newline >= 0:
+        decoded = decode_cobs(frame[newline + 1:])
+        fields = parse_record(decoded) if decoded is not None else None
+        if fields is not None: return fields
+        newline = frame.find(b'\n', newline + 1)
+
+    return None
+
+#########################################################################################
+
+class TelemetryDecoder:
+    def __init__(self):
+        self.buffer = bytearray()
+        self.previousSequence = None
+        self.recordsOK = 0
+        self.recordsBad = 0
+        self.recordsMissed = 0 #sequence gaps (e.g. USB buffer full)
+
+    #returns list of decoded records
+    def feed(self, data):
+        self.buffer += data
+        records = []
+
+        while True:
+            delimiter = self.buffer.find(0)
+            if delimiter < 0: break
+
+            frame = bytes(self.buffer[:delimiter])
+            del self.buffer[:delimiter + 1]
+            if len(frame) == 0: continue
+
+            fields = parse_frame(frame)
+
+            if fields is None:
+                self.recordsBad += 1
+                continue
+
+            if self.previousSequence is not None:
+                self.recordsMissed += (fields['sequence'] - self.previousSequence - 1) & 0xFF
+            self.previousSequence = fields['sequence']
+
+            self.recordsOK += 1
+            records.append(fields)
+
+        return records
+
+#########################################################################################
+
+def format_record(fields, isCSV):
+    values = [(key, value) for key, value in fields.items() if key not in ('type', 'version', 'name')]
+
+    if isCSV:
+        flat = []
+        for key, value in values:
+            if isinstance(value, list): flat += [str(item) for item in value]
+            else:                       flat.append(str(value))
+        return ','.join([fields['name']] + flat)
+
+    return fields['name'] + ' ' + ' '.join('%s=%s' % (key, value) for key, value in values)
+
+#########################################################################################
+
+def open_source(path):
+    if path.startswith('/dev/') or path.upper().startswith('COM'):
+        import serial #pyserial
+        port = serial.Serial(path, 115200, timeout=0.1)
+        port.write(b'$DISP=BIN\n')
+        return port.read, True
+
+    captureFile = open(path, 'rb')
+    return (lambda numBytes: captureFile.read(numBytes)), False
+
+#########################################################################################
+
+def main(arguments):
+    isCSV = '--csv' in arguments
+    arguments = [argument for argument in arguments if argument != '--csv']
+
+    if len(arguments) != 1:
+        sys.stderr.write('usage: telemetryDecoder.py [--csv] <serial port | capture file>\n')
+        return 1
+
+    read, isLive = open_source(arguments[0])
+    decoder = TelemetryDecoder()
+
+    try:
+        while True:
+            data = read(4096)
+            if not data:
+                if isLive: continue
+                break
+            for fields in decoder.feed(data): print(format_record(fields, isCSV))
+    except KeyboardInterrupt:
+        pass
+
+    sys.stderr.write('records OK: %d, bad CRC/COBS: %d, missed (sequence gaps): %d\n'
+                     % (decoder.recordsOK, decoder.recordsBad, decoder.recordsMissed))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))